@@ -0,0 +1,41 @@
+// Macro Guard
+#ifndef SPTS_Agilent34972A_H
+#define SPTS_Agilent34972A_H
+
+// Files included
+#include "Agilent34970A.h"
+#include "SocketSCPI.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   LAN version of the Agilent34970A:  same SCPI command set, multiplexer card and
+    relay channels, talked to over SocketSCPI.  Select it in DMMTraits and give the
+    DMM a "LAN Address" entry in the instrument file.
+*/
+
+struct Agilent34972A : public Agilent34970A {
+    typedef SPTSInstrument::SocketSCPI BusType;
+protected:
+	~Agilent34972A() { /* */ }
+};
+
+
+#endif  // SPTS_Agilent34972A_H
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic 
+        constants are to regular code" 
+                                 - Andrei Alexandrescu 
+//---------------------------------------------------------*/
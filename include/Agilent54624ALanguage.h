@@ -15,6 +15,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+    Added WaveformData(), WaveformScaling() overloads and WaveformSource():
+      BYTE format, 1000 points, scaled from the :WAV:PRE? preamble.
+
   ==============
   06/23/05, sjn,
   ==============
@@ -302,6 +308,41 @@ protected:
     virtual std::string WhatError()
 	    { return("SYST:ERR?"); }
 
+    // Waveform upload overloads
+    virtual std::string WaveformData(OScopeChannels::Channel)
+        { return("WAV:DATA?"); }
+    virtual std::string WaveformScaling(OScopeChannels::Channel)
+        { return("WAV:PRE?"); }
+    virtual WaveformScale WaveformScaling(const std::string& value)
+        {
+            // format,type,points,count,xincrement,xorigin,xreference,
+            //  yincrement,yorigin,yreference
+            std::vector<std::string> pre = SplitString(value, ',');
+            Assert<UnexpectedState>(pre.size() == 10, name());
+            WaveformScale toRtn;
+            toRtn.XIncrement     = convert<double>(pre[4]);
+            toRtn.XOrigin        = convert<double>(pre[5]);
+            toRtn.XReference     = convert<double>(pre[6]);
+            toRtn.YIncrement     = convert<double>(pre[7]);
+            toRtn.YOrigin        = convert<double>(pre[8]);
+            toRtn.YReference     = convert<double>(pre[9]);
+            toRtn.BytesPerSample = 1;
+            toRtn.IsSigned       = false;
+            toRtn.MinCode        = 0;   // BYTE: 0 and 255 are clipped samples
+            toRtn.MaxCode        = 255;
+            return(toRtn);
+        }
+    virtual std::string WaveformSource(OScopeChannels::Channel chan)
+        {
+            return(
+                   "WAV:SOUR CHAN" + convert<std::string>(chan) +
+                    Concatenate()                               +
+                   "WAV:FORM BYTE"                              +
+                    Concatenate()                               +
+                   "WAV:POIN 1000"
+                  );
+        }
+
 public:
 	virtual ~Agilent54624ALanguage() 
         { /* */ }  
@@ -7,6 +7,7 @@
 #include "Instrument.h"
 #include "NoCopy.h"
 #include "ProgramTypes.h"
+#include "ShadowState.h"
 #include "StandardFiles.h"
 #include "Switch.h"
 
@@ -28,6 +29,9 @@ struct AuxSupply : private Instrument<AuxSupplyTraits::ModelType::BusType>,
     //========================
     AuxSupply();
     ~AuxSupply();
+    void AbortTransaction();
+    void BeginTransaction();
+    bool CommitTransaction();
     bool FindSetRange(AuxSupplyTraits::Channels chan, 
                       const ProgramTypes::SetType& volts, 
                       const ProgramTypes::SetType& amps);
@@ -36,6 +40,7 @@ struct AuxSupply : private Instrument<AuxSupplyTraits::ModelType::BusType>,
     ProgramTypes::SetType GetMaxVolts(AuxSupplyTraits::Channels chan);
     ProgramTypes::SetType GetVolts(AuxSupplyTraits::Channels chan);
     bool Initialize();
+    void InvalidateShadow();
     bool IsError();
     std::string Name() const;
     bool OperationComplete();
@@ -44,14 +49,20 @@ struct AuxSupply : private Instrument<AuxSupplyTraits::ModelType::BusType>,
     bool Reset();
     bool SetCurrent(Channel chan, const ProgramTypes::SetType& limit);
     bool SetVolts(Channel chan, const ProgramTypes::SetType& value);
+    long SuppressedCommands() const;
     std::string WhatError();
     //======================
     // End Public Interface
     //======================
 
+private:
+    enum Setting { AMPS, OUTPUT, VOLTS };
+    typedef std::pair<Channel, Setting> ShadowKey;
+
 private:    
     bool command(const std::string& cmd);
     std::string query(const std::string& q);
+    bool send(const ShadowKey& key, const std::string& cmd);
 
 private:
     typedef AuxSupplyTraits::ModelType ModelType;
@@ -71,6 +82,7 @@ private:
     std::auto_ptr<RangeMap> rangeMap_;
     std::auto_ptr<ValueMap> valueMap_;
     std::string name_;
+    ShadowState<ShadowKey> shadow_;
 };
 
 } // namespace SPTSInstrument
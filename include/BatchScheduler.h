@@ -0,0 +1,104 @@
+// Macro Guard
+#ifndef SPTS_BATCH_SCHEDULER_H
+#define SPTS_BATCH_SCHEDULER_H
+
+// Files included
+#include "NoCopy.h"
+#include "ProgramTypes.h"
+#include "SingletonType.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Temperature-banded scheduling of a lot of DUTs.  A lot file, named after the work
+    order and found under StationFile::LotPath(), lists each test type (temperature
+    band) to run along with its base temperature, and each DUT serial number:
+        TEMPERATURE  <test type>  <degrees C>
+        DUT          <serial number>
+   Every DUT is run through one band before the base plate moves to the next, so a
+    lot costs one thermal transition per band instead of one per DUT per band.  Bands
+    are ordered to minimize total base plate travel from the starting temperature.
+   Completed (serial, test type) results are appended to a state file next to the lot
+    file so that a lot interrupted between bands (or DUTs) resumes where it left off.
+   If there is no lot file for the work order, the scheduler is inactive and testing
+    proceeds exactly as it does without it.
+   A lot file may also carry
+        POLICY       FAILFAST
+    to let production runs of the lot stop at the first failed step, with steps
+    risk-ordered from failure history (see TestSequence::Synchronize()), and/or
+        POLICY       SKIPLOT  <N>  [<minimum Cpk>]
+    to let production runs of the lot skip steps whose archived results are capable
+    (Cpk of at least SkipLotCpk(), 2.0 unless given) and stable, so long as each such
+    step is still measured at least once every N archived sequences.
+*/
+
+struct BatchScheduler : private NoCopy {
+    //========================
+    // Start Public Interface
+    //========================
+    struct Job {
+        std::string SerialNumber;
+        std::string TestType;
+        ProgramTypes::SetType Temperature;
+    };
+
+    bool AtEnd() const;
+    bool IsActive() const;
+    bool IsFailFast() const;
+    bool IsScheduled(const std::string& serialNumber, const std::string& testType) const;
+    static std::string Name();
+    Job Next() const;
+    void Record(const std::string& serialNumber, const std::string& testType,
+                bool passed);
+    long RemainingTransitions() const;
+    double SkipLotCpk() const;
+    long SkipLotRate() const;
+    void Synchronize(const std::string& workOrder,
+                     const ProgramTypes::SetType& currentTemperature);
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    friend class SingletonType<BatchScheduler>;
+    BatchScheduler();
+    ~BatchScheduler();
+
+private:
+    typedef std::pair<std::string, std::string> Key; // (serial, test type)
+    typedef std::pair<std::string, ProgramTypes::SetType> Band;
+
+private:
+    void clear();
+    void loadLot(const std::string& lotFile);
+    void loadState(const std::string& stateFile);
+    void orderBands(const ProgramTypes::SetType& currentTemperature);
+
+private:
+    std::string workOrder_;
+    std::string stateFile_;
+    std::vector<Band> bands_;
+    std::vector<std::string> duts_;
+    std::map<Key, bool> done_;
+    bool failFast_;
+    long skipLotRate_;
+    double skipLotCpk_;
+};
+
+#endif // SPTS_BATCH_SCHEDULER_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
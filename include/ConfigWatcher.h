@@ -0,0 +1,75 @@
+// Macro Guard
+#ifndef SPTS_CONFIG_WATCHER_H
+#define SPTS_CONFIG_WATCHER_H
+
+// Files included
+#include "NoCopy.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Tells a configuration singleton whether what it last loaded is still good.  Watch()
+    records the inputs used to pick the files (family, dash number, work order, ...)
+    and the path, size, modification time and content hash of every file consulted,
+    including files that did not exist.  Current() is true only when the inputs are
+    the same and no watched file has been created, removed or edited since.
+   Where the operating system offers directory change notifications they are checked
+    first:  a file in a directory where nothing has been touched is not looked at.
+    A file in a directory whose notification fired is read to compare hashes even
+    when its size and time look the same (an edit within the time's resolution).
+    A file in a directory without notifications is stat()'d, and read only when
+    its size or time changed --> saving a file unchanged forces no reload.
+*/
+
+struct ConfigWatcher : private NoCopy {
+    //==================
+    // Public Interface
+    //==================
+    ConfigWatcher();
+    ~ConfigWatcher();
+    bool Current(const std::string& inputs);
+    std::string Name() const;
+    void Reset();
+    void Watch(const std::string& inputs, const std::vector<std::string>& files);
+
+private:
+    struct Stamp {
+        bool exists_;
+        long size_;
+        long modified_;
+        unsigned long hash_;
+    };
+    typedef std::map<std::string, Stamp> Stamps; // path to stamp
+    typedef std::map<std::string, void*> Notifications; // directory to OS handle
+    typedef std::set<std::string> Directories;
+
+private:
+    void closeNotifications();
+    bool quiet(Directories& fired, Directories& unwatched);
+    static Stamp stamp(const std::string& path, bool withHash);
+    void watchDirectory(const std::string& path);
+
+private:
+    std::string inputs_;
+    Notifications notifications_;
+    Stamps stamps_;
+    bool watching_;
+};
+
+#endif // SPTS_CONFIG_WATCHER_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
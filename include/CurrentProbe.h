@@ -15,6 +15,11 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+   Added queryBatch() --> several queries in one I2C batch.
+
    ==============
    03/02/05, sjn,
    ==============
@@ -81,6 +86,7 @@ private:
     void checkDegaussState();
     bool command(const std::string& cmd);
     std::string query(const std::string& q);
+    std::vector<std::string> queryBatch(const std::vector<std::string>& qs);
     void wait();
     double waitCalculate();
 
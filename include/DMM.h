@@ -7,6 +7,7 @@
 #include "Instrument.h"
 #include "ProgramTypes.h"
 #include "NoCopy.h"
+#include "ShadowState.h"
 #include "StandardFiles.h"
 
 
@@ -33,7 +34,11 @@ struct DMM : private Instrument<DMMTraits::ModelType::BusType>, private NoCopy {
     //========================
     // Start Public Interface
     //========================
+    void AbortTransaction();
+    void BeginTransaction();
+    bool CommitTransaction();
 	bool Initialize();
+    void InvalidateShadow();
 	bool IsError();
     ProgramTypes::MType MeasureOhms();
     ProgramTypes::MType MeasureDCVolts();
@@ -43,6 +48,7 @@ struct DMM : private Instrument<DMMTraits::ModelType::BusType>, private NoCopy {
 	bool Reset();
     void SetMode(Mode mode);
     void SetRange(const ProgramTypes::SetType& range = AUTO);    
+    long SuppressedCommands() const;
     std::string WhatError();
     //======================
     // End Public Interface
@@ -60,6 +66,7 @@ private:
     typedef DMMTraits::ModelType Model;    
     typedef Model::Language Language;
     typedef DMMTraits::ModelType::BusType BusType;
+    enum Setting { CONFIGURE };
 
 private:
 	long address_;
@@ -70,6 +77,7 @@ private:
     ProgramTypes::SetType rangeoC_;
     bool needReset_;
     std::string name_;
+    ShadowState<Setting> shadow_;
 };
 
 } // namespace SPTSInstrument
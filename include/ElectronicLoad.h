@@ -100,7 +100,6 @@ private:
 	bool concatenate_;
 	bool locked_;
 	std::string syntax_;
-	std::string totalSyntax_;
 	long toggle_;
 	std::string lastError_;
 	long address_;
@@ -5,6 +5,7 @@
 // Files included
 #include "Converter.h"
 #include "DateTime.h"
+#include "ErrorRecord.h"
 #include "Messenger.h"
 #include "NoCopy.h"
 #include "OperatorInterface.h"
@@ -15,6 +16,21 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes (in Main) <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Every message is also kept as an ErrorRecord (time, severity, instrument, test
+       step, message) in a bounded buffer --> oldest records are dropped past
+       MAXRECORDS, and the count dropped is logged.  Archive() appends them in
+       binary to ErrorLog.bin beside ErrorLog.txt; tools/ErrorLogReader.cpp
+       decodes that file to text.
+     Added Log(), SetStep() and Clear().  operator<< logs at ErrorRecord::FAULT.
+     Added SetInstrument() and LastInstrument() --> the instrument SPTS last reported
+       in error, for records logged where only the exception is at hand.  Clear()
+       resets it and the test step.
+     The log directory may be set with the SPTSERRORLOG environment variable; it
+       defaults to the old hardcoded C:\ErrorLog\.
+
    ==============
    04/26/05, sjn,
    ==============
@@ -42,16 +58,17 @@ struct ErrorLogger : public Messenger, private NoCopy {
         try { // Get as much information into the ErrorLogger as possible
             /*
               Realize that the error log should be the one thing that is always
-                available.  It is a hardcoded path below because of this.  It doesn't
+                available.  It is a local path below because of this.  It doesn't
                 really make sense to place a error log in the current working directory
                 because that directory may change depending on where the application is
                 built - we need a dependable repository that doesn't move and have
                 different variations throughout the computer system.  It should not be
                 on the network, because we need to report that the network is down, etc.
                 No matter what else cannot be read in properly, the error log must be
-                accessible to record that information.
+                accessible to record that information.  For the same reason, only an
+                environment variable (never a station file) may move it.
             */
-            static char* file = "C:\\ErrorLog\\ErrorLog.txt";
+            std::string file = directory() + "ErrorLog.txt";
             static std::string header = "/*======================================*/";
             OperatorInterface* oi = 0;
             try {
@@ -62,7 +79,7 @@ struct ErrorLogger : public Messenger, private NoCopy {
             try {
                 dut = SingletonType<Converter>::Instance();
             } catch(...) { dut = 0; }
-            std::ofstream eFile(file, std::ofstream::app);
+            std::ofstream eFile(file.c_str(), std::ofstream::app);
             Assert<StationExceptionTypes::FileError>(eFile != 0, name());       
             eFile << std::endl     << header               << std::endl;
             eFile << "Date:      " << Date::CurrentDate()  << std::endl;
@@ -83,13 +100,104 @@ struct ErrorLogger : public Messenger, private NoCopy {
         } catch(...) { // ? cannot record information
             return;
         }
+
+        try { // structured copy --> text log above is already safe
+            std::string file = directory() + "ErrorLog.bin";
+            std::ofstream bFile(file.c_str(), std::ios::app | std::ios::binary);
+            if ( dropped_ > 0 ) {
+                std::stringstream s;
+                s << dropped_ << " earlier record(s) dropped";
+                ErrorRecord::Write(bFile, ErrorRecord(ErrorRecord::WARNING, "",
+                                                      step_, s.str()));
+            }
+            std::deque<ErrorRecord>::const_iterator i = records_.begin();
+            while ( i != records_.end() )
+                ErrorRecord::Write(bFile, *i++);
+            bFile.close();
+        } catch(...) { /* text log has it */ }
+    }
+
+    //=========
+    // Clear()
+    //=========
+    void Clear() {
+        Messenger::Clear();
+        records_.clear();
+        dropped_ = 0;
+        instrument_ = "";
+        step_ = "";
+    }
+
+    //==================
+    // LastInstrument()
+    //==================
+    const std::string& LastInstrument() const {
+        // Instrument most recently reported in error; empty if none
+        return(instrument_);
+    }
+
+    //=======
+    // Log()
+    //=======
+    void Log(ErrorRecord::Severity severity, const std::string& instrument,
+             const std::string& message) {
+        Messenger::operator<<(message);
+        if ( records_.size() >= MAXRECORDS ) { // bounded --> keep the newest
+            records_.pop_front();
+            ++dropped_;
+        }
+        records_.push_back(ErrorRecord(severity, instrument, step_, message));
+    }
+
+    //=================
+    // SetInstrument()
+    //=================
+    void SetInstrument(const std::string& instrument) {
+        instrument_ = instrument;
+    }
+
+    //===========
+    // SetStep()
+    //===========
+    void SetStep(const std::string& step) {
+        // Test step recorded with each following message
+        step_ = step;
+    }
+
+    //============
+    // operator<<
+    //============
+    template <typename Type>
+    ErrorLogger& operator<<(const Type& t) {
+        std::stringstream s;
+        s << t;
+        Log(ErrorRecord::FAULT, "", s.str());
+        return(*this);
     }
 
+private:
+    enum { MAXRECORDS = 256 };
+
 private:
     friend class SingletonType<ErrorLogger>;
-    ErrorLogger()  { /* */ }
+    ErrorLogger() : dropped_(0) { /* */ }
     ~ErrorLogger() { /* */ }
     std::string name() { return("Error Logger Class"); }
+
+    std::string directory() {
+        const char* dir = std::getenv("SPTSERRORLOG");
+        std::string toRtn = (dir && *dir) ? dir : "C:\\ErrorLog\\";
+        char last = toRtn[toRtn.size()-1];
+        if ( (last != '\\') && (last != '/') )
+            toRtn += "\\";
+        return(toRtn);
+    }
+
+private:
+    long dropped_;
+    std::string instrument_;
+    std::deque<ErrorRecord> records_;
+    std::string step_;
 };
 
 #endif // SPTS_ERRORLOGGER_H
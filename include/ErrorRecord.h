@@ -0,0 +1,62 @@
+// Macro Guard
+#ifndef SPTS_ERROR_RECORD_H
+#define SPTS_ERROR_RECORD_H
+
+// Files included
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   One structured entry of the error log.  ErrorLogger appends these, in binary, to
+    ErrorLog.bin beside the text log so that logs may be searched by time, severity,
+    instrument or test step.  Read() and operator<< are all a reader needs (see
+    tools/ErrorLogReader.cpp).
+   Binary layout, all integers little endian:
+    "SPTR"  version(1 byte)  severity(1 byte)  timestamp(4 bytes, seconds since 1970)
+    then instrument, step and message, each as length(4 bytes) and characters.
+*/
+
+struct ErrorRecord {
+    //==============
+    // Public Enums
+    //==============
+    enum Severity { INFO, WARNING, FAULT, FATAL }; // not ERROR --> <windows.h> macro
+
+    //==================
+    // Public Interface
+    //==================
+    ErrorRecord();
+    ErrorRecord(Severity severity, const std::string& instrument,
+                const std::string& step, const std::string& message);
+    static std::string Name(Severity severity);
+    static bool Read(std::istream& is, ErrorRecord& record);
+    static void Write(std::ostream& os, const ErrorRecord& record);
+    friend std::ostream& operator<<(std::ostream& os, const ErrorRecord& record);
+
+    //================
+    // Public Members
+    //================
+    std::string Instrument;
+    std::string Message;
+    Severity Level;
+    std::string Step;
+    unsigned long Timestamp; // seconds since 1970
+};
+
+#endif // SPTS_ERROR_RECORD_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,110 @@
+// Macro Guard
+#ifndef SPTS_FAILURE_HISTORY_H
+#define SPTS_FAILURE_HISTORY_H
+
+// Files included
+#include "NoCopy.h"
+#include "SingletonType.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Pass/fail history of each test step, taken from a family's production archive
+    (StationFile::LocalArchive(), written through DataArchive).  Each archived
+    sequence is a header line followed by one line per test step:
+        [prefix]<family>-<dash>,<work order>,<serial>,<test type>,...
+        <step #>,<test name>,<low>,<high>,<measured>,,<units>,<P|F>,<error code>
+   Synchronize() reads only what was appended since its last call, so the archive
+    is read in full once per program run and after that a DUT at a time.
+   FailureRate() and NumberSequences() count production runs only:  unprefixed,
+    rework (RM) and deviation (DEV) headers.  Engineering, gold standard, test
+    engineering and station debug runs (ENG, GLD, TE, DBG per DataArchive) do not.  GetCapability() uses unprefixed (production) headers only -->
+    deviation runs have limits of their own and must not move a step's statistics.
+    It gives the mean and standard deviation of every valid measured value of a
+    step, the same over the last RECENT runs, whether any of those failed, and how
+    many archived sequences have gone by since the step was last run.
+*/
+
+struct FailureHistory : private NoCopy {
+    //==============
+    // Public Types
+    //==============
+    struct Capability {
+        long Samples;       // valid measured values, all runs
+        double Mean;
+        double Sigma;
+        long RecentSamples; // valid measured values, last RECENT runs
+        double RecentMean;
+        bool RecentFailure; // any of the last RECENT runs failed
+        long SinceLastRun;  // archived sequences since the step last ran
+    };
+
+    //========================
+    // Start Public Interface
+    //========================
+    double FailureRate(const std::string& familyDash, const std::string& testType,
+                       const std::string& testName) const;
+    Capability GetCapability(const std::string& familyDash, const std::string& testType,
+                             const std::string& testName) const;
+    std::string Name() const;
+    long NumberSequences(const std::string& familyDash,
+                         const std::string& testType) const;
+    void Synchronize(const std::string& archive);
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    friend class SingletonType<FailureHistory>;
+    FailureHistory();
+    ~FailureHistory();
+
+private:
+    enum { RECENT = 25 };
+    struct Counts {
+        Counts();
+        long runs_;
+        long failures_;
+        long lastSequence_; // Steps::sequences_ when last run
+        long samples_;
+        double mean_;
+        double m2_;         // sum of squared deviations from mean_
+        std::deque<bool> recentPassed_;   // last RECENT runs
+        std::deque<double> recentValues_; // last RECENT valid measured values
+    };
+    typedef std::pair<std::string, std::string> Key; // (archived header, test type)
+    struct Steps {
+        long sequences_;
+        std::map<std::string, Counts> counts_; // test name to counts
+    };
+    typedef std::map<Key, Steps> History;
+
+private:
+    static bool matches(const std::string& header, const std::string& familyDash);
+    void parse(const std::string& line);
+    void reset();
+
+private:
+    std::string archive_;
+    Key current_;
+    History history_;
+    std::streamoff offset_;
+};
+
+#endif // SPTS_FAILURE_HISTORY_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
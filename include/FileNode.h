@@ -10,6 +10,13 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+   Replaced the recursive private constructor FileNode(std::ifstream&, const string&)
+     with parse(), a single pass over the whole file.  Added key_ and find() -->
+     headers are normalized once when built rather than on every GetFileNode().
+
    ==============  
    07/27/04, sjn,
    ==============
@@ -46,15 +53,19 @@ struct FileNode {
     friend std::ostream& operator<<(std::ostream& os, const FileNode& fn);
 
 private:
+    FileNode();
     explicit FileNode(const std::string& head);
-    FileNode(std::ifstream& ifile, const std::string& head);
+    FileNode* find(const std::string& key);
     std::string name();
+    void parse(const char* begin, const char* end);
+    void setHeader(const std::string& header);
 
 private:
     std::vector<FileNode*> children_;
     std::string header_;
     std::string footer_;
     std::vector<std::string> info_;
+    std::string key_; // header_ without white space, uppercase
     static const std::string startHeader;
     static const std::string stopHeader;
     static const std::string endOfHeader;
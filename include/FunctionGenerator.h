@@ -8,12 +8,22 @@
 #include "Instrument.h"
 #include "NoCopy.h"
 #include "ProgramTypes.h"
+#include "ShadowState.h"
 #include "StandardFiles.h"
 
 //=====================================================================================//
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added AbortTransaction(), BeginTransaction() and CommitTransaction() to the
+       public interface.
+     Added InvalidateShadow() and SuppressedCommands() to the public interface.
+       Replaced ampl_, dc_, freq_, offset_ and isOff_ with shadow_.  Added Setting
+       and send().
+
    ==============
    06/23/05, sjn,
    ==============
@@ -41,7 +51,11 @@ struct FunctionGenerator
     // Start Public Interface
     //========================	
     FunctionGenerator();
+    void AbortTransaction();
+    void BeginTransaction();
+    bool CommitTransaction();
 	bool Initialize();
+    void InvalidateShadow();
 	bool IsError();
     std::string Name() const;
     bool OpsComplete();
@@ -51,6 +65,7 @@ struct FunctionGenerator
     void SetDutyCycle(const ProgramTypes::PercentType& percent);
     void SetFrequency(const ProgramTypes::SetType& value);
     void SetOffset(const ProgramTypes::SetType& value);
+    long SuppressedCommands() const;
     std::string WhatError();
     //======================
     // End Public Interface
@@ -59,22 +74,20 @@ struct FunctionGenerator
 private:
     typedef ProgramTypes::SetType SetType;
     typedef ProgramTypes::PercentType PercentType;
+    enum Setting { AMPLITUDE, DUTYCYCLE, FREQUENCY, OFFSET, OUTPUT };
 
 private:
     bool bitprocess(const std::string& errorString, 
                     Instrument<FunctionGeneratorTraits::BusType>::Register toCheck);
     bool command(const std::string& cmd);
     std::string query(const std::string& q);
+    void send(Setting key, const std::string& cmd);
 
 private:
-    SetType ampl_;
-    PercentType dc_;
-    SetType freq_;
-    SetType offset_;
     long address_;
-    bool isOff_;
     bool locked_;
     std::auto_ptr<FunctionGeneratorInterface> fg_;
+    ShadowState<Setting> shadow_;
 };
 
 }
@@ -18,10 +18,11 @@ class Instrument;
 
 
 // The current implementation of this class is very specific to the Aardvark
-//  USB-2-I2C adapter.  It is further limited to having only one possible slave
-//  currently as it is very unlikely that multiple instruments in the station would
-//  ever communicate via I2C.  If it does become necessary, this implementation will
-//  need to be extended.  See GPIB.h/GPIB.cpp for an example.
+//  USB-2-I2C adapter.  Each slave may run at its own bitrate ("I2C Bitrate" in the
+//  instrument file); the adapter is switched only when the next slave differs.
+// Register reads are one write-then-read transaction with a repeated start, so the
+//  bus is never left held between the register select and the read.  queryBatch()
+//  runs a queue of commands, each followed by its register read, in one call.
 
 class I2C {
     friend class Instrument<I2C>;
@@ -30,22 +31,30 @@ class I2C {
     ~I2C();
     bool isError();
 	long maxAddress() const;
+    long open(long board, long primary, const std::pair<bool, long>& secondary);
 	std::string query(long address, const std::string& command = "",
                       double toWait = 0);
+    std::vector<std::string> queryBatch(long address, 
+                                        const std::vector<std::string>& commands,
+                                        double toWait = 0);
 	void talk(long address, const std::string& command);
     std::string name() const;
     std::string whatError() const;
 
+    std::string readRegister(long address);
+    void selectBitrate(long address);
+    void setBitrate(long address, long kHz);
+    void write(long address, const std::string& bytes, bool stop);
 
+    typedef std::map<long, long> BitrateMap; // address --> kHz
     int handle_;
     int portNumber_;
     char commandReg_;
     char queryReg_;
-    bool noStop_;
-    bool setQueryReg_;
-    int numBytes_;
-    int bytesRead_;
-    int queryBytes_;
+    long bitrate_;
+    std::auto_ptr<BitrateMap> bitrates_;
+    std::vector<unsigned char> writeBuffer_;  // reused for every write
+    std::vector<unsigned char> readBuffer_;   // reused for every read
     std::string whatError_;
 };
 
@@ -12,6 +12,27 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================  
+   10/19/26, agent,
+   ================
+     Added queryBlockInstr() for IEEE 488.2 binary block responses.
+     Added queryBatchInstr() --> a queue of queries run in one call, for bus types
+      that provide queryBatch() (I2C).
+     Added transactions: beginTransaction(), commitTransaction(), abortTransaction()
+      and inTransaction().  While one is open, commandInstr() to its address queues
+      the command; commit sends the queue joined by the instrument's separator as
+      one bus write --> one bus status check per transaction rather than per
+      setting.  A transaction is never split by size:  like the hand concatenation
+      it replaces, it is sent whole.  A query to the same address takes the queue
+      with it:  queued commands and the query go out as one write, in order.
+      commitSent() tells the instrument whether the transaction it just committed
+      wrote anything, so that it makes one error check per transaction sent.
+     Transactions nest:  only the outermost commit talks to the instrument.  An
+      inner abort marks the transaction aborted; the outermost commit or abort
+      then drops the queue (commit returns false) and closes it.
+     Declared the getAddress() specializations for I2C (slave address and bitrate)
+      and SocketSCPI (LAN address); the generic getAddress() serves GPIB.
+
    ==============  
    03/03/05, sjn,
    ==============
@@ -38,18 +59,46 @@ public:
     enum Register { OPSCOMPLETE, ERROR };
     static std::string WhatBusError();
 protected:
+    Instrument();
+    void abortTransaction();
+    void beginTransaction(long address, const std::string& separator);
     bool commandInstr(long address, const std::string& command);
+    bool commitSent() const;
+    bool commitTransaction();
     long getAddress(InstrumentTypes::Types instrType);
+    bool inTransaction() const;
     std::string queryInstr(long address, const std::string& query,
                            double pauseIfQueryNotEmpty = 0);
+    std::vector<std::string> queryBatchInstr(long address,
+                                        const std::vector<std::string>& queries,
+                                        double pauseAfterEach = 0);
+    BusBlock queryBlockInstr(long address, const std::string& query);
 private:
+    bool flush();
     std::string name();
 
 private:
 	static BusType bus_;
     static std::string busError_;
+    long txAddress_;
+    bool txAborted_;
+    long txDepth_;
+    bool txSent_;
+    std::string txSeparator_;
+    std::string txSyntax_;
 };
 
+// Bus types addressed other than by board, primary and secondary address
+//  --> defined with the bus type
+class I2C;
+class SocketSCPI;
+
+template <>
+long Instrument<I2C>::getAddress(InstrumentTypes::Types instrType);
+
+template <>
+long Instrument<SocketSCPI>::getAddress(InstrumentTypes::Types instrType);
+
 } // namespace SPTSInstrument
 
 #include "Instrument.template"  // Microsoft 7.0 workaround
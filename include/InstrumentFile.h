@@ -19,6 +19,14 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added GetBoard() and GetSecondaryAddress() for stations with more than one GPIB
+       board.  Both entries are optional in the instrument file.
+     Added GetLanAddress() for instruments on the SocketSCPI bus.
+     Added GetI2CBitrate() --> optional per-instrument I2C bus speed.
+
    ==============
    11/14/05, sjn,
    ==============
@@ -73,8 +81,12 @@ struct InstrumentFile : public SPTSInstrument::InstrumentTypes, NoCopy {
     // Start Public Interface
     //========================
     long GetAddress(Types type);    
+    long GetBoard(Types type);
+    std::pair<bool, long> GetI2CBitrate(Types type);
+    std::string GetLanAddress(Types type);
     std::string GetModelType(Types type);
     static std::string GetName(Types type);
+    std::pair<bool, long> GetSecondaryAddress(Types type);
     SetType LoadAccuracy(LoadTraits::Channels chan, const SetType& val);
     SetType LoadResolution(LoadTraits::Channels chan, const SetType& val);
     MaxType MaxAmplitude(Types funcGen = FUNCTIONGENERATOR);
@@ -122,6 +134,7 @@ private:
     { /* */ }
 
 private:
+    static std::string addressVariable(Types type, const std::string& variable);
     static std::string name();
     std::pair<MinType, MaxType> getScopeRange(const std::string& minVal, 
                                               const std::string& maxVal);
@@ -16,6 +16,13 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added WaveformData(), WaveformScaling() overloads and WaveformSource():
+       WORD samples per Initialize()'s CFMT/CORD, scaled from the WAVEDESC block.
+     Added private inspect().
+
    ==============
    05/23/05, sjn,
    ==============
@@ -378,6 +385,29 @@ protected:
     virtual std::string WhatError()
 	    { return("CHL? CLR"); }
 
+    // Waveform upload overloads
+    virtual std::string WaveformData(OScopeChannels::Channel chan)
+        { return("C" + convert<std::string>(chan) + ":WF? DAT1"); }
+    virtual std::string WaveformScaling(OScopeChannels::Channel chan)
+        { return("C" + convert<std::string>(chan) + ":INSP? 'WAVEDESC'"); }
+    virtual WaveformScale WaveformScaling(const std::string& value)
+        {
+            WaveformScale toRtn;
+            toRtn.XIncrement     = inspect(value, "HORIZ_INTERVAL");
+            toRtn.XOrigin        = inspect(value, "HORIZ_OFFSET");
+            toRtn.XReference     = 0;
+            toRtn.YIncrement     = inspect(value, "VERTICAL_GAIN");
+            toRtn.YOrigin        = -inspect(value, "VERTICAL_OFFSET");
+            toRtn.YReference     = 0;
+            toRtn.BytesPerSample = 2; // CFMT DEF9, WORD, BIN and CORD HI
+            toRtn.IsSigned       = true;
+            toRtn.MinCode        = -32000; // ADC codes shifted into the high byte;
+            toRtn.MaxCode        = 32000;  //  the screen spans +/- 25600
+            return(toRtn);
+        }
+    virtual std::string WaveformSource(OScopeChannels::Channel)
+        { return("WFSU SP,0,NP,0,FP,0,SN,0"); } // every point, no sparsing
+
 public:
 	virtual ~LecroyLT224Language() 
         { /* */ }  
@@ -387,6 +417,17 @@ private:
         /* Use very judiciously; only changes text color */
         { return("COLR TEXT,LTGRAY"); }
 
+    static double inspect(const std::string& desc, const std::string& key)
+        { // WAVEDESC lines are "KEY    : value"
+            std::string::size_type pos = desc.find(key);
+            Assert<UnexpectedState>(pos != std::string::npos, name() + ": " + key);
+            std::string::size_type from = desc.find(':', pos);
+            std::string::size_type to = desc.find('\n', pos);
+            Assert<UnexpectedState>((from != std::string::npos) && (from < to), 
+                                    name() + ": " + key);
+            return(convert<double>(RemoveAllWhiteSpace(desc.substr(from+1, to-from-1))));
+        }
+
     static std::string name() 
         { return("LT224 Language"); }
 };
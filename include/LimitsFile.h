@@ -3,6 +3,7 @@
 #define SPTS_LIMITS_FILE_H
 
 // Files included
+#include "ConfigWatcher.h"
 #include "GenericAlgorithms.h"
 #include "NoCopy.h"
 #include "OperatorInterface.h"
@@ -16,6 +17,13 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added watcher_ --> Reload() keeps the loaded limits when the family, dash
+       number, work order, test type and related inputs are unchanged and no limits
+       or .support file has changed on disk.
+
    ==============
    03/09/05, sjn,
    ==============
@@ -140,6 +148,7 @@ private:
     const std::string nil_;
     bool atEnd_;
     std::string revision_;
+    ConfigWatcher watcher_;
 };
 
 #endif // SPTS_LIMITS_FILE_H
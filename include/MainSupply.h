@@ -7,6 +7,7 @@
 #include "MainSupplyTraits.h"
 #include "NoCopy.h"
 #include "ProgramTypes.h"
+#include "ShadowState.h"
 #include "StandardFiles.h"
 #include "SupplyInterface.h"
 
@@ -14,6 +15,15 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added AbortTransaction(), BeginTransaction() and CommitTransaction() to the
+       public interface.
+     Added InvalidateShadow() and SuppressedCommands() to the public interface.
+       Added shadow_, Setting and send().
+     Added GetResolution() to the public interface.
+
    ==============
    11/14/05, sjn,
    ==============
@@ -43,11 +53,16 @@ struct MainSupply : private Instrument<MainSupplyTraits::BusType>, private NoCop
     explicit MainSupply(const std::pair<const ProgramTypes::SetType, 
                                         const ProgramTypes::SetType>& values);
     ~MainSupply();
+    void AbortTransaction();
+    void BeginTransaction();
     bool CanTrustVoltsMeasure() const;
+    bool CommitTransaction();
     ProgramTypes::MType GetAccuracy() const;
     ProgramTypes::SetType GetAmps();
+    ProgramTypes::SetType GetResolution() const;
     ProgramTypes::SetType GetVolts();  
     bool Initialize();
+    void InvalidateShadow();
     bool IsError();
     bool IsOn();
     ProgramTypes::MType MeasureVolts();
@@ -59,12 +74,16 @@ struct MainSupply : private Instrument<MainSupplyTraits::BusType>, private NoCop
     bool SetCurrent(const ProgramTypes::SetType& limit);
     bool SetCurrentProtection(Switch state);
     bool SetVolts(const ProgramTypes::SetType& value);
+    long SuppressedCommands() const;
     std::string WhatError();
     MainSupplyTraits::Supply WhichSupply() const;
     //======================
     // End Public Interface
     //======================
 
+private:
+    enum Setting { AMPS, OUTPUT, PROTECTION, VOLTS };
+
 private:
     bool bitprocess(std::string& toProcess);
     bool bitprocess(std::string& eString, 
@@ -72,6 +91,7 @@ private:
     bool command(const std::string& cmd);
     bool command(const std::string& cmd, long address);
     std::string query(const std::string& q);
+    bool send(Setting key, const std::string& cmd);
 
 private:
     std::auto_ptr<SupplyInterface> supply_;
@@ -85,6 +105,7 @@ private:
     ProgramTypes::SetType vin_;
     MainSupplyTraits::Supply supplyType_;
     std::string name_;
+    ShadowState<Setting> shadow_;
 };
 
 } // namespace SPTSInstrument
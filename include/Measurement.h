@@ -17,6 +17,14 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+   Added Reset() --> measurement objects are pooled and reused between test steps.
+   Added DependsOn() and virtual dependsOn() --> a measurement whose value is only
+     ever found among another measurement's extra measurements names it, so that
+     steps may be reordered or skipped without separating the two.
+
    ==============
    05/06/05, sjn,
    ==============
@@ -67,6 +75,7 @@ public:
     //========================
     // Start Public Interface
     //========================
+    std::string DependsOn() const;
     bool DoneAlready(ConditionsPtr current, ConditionsPtr previous);
     ReturnTypeContainer ExtraMeasurements();
     std::string GetName() const;
@@ -74,6 +83,7 @@ public:
     ReturnType Measure(ConditionsPtr conditions, const ProgramTypes::PairMType& limits);
     ReturnType MeasureWithoutPrePostConditions(ConditionsPtr conditions, 
                                                const ProgramTypes::PairMType& limits);
+    void Reset();
     long WhatDUTError() const;
     //======================
     // End Public Interface
@@ -94,6 +104,7 @@ private:
     virtual void operator()(ConditionsPtr, const PairMType& limits) = 0;
     virtual std::string name() const = 0;
     virtual bool dealWithRampVinInBase() const;
+    virtual std::string dependsOn() const;
 
 protected:
     static SpacePowerTestStation::SPTS* spts_;
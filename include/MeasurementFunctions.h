@@ -10,6 +10,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added LoadTransientRecovery::dependsOn() --> its value comes only from
+       LoadTransientResponse's extra measurements.
+
    ==============
    04/28/05, sjn,
    ==============
@@ -337,6 +343,7 @@ struct LoadTransientRecovery : public Measurement {
     // Measurement Base Virtual Function Overrides
     void operator()(ConditionsPtr conditions, const PairMType& limits); 
     bool beenDone(ConditionsPtr current, ConditionsPtr previous) const;
+    std::string dependsOn() const;
     std::string name() const { return(Name()); }
 
     // Static Funcs
@@ -13,6 +13,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+    Added WaveformScale, WaveformData(), WaveformScaling() overloads and
+      WaveformSource() for uploading a held waveform as a binary block.
+
   ==============
   05/23/05, sjn,
   ==============
@@ -206,6 +212,25 @@ struct OScopeInterface : public OScopeParameters, public OScopeMeasurements {
 
     virtual std::string WhatError() = 0;
 
+    // Waveform upload: WaveformSource() selects the channel and sample format,
+    //  WaveformScaling() queries what converts samples to volts and seconds, and
+    //  WaveformData() answers with an IEEE 488.2 definite length binary block.
+    //  Volts  = (code - YReference) * YIncrement + YOrigin
+    //  Time   = (index - XReference) * XIncrement + XOrigin, relative to trigger
+    //  Codes at or beyond MinCode or MaxCode are off screen.
+    struct WaveformScale {
+        double XIncrement, XOrigin, XReference;
+        double YIncrement, YOrigin, YReference;
+        long BytesPerSample; // 1 or 2, most significant byte first
+        bool IsSigned;
+        long MinCode, MaxCode;
+    };
+
+    virtual std::string WaveformData(OScopeChannels::Channel chan)    = 0;
+    virtual std::string WaveformScaling(OScopeChannels::Channel chan) = 0;
+    virtual WaveformScale WaveformScaling(const std::string& value)   = 0;
+    virtual std::string WaveformSource(OScopeChannels::Channel chan)  = 0;
+
 	virtual ~OScopeInterface() 
         { /* */ }
 
@@ -3,6 +3,7 @@
 #define OSCOPE_SETUP_FILE_H
 
 // Files included
+#include "ConfigWatcher.h"
 #include "GenericAlgorithms.h"
 #include "NoCopy.h"
 #include "OScopeParameters.h"
@@ -17,6 +18,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+      Added watcher_ --> Reload() keeps sf_ while the family number and the scope
+        setup file are unchanged.
+
   ==============
   10/11/04, sjn,
   ==============
@@ -120,6 +127,7 @@ private:
     std::auto_ptr<SF::Parameters> params_, masterParams_;
     bool locked_;
     bool valueSet_, masterSet_;
+    ConfigWatcher watcher_;
 };
 
 #endif // OSCOPE_SETUP_FILE_H
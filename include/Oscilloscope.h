@@ -17,6 +17,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+    Added nested Waveform type and Upload() --> pulls a held waveform off the scope
+      as one binary block and scales it to volts.  Added waveform_ and waveSource_.
+
   ==============
   09/29/04, sjn,
   ==============
@@ -47,6 +53,14 @@ struct Oscilloscope : protected Instrument<OscilloscopeTraits::BusType>,
     typedef OScopeChannels::Channel Channel;
     typedef OScopeMeasurements::MeasurementType MeasurementType;
 
+    // Public Types
+    struct Waveform {
+        std::vector<double> Volts;
+        double Start;    // time of Volts[0] relative to the trigger
+        double Interval; // time between samples
+        bool Clipped;    // some sample went off screen
+    };
+
     //========================
     // Start Public Interface
     //========================
@@ -87,6 +101,8 @@ struct Oscilloscope : protected Instrument<OscilloscopeTraits::BusType>,
     void SetVerticalScale(Channel chan, const ProgramTypes::SetType& scale);
     void Start();
     void Stop();
+    // Valid until the next Upload(); the scope must be stopped
+    const Waveform& Upload(Channel chan);
     std::string WhatError();
     //======================
     // End Public Interface
@@ -120,11 +136,12 @@ private:
     long address_;
     std::string syntax_;
     std::string name_;
-    std::string totalSyntax_;
     TriggerMode trigMode_;
     Channel trigSource_;
     ProgramTypes::SetType horzScale_;
     bool trigModeSet_;
+    Waveform waveform_;
+    Channel waveSource_;
     std::auto_ptr<ChannelMap> channelMap_;
     std::auto_ptr<OScopeInterface> scope_;
 };
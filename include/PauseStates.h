@@ -13,6 +13,16 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added settle learning: AddSettleCurve(), IsLearning(), ProposedPauseValue() and
+       SettlePoints().  Added SettleCurve, LearnedType and SettleMode, plus members
+       learned_, learnedPath_ and mode_.
+     IsLearning() is true in LEARN mode only --> APPLY mode pauses once for
+       GetPauseValue().  Replaced saveLearned() with SaveSettleCurves() and added
+       unsaved_ --> learned curves are written once per DUT, not once per curve.
+
    ==============
    08/10/07,  mrb
    ==============
@@ -66,26 +76,53 @@ struct PauseStates : private NoCopy {
           independent of converter needs.
     */
 
+    /*
+        Settle learning is selected by "Settle Learning" in the pause file: LEARN
+          samples readings through the pause at SettlePoints() and records the time
+          each settles; APPLY samples nothing and shortens GetPauseValue() to
+          ProposedPauseValue() once enough runs are recorded.  Learned times are
+          kept per family beside the pause file (a family using the default pause
+          file gets its own) and written by SaveSettleCurves(), once per DUT.  Without them, the configured values are used.
+    */
+
+    // Public typedefs
+    typedef std::vector< std::pair<ProgramTypes::SetType, ProgramTypes::MType> >
+                                                    SettleCurve; // (seconds, reading)
+
     // Public Interface
+    void AddSettleCurve(PauseTypes type, const SettleCurve& curve);
     ProgramTypes::SetType GetPauseValue(PauseTypes type);    
     ProgramTypes::SetType GetPauseValue(StationPauses type);
+    bool IsLearning();
+    ProgramTypes::SetType ProposedPauseValue(PauseTypes type);
+    void SaveSettleCurves();
+    std::vector<ProgramTypes::SetType> SettlePoints(PauseTypes type);
     ProgramTypes::SetType SupplyCCModeChangePause(MainSupplyTraits::Supply whichSupply);
 
 private:
     typedef std::map<PauseTypes, std::string> MapStringType;
     typedef std::map<PauseTypes, ProgramTypes::SetType> MapType;
+    typedef std::map<PauseTypes, std::pair<long, ProgramTypes::SetType> > 
+                                      LearnedType; // (runs, longest settle seconds)
     enum Types { DEFAULT, SPECIFIC };
+    enum SettleMode { NOSETTLE, LEARNSETTLE, APPLYSETTLE };
 
 private:
     friend class SingletonType<PauseStates>;
     PauseStates();
     void checkForNewDUT();
+    ProgramTypes::SetType configured(PauseTypes type);
     MapStringType getString();
+    void loadLearned();
     void loadType(Types t);
 
 private:    
     std::auto_ptr<FileTypes::PauseFileType> pf_, defaultFile_;
     std::auto_ptr<MapType> map_;
+    LearnedType learned_;
+    std::string learnedPath_;
+    SettleMode mode_;
+    bool unsaved_;
     std::string familyNumber_;
     std::string name_;
 };
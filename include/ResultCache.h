@@ -0,0 +1,90 @@
+// Macro Guard
+#ifndef SPTS_RESULT_CACHE_H
+#define SPTS_RESULT_CACHE_H
+
+// Files included
+#include "ConverterOutput.h"
+#include "Measurement.h"
+#include "NoCopy.h"
+#include "ProgramTypes.h"
+#include "StandardFiles.h"
+#include "TestStepInfo.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Measurements made as a side effect of another test step (all outputs measured at
+    once, extra measurements, etc.) are stored here so later steps may use them
+    instead of measuring again.  Entries are hashed on a canonical key made from the
+    measurement type and the test conditions that every Measurement::beenDone()
+    implementation requires to match:  DUT temperature, Vin, per-output loads, Freq,
+    shorted outputs, pre/midtest relay states and inhibit state.  The hash table has
+    a fixed number of buckets so lookups are constant time on average.
+
+   Validity rules for reusing a stored value:
+    (1) same measurement type and same output channel
+    (2) same canonical key
+    (3) the measurement's own DoneAlready() agrees (per-type rules, Speedup(), etc.)
+    (4) a stored value is used at most once
+    (5) everything is dropped by Clear() before each DUT's sequence
+
+   The cache does not own the TestStepInfo objects it refers to --> these must live
+    until the next Clear() (TestSequence keeps them in sequence_).
+   Hit and miss counts are kept for the life of the cache, across DUTs.
+*/
+
+struct ResultCache : private NoCopy {
+    //========================
+    // Start Public Interface
+    //========================
+    ResultCache();
+    ~ResultCache();
+    void Clear(const ProgramTypes::SetType& temperature);
+    std::pair<bool, ProgramTypes::MType> Find(const TestStepInfo& current,
+                                         SPTSMeasurement::Measurement* toMeasure);
+    long Hits() const;
+    void Insert(const std::string& measureName, ConverterOutput::Output channel,
+                const ProgramTypes::MType& value, const TestStepInfo& source);
+    long Misses() const;
+    std::string Name() const;
+    long Size() const;
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    struct Entry {
+        unsigned long Key;
+        std::string Measure;
+        ConverterOutput::Output Channel;
+        ProgramTypes::MType Value;
+        const TestStepInfo* Source;
+    };
+
+private:
+    unsigned long key(const std::string& measureName,
+                      TestStepInfo::CondPtr cptr) const;
+
+private:
+    typedef std::list<Entry> Bucket;
+    std::vector<Bucket> buckets_;
+    double temperature_;
+    long hits_, misses_, size_;
+};
+
+#endif // SPTS_RESULT_CACHE_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -16,14 +16,29 @@ template <>
 struct SCPI<SwitchMatrixTag> : public SCPI<IEEE488> { 
     static std::string Close(long relay) 
         { return("CLOS (@" + convert<std::string>(relay) + ")"); }
+    static std::string Close(const std::vector<long>& relays)
+        { return("CLOS (@" + channelList(relays) + ")"); }
 	static std::string Initialize() 
         { return(ClearErrors()); }
     static std::string Open(long relay) 
         { return("OPEN (@" + convert<std::string>(relay) + ")"); }   
+    static std::string Open(const std::vector<long>& relays)
+        { return("OPEN (@" + channelList(relays) + ")"); }
     static std::string WhatError()
 		{ return("SYST:ERR?"); }
 protected:
 	~SCPI<SwitchMatrixTag>() { /* */ }  
+private:
+    static std::string channelList(const std::vector<long>& relays) {
+        std::string toRtn;
+        std::vector<long>::const_iterator i = relays.begin();
+        while ( i != relays.end() ) {
+            if ( ! toRtn.empty() )
+                toRtn += ",";
+            toRtn += convert<std::string>(*i++);
+        }
+        return(toRtn);
+    }
 };
 
 
@@ -12,6 +12,7 @@
 #include "StandardFiles.h"
 #include "StandardStationFiles.h"
 #include "Switch.h"
+#include "VinModel.h"
 
 // Instrument-related files
 #include "AuxSupply.h"
@@ -33,6 +34,16 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added BeginPathChange(), CommitPathChange(), AbortPathChange(), flushPathChange(),
+       pathAborted_, pathDepth_ and pathPending_.
+     Added GetStartupTimes() --> per-instrument Initialize() times in seconds.
+     Added GetSuppressedCommands() and invalidateShadows().
+     Added settleVin(), vinState(), vinModel_ and vinSet_ for SetVin().
+     Added UploadScope().
+
    ==============
    11/14/05, sjn,
    ==============
@@ -177,10 +188,15 @@ struct SPTS : public FilterSelects, public ACPathTypes, private NoCopy {
 	typedef ProgramTypes::MTypeContainer      MTypeContainer;
 	typedef ProgramTypes::SetTypeContainer    SetTypeContainer;
     typedef std::vector<LoadTraits::Channels> LoadChannels;
+    typedef std::vector< std::pair<std::string, double> > StartupTimes; // seconds
+    typedef std::vector< std::pair<std::string, long> > SuppressedCommands;
 
     //========================
     // Start Public Interface
     //========================
+    void AbortPathChange();
+    void BeginPathChange();
+    void CommitPathChange();
     ConverterOutput::Output Convert2ConverterOutput(LoadTraits::Channels fromChannel);
     ACPathTypes::ExplicitPaths Convert2ExplicitPath(ACPathTypes::ImplicitPaths imp, 
                                                     ConverterOutput::Output output);
@@ -196,6 +212,8 @@ struct SPTS : public FilterSelects, public ACPathTypes, private NoCopy {
 			                               LoadTraits::Channels chan) const;
     OScopeChannels::Channel GetScopeChannel(ACPathTypes::ExplicitPaths path) const;
     SetType GetScopeVertScale(OScopeChannels::Channel chan) const;
+    const StartupTimes& GetStartupTimes() const;
+    SuppressedCommands GetSuppressedCommands() const;
     SetType GetTemperatureSetpoint() const;
     SetType GetVin() const;
     void Initialize(bool resetTemp = true);
@@ -308,6 +326,8 @@ struct SPTS : public FilterSelects, public ACPathTypes, private NoCopy {
     void StartScope();
     void StopScope();
     void StrongInhibit(Switch type);
+    const SPTSInstrument::Oscilloscope::Waveform& 
+                           UploadScope(OScopeChannels::Channel chan, bool toPause = true);
     void WaitOnScope();
     std::pair<SPTSInstrument::InstrumentTypes::Types, std::string> WhatError();
     MainSupplyTraits::Supply WhichSupply();
@@ -325,7 +345,9 @@ private:
     // Private Helpers
     void customResets();
     bool dmmMeasurementCounter();
+    void flushPathChange();
     LoadChannels getLoads(Switch state);
+    void invalidateShadows();
     void measureScopePause();
     void newDUTSetup();
     void partSpecific();
@@ -340,7 +362,10 @@ private:
                  FilterSelects::FilterType bw);
     void setPathPause();
     void setTemperatureBaseLimits();
+    void settleVin(const SetType& vinValue, SetType setpoint);
+    void startupTime(const std::string& instrName, std::clock_t start);
     void temporaryPreloadDUT();
+    std::string vinState(const SetType& vinValue);
 
 private:
     typedef VariablesFile::MapDut2Load MapDut2Load;
@@ -371,10 +396,16 @@ private:
     bool poweredDown_;
     bool noReset_;
     bool alwaysReset_;
+    bool pathAborted_;
+    long pathDepth_;
+    bool pathPending_;
     StationFile::IinShunt iinShunt_;
     MainSupplyTraits::Supply psIsolation_;
     SetType lastVin_;
+    std::pair<SetType, SetType> vinSet_; // (supply setpoint, Vin asked for)
     std::string whatError_;
+    StartupTimes startupTimes_;
+    VinModel vinModel_;
     Converter* dut_;
     SPTSInstrument::InstrumentTypes::Types errorInstr_;
     std::string name_;
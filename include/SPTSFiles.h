@@ -13,6 +13,15 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+    Added SPTSFiles<PauseFileTag>::Path() --> PauseStates keeps learned settle times
+      beside the pause file.
+    Added Sources() to SPTSFiles<LimitsFileTag>, SPTSFiles<ScopeSetupFileTag> and
+      SPTSFiles<VariablesFileTag> --> every file consulted while loading, whether
+      or not it exists, so callers may watch them for changes (see ConfigWatcher).
+
    ==============
    03/09/05, sjn,
    ==============
@@ -128,6 +137,7 @@ struct SPTSFiles<LimitsFileTag> : private NoCopy {
     Tests GetTests(const std::string& dashNumber, const std::string& testType);
     bool IsDeviationTest() const;
     bool IsSetGold();
+    std::vector<std::string> Sources() const;
     ~SPTSFiles();
 
 private:
@@ -141,6 +151,7 @@ private:
     std::string famNumber_;
     bool isDev_;
     bool isGold_;
+    std::vector<std::string> sources_;
 };
 
 /***************************************************************************************/
@@ -157,6 +168,7 @@ struct SPTSFiles<PauseFileTag> : private NoCopy {
     // Public Interface
     explicit SPTSFiles(const std::string& familyNumber);
     std::string GetValue(const std::string& parameter);
+    std::string Path() const;
     ~SPTSFiles();
 
 private:
@@ -164,6 +176,7 @@ private:
 
 private:
     std::auto_ptr<FileNode> fn_;        
+    std::string path_;
 };
 
 /***************************************************************************************/
@@ -185,6 +198,7 @@ struct SPTSFiles<ScopeSetupFileTag> : private NoCopy {
     // Public Interface
     explicit SPTSFiles(const std::string& familyNumber);
     Parameters GetParameters(const std::string& testTypeName);
+    std::vector<std::string> Sources() const;
     ~SPTSFiles();
 
 private:
@@ -192,6 +206,7 @@ private:
 
 private:
     std::auto_ptr<FileNode> fn_;        
+    std::vector<std::string> sources_;
 };
 
 /***************************************************************************************/
@@ -299,6 +314,7 @@ struct SPTSFiles<VariablesFileTag> : private NoCopy {
     void GetVariables(const std::string& dashNumber);
     std::string GetVariableValue(const std::string& variable);
     bool IsDeviationTest() const;
+    std::vector<std::string> Sources() const;
     ~SPTSFiles();
 
 private:
@@ -312,6 +328,7 @@ private:
     std::auto_ptr<Variables> variables_;
     std::auto_ptr<FileNode> fn_;
     bool isDev_;
+    std::vector<std::string> sources_;
 };
 
 /***************************************************************************************/
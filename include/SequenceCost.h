@@ -0,0 +1,86 @@
+// Macro Guard
+#ifndef SPTS_SEQUENCE_COST_H
+#define SPTS_SEQUENCE_COST_H
+
+// Files included
+#include "ProgramTypes.h"
+#include "StandardFiles.h"
+#include "TestStepInfo.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Dry-run cost estimate of a synchronized test sequence.  Estimate() walks the test
+    steps in order, as TestSequence would, but touches no hardware:  time is summed
+    from PauseStates pauses, a temperature ramp from the starting temperature, relay
+    and Vin transitions, search iterations of the trip point and dropout tests, and
+    a per-command bus latency.  Rates come from "Cost ..." entries in the station
+    file with built-in fallbacks (see StationFile::CostCalibration()).
+   Measurements reused through the result cache are still charged in full, so the
+    estimate is an upper bound on a normal run.
+*/
+
+struct SequenceCost {
+    //==============
+    // Public Enums
+    //==============
+    enum Category { PAUSE, TEMPERATURE, RELAY, VIN, SEARCH, BUS, NUMCATEGORIES };
+
+    //========================
+    // Start Public Interface
+    //========================
+    typedef ProgramTypes::SetType SetType;
+
+    SequenceCost();
+    ~SequenceCost();
+
+    SetType CategoryTotal(Category cat) const;
+    void Estimate(const std::vector<TestStepInfo>& sequence,
+                  const SetType& startTemperature);
+    static std::string Name(Category cat);
+    long NumberSteps() const;
+    void Report(std::ostream& os) const;
+    SetType StepTotal(long step) const;
+    SetType Total() const;
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    typedef std::vector<double> Costs; // seconds, indexed by Category
+    struct Rates {
+        double busCommand_, dmmReading_, scopeReading_, vinSettle_, tempRamp_;
+        double loadResolution_, vinResolution_;
+    };
+
+private:
+    void charge(Costs& step, Category cat, double seconds) const;
+    void conditionCost(Costs& step, TestStepInfo::CondPtr cptr,
+                       const TestStepInfo* last, const Rates& r) const;
+    void measurementCost(Costs& step, TestStepInfo::TSPtr tptr,
+                         TestStepInfo::CondPtr cptr, const Rates& r) const;
+    std::string name() const;
+    Rates rates() const;
+
+private:
+    std::vector<std::string> names_;
+    std::vector<Costs> steps_;
+    Costs totals_;
+};
+
+#endif // SPTS_SEQUENCE_COST_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
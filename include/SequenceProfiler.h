@@ -0,0 +1,101 @@
+// Macro Guard
+#ifndef SPTS_SEQUENCE_PROFILER_H
+#define SPTS_SEQUENCE_PROFILER_H
+
+// Files included
+#include "NoCopy.h"
+#include "SingletonType.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Measured wall time of a test sequence, per test step and per phase --> the real
+    counterpart of SequenceCost's estimate.  TestSequence calls Start() for each DUT
+    and StartStep() for each test step; Main calls Finish() once the sequence is over.
+   A Timer charges the time of its scope to one Phase.  Timers nest:  time spent in an
+    inner Timer is charged to the inner phase only, so phases always add up to the
+    step's total.  Time not inside any Timer is charged to OTHER.  Resolution is that
+    of std::clock() (1ms, wall time, under Windows).
+   Report() shows the last DUT, Summary() the running means of every DUT of the same
+    family since start up, and Archive() appends the last DUT's steps to a file as
+    comma separated values.
+*/
+
+struct SequenceProfiler : private NoCopy {
+    //==============
+    // Public Enums
+    //==============
+    enum Phase { PREMEASUREMENT, VIN, LOADS, RELAYS, SYNC, INHIBIT, AUXSUPPLY, MEASURE,
+                 POSTMEASUREMENT, CACHE, GUI, TEMPERATURE, ERRORCHECK, OTHER,
+                 NUMPHASES };
+
+    //==============
+    // Public Types
+    //==============
+    struct Timer : private NoCopy {
+        explicit Timer(Phase phase);
+        ~Timer();
+    private:
+        Phase previous_;
+    };
+
+    //========================
+    // Start Public Interface
+    //========================
+    void Archive(const std::string& file) const;
+    void Finish();
+    static std::string Name(Phase phase);
+    void Report(std::ostream& os) const;
+    void Start(const std::string& family, const std::string& serial);
+    void StartStep(const std::string& step);
+    void Summary(std::ostream& os) const;
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    friend class SingletonType<SequenceProfiler>;
+    friend struct Timer;
+    SequenceProfiler();
+    ~SequenceProfiler();
+
+private:
+    typedef std::vector<double> Times; // seconds, indexed by Phase
+    struct Family {
+        long duts_;
+        Times totals_;
+    };
+
+private:
+    void charge();
+    std::string name() const;
+
+private:
+    Phase current_;
+    std::string family_;
+    std::map<std::string, Family> families_;
+    std::vector<std::string> names_;
+    bool running_;
+    std::string serial_;
+    std::clock_t since_;
+    std::vector<Times> steps_;
+    Times totals_;
+};
+
+#endif // SPTS_SEQUENCE_PROFILER_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,57 @@
+// Macro Guard
+#ifndef SPTS_SHADOW_STATE_H
+#define SPTS_SHADOW_STATE_H
+
+// Files included
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Shadow of an instrument's settings: the last command syntax sent for each setting
+    (Key), so that a command identical to the one already in effect need not be sent
+    again.  Instrument classes check IsCurrent() before sending, Update() after a
+    command is accepted, and Invalidate() whenever the instrument's real state is no
+    longer known:  Initialize()/Reset(), a reported error, an aborted transaction or
+    a command that throws.
+   Key is anything usable as a std::map key --> typically an instrument-specific
+    Setting enum, or a (channel, Setting) pair for multi-channel instruments.
+   Sent() and Suppressed() count commands for the life of the object.
+*/
+
+template <typename Key>
+class ShadowState {
+public:
+    ShadowState();
+    void Invalidate();
+    void Invalidate(const Key& key);
+    bool IsCurrent(const Key& key, const std::string& syntax);
+    long Sent() const;
+    long Suppressed() const;
+    void Update(const Key& key, const std::string& syntax);
+
+private:
+    typedef std::map<Key, std::string> MapType;
+    MapType state_;
+    long sent_;
+    long suppressed_;
+};
+
+#include "ShadowState.template"  // Microsoft 7.0 workaround
+
+#endif // SPTS_SHADOW_STATE_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic 
+        constants are to regular code" 
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,84 @@
+// Macro Guard
+#ifndef SPTS_SOCKET_SCPI_BUS_TYPE_H
+#define SPTS_SOCKET_SCPI_BUS_TYPE_H
+
+// Files included
+#include "GPIB.h"
+#include "StandardFiles.h"
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace SPTSInstrument {
+
+// Forward Declaration
+template <typename BusType>
+class Instrument;
+
+
+// Raw-socket SCPI (LXI instruments, port 5025 by default).  Each instrument's
+//  "LAN Address" entry in the instrument file gives host[:port]; see
+//  Instrument<SocketSCPI>::getAddress().  One connection per instrument is opened
+//  by open() and kept for the life of the program with Nagle's algorithm disabled,
+//  so each command goes out as soon as it is written.  A connection dropped after a
+//  send or receive error is reopened on next use.
+//  Commands are newline terminated; so are responses (a CR before the newline is
+//  dropped), except for IEEE 488.2 definite length binary blocks which queryBlock()
+//  reads by byte count.
+// To move an instrument model onto the LAN, change its BusType typedef (see
+//  Agilent34972A).  tools/SCPILoopback.cpp stands in for an instrument on localhost.
+
+class SocketSCPI {
+    friend class Instrument<SocketSCPI>;
+
+    SocketSCPI();
+    ~SocketSCPI();
+    bool isError();
+	long maxAddress() const;
+    long open(const std::string& lanAddress);
+	std::string query(long address, const std::string& command = "",
+                      double pauseAfterCommand = 0);
+    BusBlock queryBlock(long address, const std::string& command = "");
+	void talk(long address, const std::string& command);
+    std::string name() const;
+    std::string whatError() const;
+
+    struct Connection {
+        std::size_t Socket;
+        bool Connected;                // false once dropped after an error
+        std::string Host;
+        long Port;
+        std::string Endpoint;          // host:port
+        std::vector<char> ReadBuffer;  // reused for every read --> grows as needed
+        long Start, End;               // unread bytes: [Start, End) of ReadBuffer
+    };
+
+    void connect(Connection& conn);
+    Connection& connection(long address);
+    void drop(long address, Connection& conn, const std::string& error);
+    void fill(long address, Connection& conn);
+    void need(long address, Connection& conn, long count);
+    long readLine(long address, Connection& conn);
+
+    typedef std::map<long, Connection> MapType;
+    std::auto_ptr<MapType> map_;
+    std::string whatError_;
+};
+
+} // namespace SPTSInstrument
+
+#endif // SPTS_SOCKET_SCPI_BUS_TYPE_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic 
+        constants are to regular code" 
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
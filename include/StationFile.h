@@ -13,6 +13,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added LotPath() --> directory holding lot files for batch scheduling.
+     Added CostCalibration() --> optional "Cost <item>" rates for SequenceCost.
+
    ==============
    11/20/05, sjn,
    ==============
@@ -50,6 +56,7 @@ struct StationFile : private NoCopy {
     // Start Public Interface
     //========================
     std::string BackupLocalStorage();
+    std::pair<bool, ProgramTypes::SetType> CostCalibration(const std::string& item);
     ProgramTypes::MType GetShuntValue(IinDCBoard board, IinShunt whichShunt);
     std::pair<ProgramTypes::MType, ProgramTypes::MType>
                                       GetTemperatureTolerance(bool initialize);
@@ -58,6 +65,7 @@ struct StationFile : private NoCopy {
     std::string LocalErrorArchive();
     std::string LocalGoldArchive();
     std::string LocalTestEngArchive();
+    std::string LotPath();
     ProgramTypes::SetType MaxCurrentValue(IinDCBoard board, IinShunt whichShunt);
     bool NeedDegauss();    
     std::string OraclePath();
@@ -57,14 +57,18 @@ struct SwitchMatrix : public SwitchMatrixInheritance {
     // Start Public Interface
     //========================
     bool ChangedState(RelayType type);
+    void AbortTransaction();
+    void BeginTransaction();
 	bool Close(RFRelay relay);
 	bool Close(const RFRelayContainer& relays);
 	bool Close(DCRelay relay);
 	bool Close(const DCRelayContainer& relays);
     bool Close(FilterRelay relay);
     bool Close(const RFFilterContainer& relays);
+    bool CommitTransaction();
     bool CustomReset(RelayType type);
 	bool Initialize();
+    bool InTransaction() const;
 	bool IsError(RelayType r);
     std::string Name();
 	bool Open(RFRelay relay);
@@ -85,6 +89,9 @@ struct SwitchMatrix : public SwitchMatrixInheritance {
 
 private:
     bool bitprocess(const std::string& eString, Instrument<BT>::Register toCheck);
+    template <typename RelayMap>
+    bool change(RelayMap& known, RelayMap& pending, const RelayMap& wanted,
+                RelayType type, const std::string& name);
 	bool command(const std::string& cmd, RelayType type);
     std::string nameDC() const;
     std::string nameFilter() const;
@@ -102,6 +109,10 @@ private:
     std::auto_ptr<DCRelayMap> customResetDC_;
     std::auto_ptr<RFRelayMap> customResetRF_;
     std::auto_ptr<FilterRelayMap> customResetFilt_;  
+    bool inTransaction_;
+    std::auto_ptr<RFRelayMap> pendingRF_;
+    std::auto_ptr<DCRelayMap> pendingDC_;
+    std::auto_ptr<FilterRelayMap> pendingFilt_;
 };
 
 } // namespace SPTSInstrument 
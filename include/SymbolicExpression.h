@@ -0,0 +1,73 @@
+// Macro Guard
+#ifndef SPTS_SYMBOLIC_EXPRESSION_H
+#define SPTS_SYMBOLIC_EXPRESSION_H
+
+// Files included
+#include "ConverterOutput.h"
+#include "ProgramTypes.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Compiled form of a symbolic load or line setting from the limits file.  Text is
+    compiled once into a sum of terms, each a converter parameter (or 1 for a plain
+    value) scaled by a constant:
+      load terms:  FULL LOAD, HALF LOAD, NO LOAD, TEN% LOAD, <number>% LOAD, <value>
+      line terms:  LOW LINE, NOMINAL LINE, HIGH LINE, <value>
+    Terms may be summed with '+' (ie; "HALF LOAD + 100mA").  <value> is anything
+    ScaleUnits<> understands.  Symbols are matched without regard to case or spaces.
+   Compile() keeps every expression it has built, so each distinct string in the
+    limits file is parsed once per program run.  Evaluate() reads the converter's
+    current parameters and so always reflects the DUT under test.
+*/
+
+struct SymbolicExpression {
+    //==============
+    // Public Enums
+    //==============
+    enum Kind { LOAD, LINE };
+
+    //========================
+    // Start Public Interface
+    //========================
+    typedef ProgramTypes::SetType SetType;
+
+    static const SymbolicExpression& Compile(Kind kind, const std::string& text);
+    SetType Evaluate(ConverterOutput::Output channel = ConverterOutput::ALL) const;
+    //======================
+    // End Public Interface
+    //======================
+
+private:
+    enum Symbol { CONSTANT, FULLLOAD, LOWLINE, NOMINALLINE, HIGHLINE };
+    struct Term {
+        Symbol symbol_;
+        SetType multiplier_;
+        SetType divisor_;
+    };
+
+private:
+    SymbolicExpression();
+    static Term compileTerm(Kind kind, const std::string& text);
+
+private:
+    std::vector<Term> terms_;
+};
+
+#endif // SPTS_SYMBOLIC_EXPRESSION_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
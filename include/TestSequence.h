@@ -7,6 +7,8 @@
 #include "NoCopy.h"
 #include "OperatorInterface.h"
 #include "ProgramTypes.h"
+#include "ResultCache.h"
+#include "SequenceCost.h"
 #include "SingletonType.h"
 #include "StandardFiles.h"
 #include "TestStepDiagnostic.h"
@@ -18,6 +20,22 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+      Replaced the speedSequence_ multimap (keyed on full TestStepInfo copies) with
+        resultCache_, a hashed ResultCache.  Added GetCacheStatistics().
+      Added EstimateSequence() and #include "SequenceCost.h".
+      Replaced checkTestName() and createMeasurement() with measurementID() and
+        getMeasurement().  Added dispatch_, measurementIDs_ and measurements_ -->
+        measurement types are resolved once per Synchronize() and objects are pooled.
+      Added GetSkippedTests(), IsRiskOrdered(), riskOrder(), order_ and riskOrdered_
+        --> optional fail-fast production screening in risk order.  Added
+        dependencies().
+      Added GetSampledOutTests(), failureHistory(), skipLot(), sampledOut_ and a
+        forward declaration of FailureHistory --> optional skip-lot testing of
+        capable, stable steps.
+
   ==============
   11/20/05, sjn,
   ==============
@@ -57,6 +75,10 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 
+
+// Forward declarations
+struct FailureHistory;
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -66,11 +88,16 @@ struct TestSequence : private NoCopy {
     //========================
     // Start Public Interface
     //========================
+    SequenceCost EstimateSequence(const ProgramTypes::SetType& startTemp);
+    std::pair<long, long> GetCacheStatistics() const;
     TestStepDiagnosticFacadeFailure GetPreTestDiagnosticFailure() const;
     std::vector<TestStepDiagnostic> GetPreTestDiagnosticsMeasurements() const;
+    std::vector< std::pair<TestStepInfo, double> > GetSampledOutTests() const;
+    std::vector<TestStepInfo> GetSkippedTests() const;
     std::vector<TestStepInfo> GetTests() const;
     bool HasAnyTests() const;
     bool IsPreTestDiagnosticFailure() const;
+    bool IsRiskOrdered() const;
     void PerformSequence();
     bool SequenceStatus();
     void Synchronize();
@@ -92,21 +119,25 @@ private:
 private:
     // Helpers
     void checkSystemErrors(const std::string& testName = std::string(""));
-    void checkTestName(TestStepInfo::TSPtr tptr);
-    SPTSMeasurement::Measurement* createMeasurement(TestStepInfo::TSPtr tptr);
+    std::vector<std::size_t> dependencies() const;
     void doSequence();
+    FailureHistory* failureHistory(std::string& familyDash, std::string& testType);
     TestStepInfo::CondPtr getCondPointer(TestStepInfo::CondPtr cptr);
+    SPTSMeasurement::Measurement* getMeasurement(long step);
     TestStepInfo::TSPtr getTestPointer(TestStepInfo::TSPtr tptr);
     bool initialize();
+    std::size_t measurementID(TestStepInfo::TSPtr tptr);
     std::string name() const;
     bool nextTest(TestStepInfo::TSPtr tptr, TestStepInfo::CondPtr cptr, 
                   TestStepInfo& currentTest, SPTSMeasurement::Measurement* toMeasure);
     bool nextTest(TestStepInfo::TSPtr tptr, TestStepInfo::CondPtr cptr,
                  TestStepInfo& currentTest, ProgramTypes::MType measuredValue);
+    void riskOrder();
     void setPrecision(const ProgramTypes::PairMType& limits, 
                       ProgramTypes::MType& measured, TestStepInfo& currentTest);
     void setResult(const ProgramTypes::PairMType& limits,
                    const ProgramTypes::MType& measured, TestStepInfo& currentTest);
+    void skipLot(long rate, double minCpk);
     std::pair<bool, ProgramTypes::MType> speedUp(const TestStepInfo& currentTest,
                                             SPTSMeasurement::Measurement* toMeasure);
     ProgramTypes::MType updateSpeedMap(const TestStepInfo& tsi, const ReturnType& r);
@@ -117,15 +148,19 @@ private:
     bool status_;
     bool sync_;
     bool diagnosticFailure_;
+    bool riskOrdered_;
     long testCounter_;
     OperatorInterface* oi_;
     typedef std::vector<TestStepInfo> VecTestInfo;
-    typedef std::map<ConverterOutput::Output, ProgramTypes::MType> TestResults; 
-    typedef std::multimap<TestStepInfo, TestResults> SpeedMapType;
     std::auto_ptr<VecTestInfo> sequence_;
     TestStepDiagnosticFacadeFailure fakeTest_;
     std::vector<TestStepDiagnostic> diagnosticMeasurements_;
-    std::auto_ptr<SpeedMapType> speedSequence_;
+    std::auto_ptr<ResultCache> resultCache_;
+    std::vector<std::size_t> dispatch_; // sequence_ index to measurements_ index
+    std::map<std::string, std::size_t> measurementIDs_;
+    std::vector<SPTSMeasurement::Measurement*> measurements_; // owned
+    std::vector<std::size_t> order_; // sequence_ index to limits file index
+    std::vector< std::pair<TestStepInfo, double> > sampledOut_; // (step, Cpk)
 };
 
 #endif // SPTS_TESTSEQUENCE_H
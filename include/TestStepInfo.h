@@ -16,6 +16,15 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Copies now share one immutable, reference counted Definition holding the test
+       step's conditions, limits and names --> copying a TestStepInfo no longer copies
+       every condition container.  Only the error code, measured value and result
+       are per-copy.  Names are interned so operator== and operator!= compare
+       addresses.  Added Conditions::Hash(), computed once per Definition.
+
    ==============  
    05/05/05, sjn,
    ==============
@@ -88,7 +97,8 @@ private:
     void setResult(bool result);
 
 private:
-    // Forward Declaration 
+    // Forward Declarations 
+    struct Definition;
 	struct TestStepInfoImpl; 
 
 private:
@@ -114,6 +124,7 @@ struct TestStepInfo::Conditions : private NoCopy {
 	FilterSelects::FilterType BW() const;
 	ConverterOutput::Output Channel() const;
 	ProgramTypes::SetType Freq() const;
+    unsigned long Hash() const;
 	const SetTypeContainer& Iouts() const;
 	const SetTypeContainer& IoutsNext() const;
     bool IsInhibited() const;
@@ -138,7 +149,7 @@ struct TestStepInfo::Conditions : private NoCopy {
 
 private:
 	// Implemented
-	explicit Conditions(const TestStepInfoImpl* tsi);
+	explicit Conditions(const Definition* def);
 	~Conditions();
 
 private:
@@ -146,8 +157,8 @@ private:
 	Conditions();
 
 private:
-    friend struct TestStepInfo::TestStepInfoImpl;
-	const TestStepInfo::TestStepInfoImpl* tsi_; 
+    friend struct TestStepInfo::Definition;
+	const TestStepInfo::Definition* def_; 
 };
 
 /***************************************************************************************/
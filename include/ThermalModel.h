@@ -0,0 +1,71 @@
+// Macro Guard
+#ifndef SPTS_THERMAL_MODEL_H
+#define SPTS_THERMAL_MODEL_H
+
+// Files included
+#include "NoCopy.h"
+#include "ProgramTypes.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   First-order thermal model:  dT/dt = (Tfinal - T) / tau
+   Fit from (time, temperature) samples by regressing the observed rate of change
+    against temperature.  The fit tolerates unequal sample spacing, so callers are free
+    to vary their poll interval.  Only the most recent samples are kept so that the
+    model follows changes in plant behavior (loads applied, setpoint changed, etc.).
+   Callers must Clear() the model whenever the driving input (a controller setpoint)
+    is changed since the old asymptote no longer applies.
+*/
+
+struct ThermalModel : private NoCopy {
+    //==================
+    // Public Interface
+    //==================
+    typedef ProgramTypes::MType   MType;
+    typedef ProgramTypes::SetType SetType;
+
+    ThermalModel();
+    ~ThermalModel();
+    void AddSample(const MType& seconds, const MType& temperature);
+    void Clear();
+    MType FinalTemperature() const;
+    bool IsFit() const;
+    std::string Name() const;
+    SetType NextPause(const MType& lowerLimit, const MType& upperLimit,
+                      const SetType& minPause, const SetType& maxPause,
+                      const SetType& defaultPause) const;
+    SetType OvershootSetpoint(const SetType& target, const SetType& current,
+                              const SetType& maxOvershoot, const SetType& minSetpoint,
+                              const SetType& maxSetpoint) const;
+    MType TimeConstant() const;
+    std::pair<bool, MType> TimeToReach(const MType& lowerLimit,
+                                       const MType& upperLimit) const;
+
+private:
+    void fit();
+
+private:
+    typedef std::pair<double, double> Sample; // (seconds, temperature)
+    std::deque<Sample> samples_;
+    bool isFit_;
+    double tau_, final_;
+};
+
+#endif // SPTS_THERMAL_MODEL_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
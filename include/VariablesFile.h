@@ -3,6 +3,7 @@
 #define VARIABLES_FILE_H
 
 // Files included
+#include "ConfigWatcher.h"
 #include "ConverterOutput.h"
 #include "LoadTraits.h"
 #include "ProgramTypes.h"
@@ -15,6 +16,18 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added a typed parameter table (Parameters and OutputParameters), resolved once by
+       Reload().  Per-output Vout, full load, load channel, paralleled loads, line
+       limits, jumper pull flags, load type, aux supplies and misc lines are now
+       answered from the table rather than by string lookups in the file.  Jumper
+       pull tables are read on first use per output and kept until the next Reload().
+     GetJumperPullIout(), GetJumperPullVout(), GetParallelLoads() and MiscLines() now
+       return const references into the table.
+     Added watcher_ --> Reload() keeps the table when nothing it depends on changed.
+
    ==============  
    12/14/04, sjn,
    ==============
@@ -47,6 +60,7 @@ struct VariablesFile : private NoCopy {
     typedef std::map<ProgramTypes::SetType, RLLSet> InnerMap; 
     typedef std::map<ConverterOutput::Output, LoadTraits::Channels> MapDut2Load;
     typedef FileTypes::VariablesFileType::JumperPullTable JumperPullTable;
+    typedef std::pair< bool, std::vector<LoadTraits::Channels> > ParallelLoads;
 
     enum TemperatureOffsetType { COLDOFFSET, HOTOFFSET, ROOMOFFSET };
 
@@ -57,26 +71,25 @@ struct VariablesFile : private NoCopy {
     bool DoDUTSanityChecks();
     std::string Fixture();
     std::vector<LoadTraits::Channels> GetAllLoadsUsed(long numOuts);
-    JumperPullTable GetJumperPullIout(ConverterOutput::Output out) const;
-    JumperPullTable GetJumperPullVout(ConverterOutput::Output out) const;
+    const JumperPullTable& GetJumperPullIout(ConverterOutput::Output out) const;
+    const JumperPullTable& GetJumperPullVout(ConverterOutput::Output out) const;
     std::vector< std::pair<ConverterOutput::Output, LoadTraits::Channels> >
                                                          GetLoadsMap(long numOuts);
     std::pair<bool, ProgramTypes::MType> GetOrientationOhms();
-    std::pair< bool, std::vector<LoadTraits::Channels> > 
-                                  GetParallelLoads(ConverterOutput::Output output);
+    const ParallelLoads& GetParallelLoads(ConverterOutput::Output output) const;
     ProgramTypes::SetType GetTemperature();
     ProgramTypes::SetType GetTemperatureOffset(TemperatureOffsetType type);
     bool IsDeviationTest() const;
     bool IsJumperPullIout() const;
     bool IsJumperPullVout() const;
     std::pair<bool, ProgramTypes::SetType> LoadTransientTransitionTime();
-    LoadTraits::Types LoadType();
-    std::vector<std::string> MiscLines();
+    LoadTraits::Types LoadType() const;
+    const std::vector<std::string>& MiscLines() const;
     std::string NoWirebondPull() const;
-    std::pair<bool, ProgramTypes::SetType> PrimaryAuxSupply();
+    std::pair<bool, ProgramTypes::SetType> PrimaryAuxSupply() const;
     void Reload();
     InnerMap RLoads(ConverterOutput::Output output);
-    std::pair<bool, ProgramTypes::SetType> SecondaryAuxSupply();    
+    std::pair<bool, ProgramTypes::SetType> SecondaryAuxSupply() const;
     std::pair<bool, ProgramTypes::PercentType> TODPercentage();
 	//======================
     // End Public Interface
@@ -89,6 +102,33 @@ private:
     ~VariablesFile();
 
 private:
+    // Per-output parameters, resolved once by Reload()
+    struct OutputParameters {
+        ProgramTypes::MType fullLoad_;
+        LoadTraits::Channels loadChannel_;
+        ParallelLoads paralleled_;
+        ProgramTypes::MType vout_;
+    };
+
+    // Family and dash number parameters, resolved once by Reload()
+    struct Parameters {
+        ProgramTypes::SetType highLine_;
+        bool jumperPullIout_;
+        bool jumperPullVout_;
+        LoadTraits::Types loadType_;
+        ProgramTypes::SetType lowLine_;
+        std::vector<std::string> miscLines_;
+        ProgramTypes::SetType nominalLine_;
+        ConverterOutput::Output outputs_;
+        std::vector<OutputParameters> perOutput_; // [0] --> ConverterOutput::ONE
+        std::pair<bool, ProgramTypes::SetType> primaryAPS_;
+        std::pair<bool, ProgramTypes::SetType> secondaryAPS_;
+    };
+
+    typedef std::map<ConverterOutput::Output, JumperPullTable> JumperPullTables;
+
+private:
+    std::pair<bool, ProgramTypes::SetType> auxSupply(const std::string& str);
     std::string get(const std::string& str);
     ProgramTypes::SetType getHighestIin();
     ProgramTypes::SetType getHighestVin();
@@ -104,6 +144,10 @@ private:
     ProgramTypes::SetType getSyncOffset();  
     ProgramTypes::MTypeContainer getVouts(long numOuts);	
 
+    const OutputParameters& output(ConverterOutput::Output out) const;
+    ParallelLoads parallelLoads(ConverterOutput::Output output);
+    void resolve();
+
     bool isFrequencySplitter();
     bool isGroundedSync();
     bool isPrimaryInhibit();
@@ -118,6 +162,9 @@ private:
     std::auto_ptr<FileTypes::VariablesFileType> vf_;
     bool locked_;
     std::string dash_;
+    Parameters params_;
+    mutable JumperPullTables jumperIout_, jumperVout_;
+    ConfigWatcher watcher_;
 };
 
 #endif // VARIABLES_FILE_H
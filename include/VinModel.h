@@ -0,0 +1,63 @@
+// Macro Guard
+#ifndef SPTS_VIN_MODEL_H
+#define SPTS_VIN_MODEL_H
+
+// Files included
+#include "NoCopy.h"
+#include "ProgramTypes.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Droop model for the main supply plus fixture wiring, as seen at the DUT's input.
+   A DC-DC converter draws roughly constant power, so its input current, and with it
+    the droop through the fixture, goes as 1/Vin: droop = k / Vin.  k is learned per
+    operating state (supply, current limit, loads, inhibit, dropout) from settled DMM
+    readings and is used to pick a corrected supply setpoint up front.  States never
+    seen predict no droop.
+   Readings count as settled only once a window of SETTLEREADINGS of them spans no
+    more than the supply's resolution, so a slowly slewing supply is not mistaken
+    for droop.
+   Callers must Clear() the model whenever the fixture or DUT changes.
+*/
+
+struct VinModel : private NoCopy {
+    //==================
+    // Public Interface
+    //==================
+    typedef ProgramTypes::MType   MType;
+    typedef ProgramTypes::SetType SetType;
+
+    VinModel();
+    ~VinModel();
+    void Clear();
+    bool IsSettled(const std::vector<MType>& readings, 
+                   const SetType& resolution) const;
+    void Learn(const std::string& state, const SetType& setpoint,
+               const MType& measured);
+    std::string Name() const;
+    SetType Setpoint(const std::string& state, const SetType& target,
+                     const SetType& maxCorrection) const;
+
+private:
+    typedef std::map<std::string, double> Droops; // state to k (volts^2)
+    Droops droops_;
+};
+
+#endif // SPTS_VIN_MODEL_H
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
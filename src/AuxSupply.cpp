@@ -37,7 +37,7 @@ AuxSupply::AuxSupply() : locked_(true), address_(-1), lastError_(""),
                          valueMap_(new ValueMap), name_(Name()) {
 
     InstrumentFile::Types type = InstrumentFile::APS;
-    address_ = SingletonType<InstrumentFile>::Instance()->GetAddress(type);
+    address_ = Instrument<BT>::getAddress(type);
     
     typedef SingletonType<InstrumentFile> IF;
     typedef ProgramTypes::SetType ST;  
@@ -83,6 +83,22 @@ AuxSupply::AuxSupply() : locked_(true), address_(-1), lastError_(""),
 AuxSupply::~AuxSupply() 
 { /* */ }
 
+//====================
+// AbortTransaction()
+//====================
+void AuxSupply::AbortTransaction() {
+    Instrument<BT>::abortTransaction();
+    shadow_.Invalidate(); // unknown what got through
+}
+
+//====================
+// BeginTransaction()
+//====================
+void AuxSupply::BeginTransaction() {
+    Assert<InstrumentError>(!locked_, name_);
+    Instrument<BT>::beginTransaction(address_, Language::Concatenate());
+}
+
 //===========
 // command()
 //===========
@@ -91,6 +107,17 @@ bool AuxSupply::command(const std::string& cmd) {
     return(Instrument<BT>::commandInstr(address_, cmd));
 }
 
+//=====================
+// CommitTransaction()
+//=====================
+bool AuxSupply::CommitTransaction() {
+    if ( ! Instrument<BT>::commitTransaction() )
+        return(false);
+    if ( Instrument<BT>::commitSent() && IsError() ) // one check per write
+        throw(InstrumentError(name_ + std::string(": ") + WhatError()));
+    return(true);
+}
+
 //================
 // FindSetRange()
 //================
@@ -107,7 +134,14 @@ bool AuxSupply::FindSetRange(AuxSupplyTraits::Channels chan,
 
     // See if we can do what is needed within current range
     if ( (i->second.first >= volts) && (i->second.second >= amps) ) {        
-        Assert<IE>(SetCurrent(chan, amps) && SetVolts(chan, volts), name_);
+        BeginTransaction();
+        try {
+            Assert<IE>(SetCurrent(chan, amps) && SetVolts(chan, volts), name_);
+        } catch(...) {
+            AbortTransaction();
+            throw;
+        }
+        Assert<IE>(CommitTransaction(), name_);
         return(true);
     }
 
@@ -142,12 +176,19 @@ bool AuxSupply::FindSetRange(AuxSupplyTraits::Channels chan,
         try {     
             i->second.first  = v1;
             i->second.second = i1;   
-            Assert<IE>
-                (
-                    SetVolts(chan, volts) &&
-                    SetCurrent(chan, amps),
-                    name_              
-                );
+            BeginTransaction();
+            try {
+                Assert<IE>
+                    (
+                        SetVolts(chan, volts) &&
+                        SetCurrent(chan, amps),
+                        name_              
+                    );
+            } catch(...) {
+                AbortTransaction();
+                throw;
+            }
+            Assert<IE>(CommitTransaction(), name_);
         } catch(StationBaseException& error) {
             j->second = next;
             i->second.first = tempV;
@@ -201,7 +242,10 @@ ProgramTypes::SetType AuxSupply::GetVolts(AuxSupplyTraits::Channels chan) {
 bool AuxSupply::Initialize() {
     locked_ = false;
     lastError_ = "";
+    shadow_.Invalidate(); // Language::Initialize() resets every output
     try {
+        Instrument<BT>::abortTransaction(); // nothing left over from before
+        BeginTransaction(); // the reset and every output's settings in one write
         Assert<InstrumentError>(command(Language::Initialize()));
         Assert<InstrumentError>(SetCurrent(AuxSupplyTraits::OUTPUT1, 0));
         Assert<InstrumentError>(SetVolts(AuxSupplyTraits::OUTPUT1, 0));
@@ -211,21 +255,33 @@ bool AuxSupply::Initialize() {
         Assert<InstrumentError>(SetVolts(AuxSupplyTraits::OUTPUT3, 0));
         Assert<InstrumentError>(SetCurrent(AuxSupplyTraits::OUTPUT4, 0));
         Assert<InstrumentError>(SetVolts(AuxSupplyTraits::OUTPUT4, 0));
+        Assert<InstrumentError>(CommitTransaction(), name_);
     } catch(StationBaseException& error) {
+        if ( Instrument<BT>::inTransaction() )
+            AbortTransaction();
         locked_ = true;
         throw(error);
     }
     return(true);
 }
 
+//====================
+// InvalidateShadow()
+//====================
+void AuxSupply::InvalidateShadow() {
+    shadow_.Invalidate(); // another instrument's error: state here is suspect too
+}
+
 //===========
 // IsError()
 //===========
 bool AuxSupply::IsError() {
     std::string result = query(Language::IsError());   
     Language::Clean(result);    
-    if ( convert<SetType>(result) != convert<SetType>(Language::NoErrorCode()) ) 
+    if ( convert<SetType>(result) != convert<SetType>(Language::NoErrorCode()) ) {
         lastError_ = result;
+        shadow_.Invalidate(); // supply may no longer be where we left it
+    }
     return(lastError_.empty() ? false : true);
 }
 
@@ -248,7 +304,9 @@ bool AuxSupply::OperationComplete() {
 // OutputOff()
 //=============
 bool AuxSupply::OutputOff(Channel chan) {
-    Assert<InstrumentError>(command(Language::OutputOff(chan)));    
+    std::string cmd = Language::OutputOff(chan);
+    if ( ! shadow_.IsCurrent(std::make_pair(chan, OUTPUT), cmd) )
+        Assert<InstrumentError>(send(std::make_pair(chan, OUTPUT), cmd));    
     return(true);
 }
 
@@ -256,7 +314,9 @@ bool AuxSupply::OutputOff(Channel chan) {
 // OutputOn()
 //============
 bool AuxSupply::OutputOn(Channel chan) {
-    Assert<InstrumentError>(command(Language::OutputOn(chan)));    
+    std::string cmd = Language::OutputOn(chan);
+    if ( ! shadow_.IsCurrent(std::make_pair(chan, OUTPUT), cmd) )
+        Assert<InstrumentError>(send(std::make_pair(chan, OUTPUT), cmd));    
     return(true);
 }
 
@@ -275,6 +335,17 @@ bool AuxSupply::Reset() {
     return(Initialize());
 }
 
+//========
+// send()
+//========
+bool AuxSupply::send(const ShadowKey& key, const std::string& cmd) {
+    shadow_.Invalidate(key); // unknown until the supply takes cmd
+    if ( ! command(cmd) )
+        return(false);
+    shadow_.Update(key, cmd);
+    return(true);
+}
+
 //==============
 // SetCurrent()
 //==============
@@ -284,10 +355,11 @@ bool AuxSupply::SetCurrent(Channel chan, const ProgramTypes::SetType& limit) {
     ValueMap::iterator j = valueMap_->find(chan);
     Assert<BadArg>(i != map_->end(), name);
     Assert<BadArg>(j != valueMap_->end(), name);
-    if ( limit == j->second.second ) // already there
+    std::string cmd = Language::SetIin(chan, limit);
+    if ( shadow_.IsCurrent(std::make_pair(chan, AMPS), cmd) ) // already there
         return(true);
     Assert<OutOfRange>(i->second.second >= limit, name);
-    Assert<InstrumentError>(command(Language::SetIin(chan, limit)), name);
+    Assert<InstrumentError>(send(std::make_pair(chan, AMPS), cmd), name);
     j->second.second = limit; // update valueMap_
     return(true);
 }
@@ -301,15 +373,23 @@ bool AuxSupply::SetVolts(Channel chan, const ProgramTypes::SetType& value) {
     ValueMap::iterator j = valueMap_->find(chan);
     Assert<BadArg>(i != map_->end(), name);
     Assert<BadArg>(j != valueMap_->end(), name);
-    if ( value == j->second.first ) // already there
+    Assert<OutOfRange>(value >= 0, name);
+    std::string cmd = Language::SetVolts(chan, value);
+    if ( shadow_.IsCurrent(std::make_pair(chan, VOLTS), cmd) ) // already there
         return(true);
     Assert<OutOfRange>(i->second.first >= value, name);
-    Assert<OutOfRange>(value >= 0, name);
-    Assert<InstrumentError>(command(Language::SetVolts(chan, value)), name);
+    Assert<InstrumentError>(send(std::make_pair(chan, VOLTS), cmd), name);
     j->second.first = value; // update valueMap_
     return(true);
 }
 
+//======================
+// SuppressedCommands()
+//======================
+long AuxSupply::SuppressedCommands() const {
+    return(shadow_.Suppressed());
+}
+
 //=============
 // WhatError()
 //=============
@@ -0,0 +1,349 @@
+// Files included
+#include "Assertion.h"
+#include "BatchScheduler.h"
+#include "GenericAlgorithms.h"
+#include "SPTSException.h"
+#include "StationFile.h"
+#include "StringAlgorithms.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadCommand BadCommand;
+    typedef StationExceptionTypes::FileError  FileError;
+
+    typedef ProgramTypes::SetType SetType;
+
+    static const std::string dutTag  = "DUT";
+    static const std::string tempTag = "TEMPERATURE";
+    static const std::string policyTag = "POLICY";
+    static const std::string failFastTag = "FAILFAST";
+    static const std::string skipLotTag = "SKIPLOT";
+    static const std::string passTag = "PASS";
+    static const std::string failTag = "FAIL";
+
+    static const double skipLotCpk = 2.0; // default minimum Cpk to skip a step
+
+    struct LessTemperature {
+        bool operator()(const std::pair<std::string, SetType>& a,
+                        const std::pair<std::string, SetType>& b) const {
+            return(a.second < b.second);
+        }
+    };
+
+    std::vector<std::string> tokens(const std::string& line) {
+        std::vector<std::string> toRtn;
+        std::stringstream s(line);
+        std::string next;
+        while ( s >> next )
+            toRtn.push_back(next);
+        return(toRtn);
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+BatchScheduler::BatchScheduler() : failFast_(false), skipLotRate_(0),
+                                   skipLotCpk_(skipLotCpk)
+{ /* */ }
+
+//============
+// Destructor
+//============
+BatchScheduler::~BatchScheduler()
+{ /* */ }
+
+//=========
+// AtEnd()
+//=========
+bool BatchScheduler::AtEnd() const {
+    std::vector<Band>::const_iterator i = bands_.begin();
+    while ( i != bands_.end() ) {
+        std::vector<std::string>::const_iterator j = duts_.begin();
+        while ( j != duts_.end() ) {
+            if ( done_.find(std::make_pair(*j, i->first)) == done_.end() )
+                return(false);
+            ++j;
+        } // while
+        ++i;
+    } // while
+    return(true);
+}
+
+//=========
+// clear()
+//=========
+void BatchScheduler::clear() {
+    workOrder_ = "";
+    stateFile_ = "";
+    bands_.clear();
+    duts_.clear();
+    done_.clear();
+    failFast_ = false;
+    skipLotRate_ = 0;
+    skipLotCpk_ = skipLotCpk;
+}
+
+//============
+// IsActive()
+//============
+bool BatchScheduler::IsActive() const {
+    return(!bands_.empty() && !duts_.empty());
+}
+
+//==============
+// IsFailFast()
+//==============
+bool BatchScheduler::IsFailFast() const {
+    return(IsActive() && failFast_);
+}
+
+//===============
+// IsScheduled()
+//===============
+bool BatchScheduler::IsScheduled(const std::string& serialNumber,
+                                 const std::string& testType) const {
+    // Any DUT still pending in the current band may be run in any order
+    if ( !IsActive() || AtEnd() )
+        return(true);
+    Job next = Next();
+    Key key = std::make_pair(Uppercase(serialNumber), Uppercase(testType));
+    if ( key.second != next.TestType )
+        return(false);
+    if ( std::find(duts_.begin(), duts_.end(), key.first) == duts_.end() )
+        return(false);
+    return(done_.find(key) == done_.end());
+}
+
+//===========
+// loadLot()
+//===========
+void BatchScheduler::loadLot(const std::string& lotFile) {
+    std::ifstream in(lotFile.c_str());
+    Assert<FileError>(in.is_open(), Name(), lotFile);
+    std::string line;
+    while ( std::getline(in, line) ) {
+        std::vector<std::string> v = tokens(line);
+        if ( v.empty() || (v[0][0] == '#') )
+            continue;
+        std::string tag = Uppercase(v[0]);
+        if ( tag == dutTag ) {
+            Assert<FileError>(v.size() == 2, Name(), lotFile);
+            if ( std::find(duts_.begin(), duts_.end(), Uppercase(v[1])) == duts_.end() )
+                duts_.push_back(Uppercase(v[1]));
+        }
+        else if ( tag == tempTag ) {
+            Assert<FileError>(v.size() == 3, Name(), lotFile);
+            Assert<FileError>(IsFloating(v[2]), Name(), lotFile);
+            bands_.push_back(std::make_pair(Uppercase(v[1]),
+                                            SetType(convert<double>(v[2]))));
+        }
+        else if ( tag == policyTag ) {
+            Assert<FileError>(v.size() >= 2, Name(), lotFile);
+            std::string policy = Uppercase(v[1]);
+            if ( policy == failFastTag ) {
+                Assert<FileError>(v.size() == 2, Name(), lotFile);
+                failFast_ = true;
+            }
+            else if ( policy == skipLotTag ) {
+                Assert<FileError>((v.size() == 3) || (v.size() == 4), Name(), lotFile);
+                Assert<FileError>(IsInteger(v[2]), Name(), lotFile);
+                skipLotRate_ = convert<long>(v[2]);
+                Assert<FileError>(skipLotRate_ > 0, Name(), lotFile);
+                if ( v.size() == 4 ) {
+                    Assert<FileError>(IsFloating(v[3]), Name(), lotFile);
+                    skipLotCpk_ = convert<double>(v[3]);
+                    Assert<FileError>(skipLotCpk_ > 0, Name(), lotFile);
+                }
+            }
+            else
+                throw(FileError(Name(), lotFile));
+        }
+        else
+            throw(FileError(Name(), lotFile));
+    } // while
+    Assert<FileError>(IsActive(), Name(), lotFile);
+}
+
+//=============
+// loadState()
+//=============
+void BatchScheduler::loadState(const std::string& stateFile) {
+    std::ifstream in(stateFile.c_str());
+    if ( ! in.is_open() ) // nothing run yet for this lot
+        return;
+    std::string line;
+    while ( std::getline(in, line) ) {
+        std::vector<std::string> v = tokens(line);
+        if ( v.empty() )
+            continue;
+        Assert<FileError>(v.size() == 3, Name(), stateFile);
+        std::string result = Uppercase(v[2]);
+        Assert<FileError>((result == passTag) || (result == failTag),
+                          Name(), stateFile);
+        done_[std::make_pair(Uppercase(v[0]), Uppercase(v[1]))] = (result == passTag);
+    } // while
+}
+
+//========
+// Name()
+//========
+std::string BatchScheduler::Name() {
+    return("Batch Scheduler");
+}
+
+//========
+// Next()
+//========
+BatchScheduler::Job BatchScheduler::Next() const {
+    Assert<BadCommand>(IsActive(), Name());
+    std::vector<Band>::const_iterator i = bands_.begin();
+    while ( i != bands_.end() ) {
+        std::vector<std::string>::const_iterator j = duts_.begin();
+        while ( j != duts_.end() ) {
+            if ( done_.find(std::make_pair(*j, i->first)) == done_.end() ) {
+                Job toRtn;
+                toRtn.SerialNumber = *j;
+                toRtn.TestType = i->first;
+                toRtn.Temperature = i->second;
+                return(toRtn);
+            }
+            ++j;
+        } // while
+        ++i;
+    } // while
+    throw(BadCommand(Name())); // AtEnd()
+}
+
+//==============
+// orderBands()
+//==============
+void BatchScheduler::orderBands(const SetType& currentTemperature) {
+    // Bands lie on a line: visiting the nearer extreme first and then sweeping to
+    //  the other is the least total base plate travel from (currentTemperature).
+    std::stable_sort(bands_.begin(), bands_.end(), LessTemperature());
+    SetType toLow  = absolute(currentTemperature - bands_.front().second);
+    SetType toHigh = absolute(bands_.back().second - currentTemperature);
+    if ( toHigh < toLow )
+        std::reverse(bands_.begin(), bands_.end());
+}
+
+//==========
+// Record()
+//==========
+void BatchScheduler::Record(const std::string& serialNumber,
+                            const std::string& testType, bool passed) {
+    if ( ! IsActive() )
+        return;
+    Key key = std::make_pair(Uppercase(serialNumber), Uppercase(testType));
+    if ( std::find(duts_.begin(), duts_.end(), key.first) == duts_.end() )
+        return; // not part of this lot
+
+    bool found = false;
+    std::vector<Band>::const_iterator i = bands_.begin();
+    while ( i != bands_.end() && !found )
+        found = ((i++)->first == key.second);
+    if ( ! found )
+        return; // not one of this lot's temperature bands
+
+    done_[key] = passed;
+    std::ofstream out(stateFile_.c_str(), std::ios::app);
+    Assert<FileError>(out.is_open(), Name(), stateFile_);
+    out << key.first << " " << key.second << " "
+        << (passed ? passTag : failTag) << std::endl;
+}
+
+//========================
+// RemainingTransitions()
+//========================
+long BatchScheduler::RemainingTransitions() const {
+    // Number of bands with DUTs left to run
+    long toRtn = 0;
+    std::vector<Band>::const_iterator i = bands_.begin();
+    while ( i != bands_.end() ) {
+        std::vector<std::string>::const_iterator j = duts_.begin();
+        while ( j != duts_.end() ) {
+            if ( done_.find(std::make_pair(*j, i->first)) == done_.end() ) {
+                ++toRtn;
+                break;
+            }
+            ++j;
+        } // while
+        ++i;
+    } // while
+    return(toRtn);
+}
+
+//==============
+// SkipLotCpk()
+//==============
+double BatchScheduler::SkipLotCpk() const {
+    return(skipLotCpk_);
+}
+
+//===============
+// SkipLotRate()
+//===============
+long BatchScheduler::SkipLotRate() const {
+    // 0 --> no skip-lot testing
+    return(IsActive() ? skipLotRate_ : 0);
+}
+
+//===============
+// Synchronize()
+//===============
+void BatchScheduler::Synchronize(const std::string& workOrder,
+                                 const SetType& currentTemperature) {
+    std::string wo = RemoveAllWhiteSpace(workOrder);
+    if ( IsActive() && (Uppercase(wo) == workOrder_) )
+        return; // same lot
+
+    clear();
+    if ( wo.empty() )
+        return;
+
+    std::string path;
+    try {
+        path = SingletonType<StationFile>::Instance()->LotPath();
+    } catch(FileError&) {
+        return; // station not set up for lots
+    }
+
+    std::string lotFile = path + wo + ".lot";
+    std::ifstream test(lotFile.c_str());
+    if ( ! test.is_open() ) // no lot for this work order
+        return;
+    test.close();
+
+    try {
+        loadLot(lotFile);
+        stateFile_ = path + wo + ".state";
+        loadState(stateFile_);
+        orderBands(currentTemperature);
+        workOrder_ = Uppercase(wo);
+    } catch(...) {
+        clear();
+        throw;
+    }
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
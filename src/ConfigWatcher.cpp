@@ -0,0 +1,207 @@
+// Files included
+#include <sys/stat.h>
+#include <windows.h>
+#include "ConfigWatcher.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    // FNV-1a
+    const unsigned long FNVBASIS = 2166136261UL;
+    const unsigned long FNVPRIME = 16777619UL;
+
+    // Anything that may mean a file was written, created, removed or renamed
+    const DWORD NOTIFYFILTER = FILE_NOTIFY_CHANGE_FILE_NAME  |
+                               FILE_NOTIFY_CHANGE_LAST_WRITE |
+                               FILE_NOTIFY_CHANGE_SIZE;
+
+    std::string directory(const std::string& path) {
+        std::string::size_type pos = path.find_last_of("\\/");
+        if ( pos == std::string::npos )
+            return(".");
+        return(path.substr(0, pos + 1));
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+ConfigWatcher::ConfigWatcher() : watching_(false)
+{ /* */ }
+
+//============
+// Destructor
+//============
+ConfigWatcher::~ConfigWatcher() {
+    closeNotifications();
+}
+
+//===========
+// Current()
+//===========
+bool ConfigWatcher::Current(const std::string& inputs) {
+    if ( !watching_ || (inputs != inputs_) )
+        return(false);
+    Directories fired, unwatched;
+    if ( quiet(fired, unwatched) )
+        return(true);
+
+    // Skip files in quiet directories.  Read a file when its directory fired, else
+    //  (no notifications) only when a cheap stat() shows its size or time moved.
+    Stamps::iterator i = stamps_.begin();
+    for ( ; i != stamps_.end(); ++i ) {
+        std::string dir = directory(i->first);
+        bool rehash = (fired.find(dir) != fired.end());
+        if ( !rehash && (unwatched.find(dir) == unwatched.end()) )
+            continue;
+        Stamp now = stamp(i->first, false);
+        if ( now.exists_ != i->second.exists_ )
+            return(false);
+        if ( now.exists_ && (rehash || (now.size_ != i->second.size_) ||
+                                       (now.modified_ != i->second.modified_)) ) {
+            now = stamp(i->first, true);
+            if ( now.hash_ != i->second.hash_ )
+                return(false);
+            i->second = now; // touched but not changed
+        }
+    } // for
+    return(true);
+}
+
+//========
+// Name()
+//========
+std::string ConfigWatcher::Name() const {
+    return("Config Watcher");
+}
+
+//=========
+// Reset()
+//=========
+void ConfigWatcher::Reset() {
+    // Next Current() is false --> caller must load and Watch() again
+    closeNotifications();
+    stamps_.clear();
+    inputs_ = "";
+    watching_ = false;
+}
+
+//=========
+// Watch()
+//=========
+void ConfigWatcher::Watch(const std::string& inputs,
+                          const std::vector<std::string>& files) {
+    // Arm notifications before stamping so that no edit falls between the two
+    Reset();
+    std::vector<std::string>::const_iterator i = files.begin();
+    while ( i != files.end() )
+        watchDirectory(*i++);
+    for ( i = files.begin(); i != files.end(); ++i )
+        stamps_[*i] = stamp(*i, true);
+    inputs_ = inputs;
+    watching_ = true;
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//======================
+// closeNotifications()
+//======================
+void ConfigWatcher::closeNotifications() {
+    Notifications::iterator i = notifications_.begin();
+    while ( i != notifications_.end() ) {
+        if ( i->second )
+            FindCloseChangeNotification(static_cast<HANDLE>(i->second));
+        ++i;
+    }
+    notifications_.clear();
+}
+
+//=========
+// quiet()
+//=========
+bool ConfigWatcher::quiet(Directories& fired, Directories& unwatched) {
+    // True only when every watched directory has a notification and none has fired.
+    //  Otherwise (fired) and (unwatched) say which directories' files to look at.
+    Notifications::iterator i = notifications_.begin();
+    while ( i != notifications_.end() ) {
+        HANDLE h = static_cast<HANDLE>(i->second);
+        if ( !h ) // no notifications for this directory --> must stat()
+            unwatched.insert(i->first);
+        else if ( WaitForSingleObject(h, 0) == WAIT_OBJECT_0 ) {
+            fired.insert(i->first);
+            if ( !FindNextChangeNotification(h) ) { // rearm failed
+                FindCloseChangeNotification(h);
+                i->second = 0;
+            }
+        }
+        ++i;
+    } // while
+    return(!notifications_.empty() && fired.empty() && unwatched.empty());
+}
+
+//=========
+// stamp()
+//=========
+ConfigWatcher::Stamp ConfigWatcher::stamp(const std::string& path, bool withHash) {
+    Stamp toRtn;
+    toRtn.exists_ = false;
+    toRtn.size_ = 0;
+    toRtn.modified_ = 0;
+    toRtn.hash_ = FNVBASIS;
+
+    struct _stat info;
+    if ( _stat(path.c_str(), &info) != 0 )
+        return(toRtn);
+    toRtn.exists_ = true;
+    toRtn.size_ = static_cast<long>(info.st_size);
+    toRtn.modified_ = static_cast<long>(info.st_mtime);
+    if ( !withHash )
+        return(toRtn);
+
+    std::ifstream infile(path.c_str(), std::ios::in | std::ios::binary);
+    char buffer[4096];
+    while ( infile ) {
+        infile.read(buffer, sizeof(buffer));
+        std::streamsize got = infile.gcount();
+        for ( std::streamsize idx = 0; idx < got; ++idx ) {
+            toRtn.hash_ ^= static_cast<unsigned char>(buffer[idx]);
+            toRtn.hash_ = (toRtn.hash_ * FNVPRIME) & 0xFFFFFFFFUL;
+        }
+    } // while
+    return(toRtn);
+}
+
+//==================
+// watchDirectory()
+//==================
+void ConfigWatcher::watchDirectory(const std::string& path) {
+    std::string dir = directory(path);
+    if ( notifications_.find(dir) != notifications_.end() )
+        return;
+    HANDLE h = FindFirstChangeNotificationA(dir.c_str(), FALSE, NOTIFYFILTER);
+    notifications_[dir] = (h == INVALID_HANDLE_VALUE) ? 0 : static_cast<void*>(h);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
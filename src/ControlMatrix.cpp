@@ -10,6 +10,14 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     CustomReset() of InputRelayControl, OutputRelayControl and Misc now sends one
+       concatenated command holding only the relays that differ from the custom
+       reset state, rather than one command to open and another to close.  Returns
+       true if anything changed.  Added resetSyntax() helper.
+
    ==============
    05/23/05, sjn,
    ==============
@@ -33,6 +41,30 @@ namespace {
     typedef StationExceptionTypes::ContainerState  ContainerState;
     typedef StationExceptionTypes::InstrumentError InstrumentError;
     typedef StationExceptionTypes::UnexpectedState UnexpectedState;
+
+    // Concatenated syntax to move (known) to (wanted) --> differing relays only
+    template <typename StateMap>
+    std::string resetSyntax(const StateMap& known, const StateMap& wanted, 
+                            StateMap& changes) {
+        typedef ControlMatrixTraits::ModelType::Language Language;
+        std::string syntax;
+        typename StateMap::const_iterator i = wanted.begin();
+        while ( i != wanted.end() ) {
+            typename StateMap::const_iterator find = known.find(i->first);
+            Assert<ContainerState>(find != known.end());
+            if ( find->second != i->second ) { // something to do
+                if ( ! syntax.empty() )
+                    syntax += Language::Concatenate();
+                if ( i->second == ON )
+                    syntax += Language::Close(i->first);
+                else // OFF
+                    syntax += Language::Open(i->first);
+                changes.insert(*i);
+            }
+            ++i;
+        }
+        return(syntax);
+    }
 }
 
 /***************************************************************************************/
@@ -527,19 +559,14 @@ Switch ControlMatrix::InputRelayControl::CurrentState(InputRelay line) {
 // CustomReset()
 //===============
 bool ControlMatrix::InputRelayControl::CustomReset() {
-	RelayContainer toOpen, toClose;
-	RelayStateMap::iterator start = customReset_.begin(), stop = customReset_.end();
-	Assert<ContainerState>(start != stop);
-	while ( start != stop ) {
-		if ( start->second == ON )
-			toClose.push_back(start->first);
-		else // OFF
-            toOpen.push_back(start->first);			
-		++start;
-	}
-    bool result1 = TurnOff(toOpen);
-    bool result2 = TurnOn(toClose);
-    return(result1 && result2);
+	Assert<ContainerState>(!customReset_.empty());
+    RelayStateMap changes;
+    std::string syntax = resetSyntax(knownStates_, customReset_, changes);
+    if ( syntax.empty() ) // already there
+        return(false);
+    Assert<UnexpectedState>(command(syntax), name_);
+    updateStatus(changes);
+    return(true);
 }
 
 //==============
@@ -792,19 +819,14 @@ Switch ControlMatrix::OutputRelayControl::CurrentState(OutputRelay line) {
 // CustomReset()
 //===============
 bool ControlMatrix::OutputRelayControl::CustomReset() {
-	RelayContainer toOpen, toClose;
-	RelayStateMap::iterator start = customReset_.begin(), stop = customReset_.end();
-	Assert<ContainerState>(start != stop);
-	while ( start != stop ) {
-		if ( start->second == ON )			
-            toClose.push_back(start->first);
-		else // OFF
-			toOpen.push_back(start->first);
-		++start;
-	}
-    bool result1 = TurnOff(toOpen);
-    bool result2 = TurnOn(toClose);
-    return(result1 && result2);
+	Assert<ContainerState>(!customReset_.empty());
+    RelayStateMap changes;
+    std::string syntax = resetSyntax(knownStates_, customReset_, changes);
+    if ( syntax.empty() ) // already there
+        return(false);
+    Assert<UnexpectedState>(command(syntax), name_);
+    updateStatus(changes);
+    return(true);
 }
 
 //==============
@@ -1055,20 +1077,14 @@ Switch ControlMatrix::Misc::CurrentState(MiscLine line) {
 // CustomReset()
 //===============
 bool ControlMatrix::Misc::CustomReset() {
-	MiscContainer toOpen, toClose;
-	MiscMap::iterator start = customReset_.begin(), stop = customReset_.end();
-
-	Assert<ContainerState>(start != stop);
-	while ( start != stop ) {
-		if ( start->second == ON )
-            toClose.push_back(start->first);			
-		else // OFF
-			toOpen.push_back(start->first);
-		++start;
-	}
-    bool result1 = TurnOff(toOpen);
-    bool result2 = TurnOn(toClose);
-    return(result1 && result2);
+	Assert<ContainerState>(!customReset_.empty());
+    MiscMap changes;
+    std::string syntax = resetSyntax(knownStates_, customReset_, changes);
+    if ( syntax.empty() ) // already there
+        return(false);
+    Assert<UnexpectedState>(command(syntax), name_);
+    updateStatus(changes);
+    return(true);
 }
 
 //=================
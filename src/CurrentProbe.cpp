@@ -11,6 +11,15 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added queryBatch():  setAppropriateRangeAndCoupling() reads the range and
+       coupling back as one I2C batch.  The probe's settling time still comes
+       between each command and its read, so for this probe the batch is no
+       faster than two queries.  Coupling is read again only if the range had
+       to be toggled.
+
   //===============
   // 03/02/05, sjn,
   //===============
@@ -193,6 +202,16 @@ std::string CurrentProbe::query(const std::string& q) {
     return(result);
 }
 
+//==============
+// queryBatch()
+//==============
+std::vector<std::string> CurrentProbe::queryBatch(const std::vector<std::string>& qs) {
+    Assert<UnexpectedState>(!(locked_ || qs.empty()), Name());
+    wait();
+    lastCommand_ = qs.back();
+    return(Instrument<BT>::queryBatchInstr(address_, qs, waitCalculate()));
+}
+
 //=========
 // Reset()
 //=========  
@@ -206,11 +225,16 @@ bool CurrentProbe::Reset() {
 // setAppropriateRangeAndCoupling()
 //==================================
 void CurrentProbe::setAppropriateRangeAndCoupling() {
-    std::string currentRange = query(Language::ReadRange());
-    if ( !Language::IsAppropriateRange(currentRange) )       
-        Assert<InstrumentError>(command(Language::ToggleRange()), Name());
+    std::vector<std::string> reads;
+    reads.push_back(Language::ReadRange());
+    reads.push_back(Language::ReadCoupling());
+    std::vector<std::string> state = queryBatch(reads);
 
-    std::string currentCoupling = query(Language::ReadCoupling());
+    std::string currentCoupling = state[1];
+    if ( !Language::IsAppropriateRange(state[0]) ) {
+        Assert<InstrumentError>(command(Language::ToggleRange()), Name());
+        currentCoupling = query(Language::ReadCoupling());
+    }
     if ( !Language::IsAppropriateCoupling(currentCoupling) )    
         Assert<InstrumentError>(command(Language::ToggleCoupling()), Name());
 }
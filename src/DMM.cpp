@@ -10,6 +10,21 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added BeginTransaction(), CommitTransaction() and AbortTransaction() --> commands
+       made in between go to the meter as one concatenated write.  A commit that
+       wrote anything is followed by one IsError() check.
+     measure() sends a changed configuration and its READ? as one write, checked
+       once for errors.  OpsComplete() sends its *OPC and the status query as one
+       write --> the reply itself is the check.
+     setModeRange() checks the configure command against a ShadowState<> --> a mode
+       or range change that ends up back where the meter already is no longer resends
+       the configuration.  Initialize(), an error from IsError() and
+       AbortTransaction() invalidate it.
+     Added InvalidateShadow() and SuppressedCommands().
+
    ==============
    05/23/05, sjn,
    ==============
@@ -61,6 +76,22 @@ DMM::DMM() : locked_(true), configuration_(DCV), rangeDCV_(AUTO), rangeOhm_(AUTO
 DMM::~DMM() 
 { /* */ }
 
+//====================
+// AbortTransaction()
+//====================
+void DMM::AbortTransaction() {
+    Instrument<BusType>::abortTransaction();
+    shadow_.Invalidate(); // unknown what got through
+}
+
+//====================
+// BeginTransaction()
+//====================
+void DMM::BeginTransaction() {
+    Assert<InstrumentError>(!locked_, name_);
+    Instrument<BusType>::beginTransaction(address_, Language::Concatenate());
+}
+
 //==============
 // bitprocess() 
 //==============
@@ -113,17 +144,30 @@ bool DMM::command(const std::string& cmd) {
     return(Instrument<BusType>::commandInstr(address_, cmd));
 }
 
+//=====================
+// CommitTransaction()
+//=====================
+bool DMM::CommitTransaction() {
+    if ( ! Instrument<BusType>::commitTransaction() )
+        return(false);
+    if ( Instrument<BusType>::commitSent() && IsError() ) // one check per write
+        throw(InstrumentError(name_ + std::string(": ") + WhatError()));
+    return(true);
+}
+
 //==============
 // Initialize() 
 //==============
 bool DMM::Initialize() {
     locked_ = false;    
     try {
+        Instrument<BusType>::abortTransaction(); // nothing left over from before
         Assert<InstrumentError>(command(Language::Initialize()), name_);    
         rangeDCV_  = AUTO; 
         rangeOhm_  = AUTO; 
         rangeoC_   = AUTO; 
         needReset_ = true;
+        shadow_.Invalidate();
         configuration_ = OHMS;
         SetMode(DCV);            
     } catch(StationBaseException& error) {
@@ -133,11 +177,21 @@ bool DMM::Initialize() {
     return(true);
 }
 
+//====================
+// InvalidateShadow()
+//====================
+void DMM::InvalidateShadow() {
+    shadow_.Invalidate(); // another instrument's error: state here is suspect too
+}
+
 //===========
 // IsError() 
 //===========
 bool DMM::IsError() {
-    return(bitprocess(query(Language::IsError()), Instrument<BusType>::ERROR)); 
+    bool toRtn = bitprocess(query(Language::IsError()), Instrument<BusType>::ERROR);
+    if ( toRtn ) // meter may no longer be configured as we left it
+        shadow_.Invalidate();
+    return(toRtn);
 }
 
 //===========
@@ -145,9 +199,22 @@ bool DMM::IsError() {
 //===========
 ProgramTypes::MType DMM::measure(Mode nextMode) {
     Assert<UnexpectedState>(configuration_ == nextMode, name_);
-    if ( needReset_ )
-        setModeRange();    
-    std::string result = query(Language::Measure());
+    if ( ! needReset_ )
+        return(convert<ProgramTypes::MType>(query(Language::Measure())));
+
+    // New configuration and the reading in one write
+    std::string result;
+    BeginTransaction();
+    try {
+        setModeRange();
+        result = query(Language::Measure());
+        Assert<InstrumentError>(CommitTransaction(), name_);
+    } catch(...) {
+        if ( Instrument<BusType>::inTransaction() )
+            Instrument<BusType>::abortTransaction();
+        shadow_.Invalidate(); // unknown what got through
+        throw;
+    }
     return(convert<ProgramTypes::MType>(result));
 }
 
@@ -183,8 +250,18 @@ std::string DMM::Name() {
 // OpsComplete() 
 //===============
 bool DMM::OpsComplete() {
-    Assert<InstrumentError>(command(Language::SetOpsComplete()), name_);
-	return(bitprocess(query(Language::IsDone()), Instrument<BusType>::OPSCOMPLETE));
+    // *OPC and its status query in one write --> no error check, the reply is it
+    Instrument<BusType>::beginTransaction(address_, Language::Concatenate());
+    std::string done;
+    try {
+        Assert<InstrumentError>(command(Language::SetOpsComplete()), name_);
+        done = query(Language::IsDone());
+    } catch(...) {
+        Instrument<BusType>::abortTransaction();
+        throw;
+    }
+    Instrument<BusType>::commitTransaction();
+	return(bitprocess(done, Instrument<BusType>::OPSCOMPLETE));
 }
 
 //=========
@@ -217,25 +294,22 @@ void DMM::SetMode(Mode mode) {
 // setModeRange()
 //================
 void DMM::setModeRange() {
+    std::string cmd;
     switch(configuration_) {
         case OHMS:
-            Assert<InstrumentError>(command(
-                Language::ConfigureOhms(Model::OHMSRELAYCHANNEL, rangeOhm_)),
-                name_
-                                   );            
+            cmd = Language::ConfigureOhms(Model::OHMSRELAYCHANNEL, rangeOhm_);
             break; 
         case DCV:
-            Assert<InstrumentError>(command(
-                Language::ConfigureDCVolts(Model::DCVOLTAGERELAYCHANNEL, rangeDCV_)),
-                name_
-                                   );                       
+            cmd = Language::ConfigureDCVolts(Model::DCVOLTAGERELAYCHANNEL, rangeDCV_);
             break;
         case TEMP:
-            Assert<InstrumentError>(command(
-                Language::ConfigureTemperature(Model::TEMPERATURERELAYCHANNEL)), 
-                name_
-                                   );
+            cmd = Language::ConfigureTemperature(Model::TEMPERATURERELAYCHANNEL);
     };
+    if ( !shadow_.IsCurrent(CONFIGURE, cmd) ) { 
+        shadow_.Invalidate(CONFIGURE);
+        Assert<InstrumentError>(command(cmd), name_);
+        shadow_.Update(CONFIGURE, cmd);
+    }
     needReset_ = false;
 }
 
@@ -273,6 +347,13 @@ void DMM::SetRange(const ProgramTypes::SetType& range) {
                        //  --> ensure range is set appropriately  
 }
 
+//======================
+// SuppressedCommands()
+//======================
+long DMM::SuppressedCommands() const {
+    return(shadow_.Suppressed());
+}
+
 //=============
 // WhatError()
 //=============
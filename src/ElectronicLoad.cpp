@@ -9,6 +9,13 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Concatenate() now opens and commits an Instrument<> transaction in place of
+       totalSyntax_.  The queued syntax is still sent whole, as one command, with
+       one bus status check, and is followed by one IsError() check.
+
    ==============
    05/23/05, sjn,
    ==============
@@ -613,7 +620,6 @@ ElectronicLoad::ElectronicLoad()
 	  concatenate_(false),
 	  locked_(true),
 	  syntax_(""),
-	  totalSyntax_(""),
 	  lastError_(""),
 	  address_(-1),
       name_(Name()) { 
@@ -690,23 +696,9 @@ bool ElectronicLoad::bitprocess(const std::string& errorString,
 //===========
 bool ElectronicLoad::command() {
 	Assert<UnexpectedState>(!locked_, name_);
-	if ( ! syntax_.empty() ) {
-		if ( ! totalSyntax_.empty() ) {
-			totalSyntax_ += Language::Concatenate();
-			totalSyntax_ += syntax_;
-		}
-		else
-			totalSyntax_ = syntax_;
-	}
-
-	bool result = false;
-	if ( concatenate_ ) // Store syntax for later use
-		result = true;
-	else { // Talk to instrument
-		result = (totalSyntax_.size()) ? 
-                          Instrument<BT>::commandInstr(address_, totalSyntax_) : true;
-		totalSyntax_ = "";
-	}
+	bool result = true;
+	if ( ! syntax_.empty() ) // queued while concatenating
+		result = Instrument<BT>::commandInstr(address_, syntax_);
 	syntax_ = "";
 	return(result);
 }
@@ -719,8 +711,15 @@ void ElectronicLoad::Concatenate(Switch state) {
 		case OFF:
 			concatenate_ = false;
 			Assert<UnexpectedState>(command(), name_);
+			if ( Instrument<BT>::inTransaction() ) {
+				Assert<UnexpectedState>(Instrument<BT>::commitTransaction(), name_);
+				if ( Instrument<BT>::commitSent() && IsError() ) // one check per write
+					throw(InstrumentError(name_ + std::string(": ") + WhatError()));
+			}
 			break;
 		default: // ON
+			if ( ! concatenate_ )
+				Instrument<BT>::beginTransaction(address_, Language::Concatenate());
 			concatenate_ = true;
 	}; // Switch
 }
@@ -758,7 +757,7 @@ LoadTraits::Modes ElectronicLoad::GetMode(LoadTraits::Channels chan) {
 void ElectronicLoad::ImmediateMode() {
     concatenate_ = false;
     syntax_      = "";
-    totalSyntax_ = "";
+    Instrument<BT>::abortTransaction();
 }
 
 //==============
@@ -770,7 +769,7 @@ bool ElectronicLoad::Initialize() {
 	locked_ = false;
 	concatenate_ = false;
 	syntax_ = "";
-	totalSyntax_ = "";
+	Instrument<BT>::abortTransaction();
 
     try {
 	    Concatenate(ON);
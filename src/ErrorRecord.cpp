@@ -0,0 +1,143 @@
+// Files included
+#include "ErrorRecord.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    const std::string MARKER = "SPTR";
+    const unsigned char VERSION = 1;
+
+    // Longest string accepted by Read() --> a damaged file cannot ask for gigabytes
+    const unsigned long MAXLENGTH = 1048576;
+
+    void putLong(std::ostream& os, unsigned long value) {
+        for ( int idx = 0; idx < 4; ++idx )
+            os.put(static_cast<char>((value >> (8 * idx)) & 0xFF));
+    }
+
+    void putString(std::ostream& os, const std::string& s) {
+        putLong(os, static_cast<unsigned long>(s.size()));
+        os.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    bool getLong(std::istream& is, unsigned long& value) {
+        value = 0;
+        for ( int idx = 0; idx < 4; ++idx ) {
+            int c = is.get();
+            if ( c == std::char_traits<char>::eof() )
+                return(false);
+            value |= static_cast<unsigned long>(c & 0xFF) << (8 * idx);
+        }
+        return(true);
+    }
+
+    bool getString(std::istream& is, std::string& s) {
+        unsigned long size = 0;
+        if ( !getLong(is, size) || (size > MAXLENGTH) )
+            return(false);
+        s.assign(static_cast<std::string::size_type>(size), ' ');
+        if ( size > 0 )
+            is.read(&s[0], static_cast<std::streamsize>(size));
+        return((size == 0) || (static_cast<unsigned long>(is.gcount()) == size));
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=======================
+// Constructor Overload1
+//=======================
+ErrorRecord::ErrorRecord() : Level(INFO), Timestamp(0)
+{ /* */ }
+
+//=======================
+// Constructor Overload2
+//=======================
+ErrorRecord::ErrorRecord(Severity severity, const std::string& instrument,
+                         const std::string& step, const std::string& message)
+    : Instrument(instrument), Message(message), Level(severity), Step(step),
+      Timestamp(static_cast<unsigned long>(std::time(0)))
+{ /* */ }
+
+//========
+// Name()
+//========
+std::string ErrorRecord::Name(Severity severity) {
+    switch(severity) {
+        case INFO:
+            return("INFO");
+        case WARNING:
+            return("WARNING");
+        case FAULT:
+            return("FAULT");
+        default: // FATAL
+            return("FATAL");
+    };
+}
+
+//========
+// Read()
+//========
+bool ErrorRecord::Read(std::istream& is, ErrorRecord& record) {
+    // False at end of file or at the first record that does not decode
+    char marker[4];
+    is.read(marker, sizeof(marker));
+    if ( (is.gcount() != sizeof(marker)) ||
+         (std::string(marker, sizeof(marker)) != MARKER) )
+        return(false);
+    int version = is.get();
+    int severity = is.get();
+    if ( (version != VERSION) || (severity < INFO) || (severity > FATAL) )
+        return(false);
+    record.Level = static_cast<Severity>(severity);
+    return(getLong(is, record.Timestamp) && getString(is, record.Instrument) &&
+           getString(is, record.Step) && getString(is, record.Message));
+}
+
+//=========
+// Write()
+//=========
+void ErrorRecord::Write(std::ostream& os, const ErrorRecord& record) {
+    os.write(MARKER.data(), static_cast<std::streamsize>(MARKER.size()));
+    os.put(static_cast<char>(VERSION));
+    os.put(static_cast<char>(record.Level));
+    putLong(os, record.Timestamp);
+    putString(os, record.Instrument);
+    putString(os, record.Step);
+    putString(os, record.Message);
+}
+
+//=====================
+// insertion operator
+//=====================
+std::ostream& operator<<(std::ostream& os, const ErrorRecord& record) {
+    // One line:  date time, severity, instrument, step, message --> tab separated
+    std::time_t t = static_cast<std::time_t>(record.Timestamp);
+    char when[32] = "";
+    std::tm* local = std::localtime(&t);
+    if ( local )
+        std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", local);
+    std::string message = record.Message;
+    std::replace(message.begin(), message.end(), '\n', ' ');
+    os << when << "\t" << ErrorRecord::Name(record.Level) << "\t"
+       << record.Instrument << "\t" << record.Step << "\t" << message;
+    return(os);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
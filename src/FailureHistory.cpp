@@ -0,0 +1,292 @@
+// Files included
+#include "FailureHistory.h"
+#include "StringAlgorithms.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    const char DELIMITER = ','; // per DataArchive
+    const std::string FAILED = "F";
+
+    // Header prefixes of production runs, as DataArchive writes them
+    const char* PRODUCTION[] = { "", "RM", "DEV", "DEVRM" };
+    const std::size_t NUMPRODUCTION = sizeof(PRODUCTION) / sizeof(PRODUCTION[0]);
+
+    // Measurement::BadMeasurement (9.99E37) and the like are not values
+    const double LARGESTVALID = 1E37;
+
+    // Minimum fields in a header and in a test step line
+    const std::size_t HEADERFIELDS = 4;
+    const std::size_t STEPFIELDS = 8;
+
+    std::vector<std::string> fields(const std::string& line) {
+        // Empty fields are kept --> positions are fixed by DataArchive
+        std::vector<std::string> toRtn;
+        std::string::size_type size = line.size();
+        if ( (size > 0) && (line[size-1] == '\r') ) // archive written in text mode
+            --size;
+        std::string::size_type start = 0, end = 0;
+        while ( (end = line.find(DELIMITER, start)) < size ) {
+            toRtn.push_back(line.substr(start, end - start));
+            start = end + 1;
+        }
+        toRtn.push_back(line.substr(start, size - start));
+        std::vector<std::string>::iterator i = toRtn.begin();
+        while ( i != toRtn.end() )
+            RemoveFrontBackSpace(*i++);
+        return(toRtn);
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+FailureHistory::FailureHistory() : offset_(0)
+{ /* */ }
+
+//============
+// Destructor
+//============
+FailureHistory::~FailureHistory()
+{ /* */ }
+
+//=================
+// GetCapability()
+//=================
+FailureHistory::Capability
+         FailureHistory::GetCapability(const std::string& familyDash,
+                                       const std::string& testType,
+                                       const std::string& testName) const {
+    Capability toRtn;
+    toRtn.Samples = 0;
+    toRtn.Mean = 0;
+    toRtn.Sigma = 0;
+    toRtn.RecentSamples = 0;
+    toRtn.RecentMean = 0;
+    toRtn.RecentFailure = false;
+    toRtn.SinceLastRun = 0;
+
+    // Production headers only --> exact match
+    Key key = std::make_pair(Uppercase(familyDash), Uppercase(testType));
+    History::const_iterator h = history_.find(key);
+    if ( h == history_.end() )
+        return(toRtn);
+    std::map<std::string, Counts>::const_iterator c;
+    c = h->second.counts_.find(Uppercase(testName));
+    if ( c == h->second.counts_.end() )
+        return(toRtn);
+
+    const Counts& counts = c->second;
+    toRtn.Samples = counts.samples_;
+    toRtn.Mean = counts.mean_;
+    if ( counts.samples_ > 1 )
+        toRtn.Sigma = std::sqrt(counts.m2_ / (counts.samples_ - 1));
+    toRtn.RecentSamples = static_cast<long>(counts.recentValues_.size());
+    if ( toRtn.RecentSamples > 0 ) {
+        toRtn.RecentMean = std::accumulate(counts.recentValues_.begin(),
+                                           counts.recentValues_.end(), 0.0);
+        toRtn.RecentMean /= toRtn.RecentSamples;
+    }
+    toRtn.RecentFailure = std::find(counts.recentPassed_.begin(),
+                                    counts.recentPassed_.end(), false)
+                                                      != counts.recentPassed_.end();
+    toRtn.SinceLastRun = h->second.sequences_ - counts.lastSequence_;
+    return(toRtn);
+}
+
+//===============
+// FailureRate()
+//===============
+double FailureHistory::FailureRate(const std::string& familyDash,
+                                   const std::string& testType,
+                                   const std::string& testName) const {
+    // Fraction of archived runs of (testName) that failed; 0 if never run
+    std::string type = Uppercase(testType), test = Uppercase(testName);
+    long runs = 0, failures = 0;
+    History::const_iterator i = history_.begin();
+    while ( i != history_.end() ) {
+        if ( (i->first.second == type) && matches(i->first.first, familyDash) ) {
+            std::map<std::string, Counts>::const_iterator c;
+            c = i->second.counts_.find(test);
+            if ( c != i->second.counts_.end() ) {
+                runs += c->second.runs_;
+                failures += c->second.failures_;
+            }
+        }
+        ++i;
+    } // while
+    if ( 0 == runs )
+        return(0);
+    return(static_cast<double>(failures) / runs);
+}
+
+//========
+// Name()
+//========
+std::string FailureHistory::Name() const {
+    return("Failure History");
+}
+
+//===================
+// NumberSequences()
+//===================
+long FailureHistory::NumberSequences(const std::string& familyDash,
+                                     const std::string& testType) const {
+    std::string type = Uppercase(testType);
+    long toRtn = 0;
+    History::const_iterator i = history_.begin();
+    while ( i != history_.end() ) {
+        if ( (i->first.second == type) && matches(i->first.first, familyDash) )
+            toRtn += i->second.sequences_;
+        ++i;
+    }
+    return(toRtn);
+}
+
+//===============
+// Synchronize()
+//===============
+void FailureHistory::Synchronize(const std::string& archive) {
+    if ( archive != archive_ ) {
+        reset();
+        archive_ = archive;
+    }
+
+    std::ifstream in(archive.c_str(), std::ios::in | std::ios::binary);
+    if ( !in ) // nothing archived yet
+        return;
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    if ( size < offset_ ) { // archive was replaced --> start over
+        reset();
+        archive_ = archive;
+    }
+    if ( size <= offset_ )
+        return;
+
+    std::string text(static_cast<std::string::size_type>(size - offset_), ' ');
+    in.seekg(offset_);
+    in.read(&text[0], static_cast<std::streamsize>(text.size()));
+    text.resize(static_cast<std::string::size_type>(in.gcount()));
+
+    std::string::size_type start = 0, end = 0;
+    while ( (end = text.find('\n', start)) != std::string::npos ) {
+        parse(text.substr(start, end - start));
+        start = end + 1;
+    }
+    offset_ += start; // a partial last line is read again next time
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//===========
+// matches()
+//===========
+bool FailureHistory::matches(const std::string& header, const std::string& familyDash) {
+    // (header) is uppercase:  <production prefix><family>-<dash>
+    std::string key = Uppercase(familyDash);
+    if ( key.empty() || (header.size() < key.size()) )
+        return(false);
+    std::string::size_type prefix = header.size() - key.size();
+    if ( header.compare(prefix, key.size(), key) != 0 )
+        return(false);
+    for ( std::size_t idx = 0; idx < NUMPRODUCTION; ++idx ) {
+        if ( header.substr(0, prefix) == PRODUCTION[idx] )
+            return(true);
+    }
+    return(false);
+}
+
+//=========
+// parse()
+//=========
+void FailureHistory::parse(const std::string& line) {
+    std::vector<std::string> f = fields(line);
+    if ( f.size() < 2 )
+        return;
+
+    if ( !IsInteger(f[0]) ) { // header --> a new archived sequence
+        current_ = Key();
+        if ( f.size() < HEADERFIELDS )
+            return;
+        current_ = std::make_pair(Uppercase(f[0]), Uppercase(f[3]));
+        History::iterator h = history_.find(current_);
+        if ( h == history_.end() ) {
+            Steps toAdd;
+            toAdd.sequences_ = 0;
+            h = history_.insert(std::make_pair(current_, toAdd)).first;
+        }
+        ++h->second.sequences_;
+        return;
+    }
+
+    if ( current_.first.empty() || (f.size() < STEPFIELDS) )
+        return;
+    Steps& steps = history_[current_];
+    Counts& c = steps.counts_[Uppercase(f[1])];
+    bool passed = (Uppercase(f[7]) != FAILED);
+    ++c.runs_;
+    if ( !passed )
+        ++c.failures_;
+    c.lastSequence_ = steps.sequences_;
+    c.recentPassed_.push_back(passed);
+    if ( c.recentPassed_.size() > RECENT )
+        c.recentPassed_.pop_front();
+
+    char* end = 0;
+    double value = std::strtod(f[4].c_str(), &end);
+    if ( f[4].empty() || (*end != '\0') || (std::fabs(value) >= LARGESTVALID) )
+        return; // no valid measured value
+    double delta = value - c.mean_; // Welford --> no cancellation on large values
+    ++c.samples_;
+    c.mean_ += delta / c.samples_;
+    c.m2_ += delta * (value - c.mean_);
+    c.recentValues_.push_back(value);
+    if ( c.recentValues_.size() > RECENT )
+        c.recentValues_.pop_front();
+}
+
+//=========
+// reset()
+//=========
+void FailureHistory::reset() {
+    archive_ = "";
+    current_ = Key();
+    history_.clear();
+    offset_ = 0;
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//====================
+// Counts Constructor
+//====================
+FailureHistory::Counts::Counts() : runs_(0), failures_(0), lastSequence_(0),
+                                   samples_(0), mean_(0), m2_(0)
+{ /* */ }
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -10,6 +10,17 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     The public constructor now reads the whole file with one read() and hands it to
+       parse(), which builds the tree in a single pass with an explicit stack of
+       open nodes instead of one recursive constructor call per block.  Lines are
+       trimmed by pointer and become strings once.  Parse errors and results are
+       unchanged.  Children built before a parse error are now deleted.
+     Each node keeps key_, its normalized header, so GetFileNode() normalizes only
+       its argument and find() compares keys.
+
    ==============  
    07/27/04, sjn,
    ==============
@@ -75,79 +86,42 @@ const std::string FileNode::endOfHeader = "]";
 // Constructor Overload1
 //========================
 FileNode::FileNode(std::ifstream& ifile) {
-    bool first = true;
-    bool done  = false;
     if ( !ifile )
         throw(NoFileFound(name()));
-    while ( ifile ) {
-        std::string buffer;
-        std::getline(ifile, buffer);
-        RemoveFrontBackSpace(buffer);
-        RemoveTabs(buffer);
-        if ( buffer.empty() ) continue;
-        if ( isEqualFirst(startHeader, buffer) ) {
-            if ( first ) {
-                header_ = Uppercase(buffer);
-                first = false;
-            }
-            else 
-                children_.push_back(new FileNode(ifile, buffer));            
-        }
-        else if ( isEqualFirst(stopHeader, buffer) ) {
-            footer_ = Uppercase(buffer);
-            done = true;
-            break;
-        }     
-        else {
-            if ( first ) {
-                ifile.close();
-                throw(FileFormatError(name()));
-            }
-            info_.push_back(buffer);        
-        } // if-else
-    } // while
+
+    // One read of the rest of the file --> text mode may shrink it (CR-LF)
+    std::streampos start = ifile.tellg();
+    ifile.seekg(0, std::ios::end);
+    std::streamoff size = ifile.tellg() - start;
+    ifile.seekg(start);
+    std::vector<char> contents(size > 0 ? static_cast<std::size_t>(size) : 0);
+    if ( !contents.empty() ) {
+        ifile.read(&contents[0], static_cast<std::streamsize>(contents.size()));
+        contents.resize(static_cast<std::size_t>(ifile.gcount()));
+    }
     ifile.close();
-    if ( (!done) && first )
-        throw(NoFileFound(name()));
-    if ( !done )
-        throw(FileFormatError(name()));
-    if ( !matchedHeaderFooter(header_, footer_) )
-        throw(FileFormatError(name()));       
+
+    try {
+        const char* begin = contents.empty() ? 0 : &contents[0];
+        parse(begin, begin + contents.size());
+    } catch(...) {
+        for ( std::size_t idx = 0; idx < children_.size(); ++idx )
+            delete(children_[idx]);
+        throw;
+    }
 }
 
 //=================================
 // Constructor Overload2 - private
 //=================================
-FileNode::FileNode(std::ifstream& ifile, const std::string& head) {
-    bool done = false;
-    header_ = Uppercase(head);
-    while ( ifile ) {
-        std::string buffer;
-        std::getline(ifile, buffer);
-        RemoveFrontBackSpace(buffer);
-        RemoveTabs(buffer);
-        if ( buffer.empty() ) continue;
-        if ( isEqualFirst(stopHeader, buffer) ) {
-            footer_ = Uppercase(buffer);
-            done = true;
-            break;
-        }
-        else if ( isEqualFirst(startHeader, buffer) ) 
-            children_.push_back(new FileNode(ifile, buffer));
-        else 
-            info_.push_back(buffer);        
-    } // while
-    if ( !done )
-        throw(FileFormatError(name()));
-    if ( !matchedHeaderFooter(header_, footer_) )
-        throw(FileFormatError(name()));     
-}
+FileNode::FileNode()
+{ /* */ }
 
 //=================================
 // Constructor Overload3 - private
 //=================================
 FileNode::FileNode(const std::string& head) {
-    header_ = startHeader + Uppercase(head) + endOfHeader;
+    setHeader(startHeader + Uppercase(head) + endOfHeader);
     footer_ = stopHeader + Uppercase(head) + endOfHeader;
 }
 
@@ -170,6 +144,21 @@ FileNode* FileNode::AddFileNode(const std::string& header) {
     return(children_.back());
 }
 
+//========
+// find()
+//========
+FileNode* FileNode::find(const std::string& key) {
+    // Depth first, parents before children
+    if ( key_ == key )
+        return(this);
+    for ( std::size_t idx = 0; idx < children_.size(); ++idx ) {
+        FileNode* fn = children_[idx]->find(key);
+        if ( fn ) 
+            return(fn);
+    }
+    return(0);
+}
+
 //==============
 // FooterTags()
 //==============
@@ -189,19 +178,7 @@ std::vector<FileNode*>& FileNode::GetChildNodes() {
 // GetFileNode()
 //===============
 FileNode* FileNode::GetFileNode(const std::string& header) {
-    std::string h = Uppercase(RemoveAllWhiteSpace(header));
-    if ( Uppercase(RemoveAllWhiteSpace(header_)) == h )
-        return(this);
-    for ( std::size_t idx = 0; idx < children_.size(); ++idx ) {
-        if ( Uppercase(RemoveAllWhiteSpace(children_[idx]->header_)) == h )
-            return(children_[idx]);
-        else {
-            FileNode* fn = children_[idx]->GetFileNode(h);
-            if ( fn ) 
-                return(fn);
-        }
-    }
-    return(0);
+    return(find(Uppercase(RemoveAllWhiteSpace(header))));
 }
 
 //=============
@@ -240,6 +217,73 @@ std::string FileNode::name() {
     return("FileNode Class");
 }
 
+//=========
+// parse()
+//=========
+void FileNode::parse(const char* begin, const char* end) {
+    // Blank lines are skipped.  Anything before the first header is an error, as is
+    //  a footer that does not match the innermost open header.  Whatever follows
+    //  the final footer is ignored.
+    std::vector<FileNode*> open;
+    bool first = true;
+    bool done = false;
+    const char* next = begin;
+    while ( next != end ) {
+        const char* lineStart = next;
+        const char* lineEnd = std::find(next, end, '\n');
+        next = (lineEnd == end) ? end : lineEnd + 1;
+
+        // Same trimming as RemoveFrontBackSpace() and then RemoveTabs()
+        while ( (lineStart != lineEnd) && (*lineStart == ' ') )
+            ++lineStart;
+        while ( (lineEnd != lineStart) && (*(lineEnd - 1) == ' ') )
+            --lineEnd;
+        if ( lineStart == lineEnd ) 
+            continue;
+        std::string buffer(lineStart, lineEnd);
+        if ( std::find(lineStart, lineEnd, '\t') != lineEnd )
+            RemoveTabs(buffer);
+        if ( buffer.empty() ) 
+            continue;
+
+        if ( isEqualFirst(startHeader, buffer) ) {
+            if ( first ) {
+                setHeader(Uppercase(buffer));
+                open.push_back(this);
+                first = false;
+            }
+            else {
+                FileNode* child = new FileNode;
+                open.back()->children_.push_back(child);
+                child->setHeader(Uppercase(buffer));
+                open.push_back(child);
+            }
+        }
+        else if ( isEqualFirst(stopHeader, buffer) ) {
+            if ( first )
+                throw(FileFormatError(name()));
+            FileNode* closed = open.back();
+            closed->footer_ = Uppercase(buffer);
+            if ( !matchedHeaderFooter(closed->header_, closed->footer_) )
+                throw(FileFormatError(name()));
+            open.pop_back();
+            if ( open.empty() ) {
+                done = true;
+                break;
+            }
+        }     
+        else {
+            if ( first )
+                throw(FileFormatError(name()));
+            open.back()->info_.push_back(buffer);        
+        } // if-else
+    } // while
+    if ( (!done) && first )
+        throw(NoFileFound(name()));
+    if ( !done )
+        throw(FileFormatError(name()));
+}
+
 //===============
 // ReplaceInfo()
 //===============
@@ -247,6 +291,14 @@ void FileNode::ReplaceInfo(const std::vector<std::string>& newInfo) {
     info_ = newInfo;
 }
 
+//=============
+// setHeader()
+//=============
+void FileNode::setHeader(const std::string& header) {
+    header_ = header;
+    key_ = Uppercase(RemoveAllWhiteSpace(header_));
+}
+
 //========
 // Size()
 //========
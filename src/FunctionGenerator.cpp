@@ -10,6 +10,20 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Constructor gets its address through Instrument<>::getAddress() so that the GPIB
+       board and secondary address in the instrument file are used.
+     Added BeginTransaction(), CommitTransaction() and AbortTransaction() --> settings
+       made in between go to the generator as one concatenated command.  A commit
+       that wrote anything is followed by one IsError() check.
+     Settings are checked against a ShadowState<> rather than ampl_, dc_, freq_,
+       offset_ and isOff_.  Initialize() now invalidates it instead of assuming
+       zeroes, so a setting equal to the old cached value is still sent after a
+       reset.  An error from IsError() and AbortTransaction() also invalidate it.
+     Added InvalidateShadow() and SuppressedCommands().
+
    ==============
    06/23/05, sjn,
    ==============
@@ -60,10 +74,10 @@ namespace SPTSInstrument {
 // Constructor
 //=============
 FunctionGenerator::FunctionGenerator() 
-  : ampl_(0), dc_(0), freq_(0), offset_(0), locked_(true), isOff_(false) {
+  : locked_(true) {
                                
     IF* ptr = SingletonType<IF>::Instance();
-    address_ = ptr->GetAddress(IF::FUNCTIONGENERATOR);
+    address_ = Instrument<BT>::getAddress(IF::FUNCTIONGENERATOR);
 
     typedef FunctionGeneratorTraits::FunctionGeneratorFactoryType FF;
     std::set<std::string> possibilities = FF::Instance()->GetAllRegistered();
@@ -101,6 +115,22 @@ FunctionGenerator::FunctionGenerator()
 FunctionGenerator::~FunctionGenerator()
 { /* */ }
 
+//====================
+// AbortTransaction()
+//====================
+void FunctionGenerator::AbortTransaction() {
+    abortTransaction();
+    shadow_.Invalidate(); // unknown what got through
+}
+
+//====================
+// BeginTransaction()
+//====================
+void FunctionGenerator::BeginTransaction() {
+    Assert<UnexpectedState>(!locked_, Name());
+    beginTransaction(address_, fg_->Concatenate());
+}
+
 //==============
 // bitprocess() 
 //==============
@@ -152,24 +182,43 @@ bool FunctionGenerator::command(const std::string& cmd) {
     return(commandInstr(address_, cmd));
 }
 
+//=====================
+// CommitTransaction()
+//=====================
+bool FunctionGenerator::CommitTransaction() {
+    if ( ! commitTransaction() )
+        return(false);
+    if ( commitSent() && IsError() ) // one check for the whole write
+        throw(InstrumentError(Name() + std::string(": ") + WhatError()));
+    return(true);
+}
+
 //==============
 // Initialize()
 //==============
 bool FunctionGenerator::Initialize() {
-    ampl_   = static_cast<SetType>(0);
-    dc_     = static_cast<PercentType>(0);
-    freq_   = static_cast<SetType>(0);
-    offset_ = static_cast<SetType>(0);
     locked_ = false;
+    shadow_.Invalidate();
+    abortTransaction(); // nothing left over from before
     return(command(fg_->Initialize()));  
 }
 
+//====================
+// InvalidateShadow()
+//====================
+void FunctionGenerator::InvalidateShadow() {
+    shadow_.Invalidate(); // another instrument's error: state here is suspect too
+}
+
 //===========
 // IsError()
 //===========
 bool FunctionGenerator::IsError() {
 	std::string syntax = fg_->IsError();
-	return(bitprocess(query(syntax), Instrument<BT>::ERROR)); 
+	bool toRtn = bitprocess(query(syntax), Instrument<BT>::ERROR);
+    if ( toRtn ) // generator may no longer be where we left it
+        shadow_.Invalidate();
+    return(toRtn);
 }
 
 //========
@@ -192,14 +241,16 @@ bool FunctionGenerator::OpsComplete() {
 // OutputOff()
 //=============
 void FunctionGenerator::OutputOff() {
-    if ( isOff_ )
+    std::string cmd = fg_->OutputOff();
+    if ( shadow_.IsCurrent(OUTPUT, cmd) )
         return;
-    Assert<UnexpectedState>(command(fg_->OutputOff()), Name());
-    ampl_   = static_cast<SetType>(0);
-    dc_     = static_cast<PercentType>(0);
-    freq_   = static_cast<SetType>(0);
-    offset_ = static_cast<SetType>(0);
-    isOff_  = true;
+    send(OUTPUT, cmd);
+
+    // Turning off may change the other settings on some models --> resend them
+    shadow_.Invalidate(AMPLITUDE);
+    shadow_.Invalidate(DUTYCYCLE);
+    shadow_.Invalidate(FREQUENCY);
+    shadow_.Invalidate(OFFSET);
 }
 
 //=========
@@ -217,61 +268,70 @@ bool FunctionGenerator::Reset() {
 	return(Initialize());
 }
 
+//========
+// send()
+//========
+void FunctionGenerator::send(Setting key, const std::string& cmd) {
+    shadow_.Invalidate(key); // unknown until the generator takes cmd
+    Assert<UnexpectedState>(command(cmd), Name());
+    shadow_.Update(key, cmd);
+    if ( key != OUTPUT ) // any setting turns the output back on
+        shadow_.Invalidate(OUTPUT);
+}
+
 //================
 // SetAmplitude()
 //================
 void FunctionGenerator::SetAmplitude(const ProgramTypes::SetType& value) {
-    if ( ampl_ == value ) return; // already there
+    std::string cmd = fg_->SetAmplitude(convert<std::string>(value));
+    if ( shadow_.IsCurrent(AMPLITUDE, cmd) ) return; // already there
     IF* iptr = SingletonType<IF>::Instance();
     Assert<BadArg>(value <= static_cast<SetType>(iptr->MaxAmplitude()), Name());
-    typedef UnexpectedState US;
-    Assert<US>(command(fg_->SetAmplitude(convert<std::string>(value))), Name());
-    ampl_ = value;
-    isOff_ = false;
+    send(AMPLITUDE, cmd);
 }
 
 //================
 // SetDutyCycle()
 //================
 void FunctionGenerator::SetDutyCycle(const ProgramTypes::PercentType& percent) {
-    if ( dc_ == percent ) return; // already there
+    std::string cmd = fg_->SetDutyCycle(convert<std::string>(percent));
+    if ( shadow_.IsCurrent(DUTYCYCLE, cmd) ) return; // already there
     IF* iptr = SingletonType<IF>::Instance();
     PercentType min = static_cast<PercentType>(iptr->MinDutyCycle());
     PercentType max = static_cast<PercentType>(iptr->MaxDutyCycle());
     Assert<BadArg>((percent <= max) && (percent >= min), Name());    
-    typedef UnexpectedState US;
-    Assert<US>(command(fg_->SetDutyCycle(convert<std::string>(percent))), Name());
-    dc_ = percent;
-    isOff_ = false;
+    send(DUTYCYCLE, cmd);
 }
 
 //================
 // SetFrequency()
 //================
 void FunctionGenerator::SetFrequency(const ProgramTypes::SetType& value) {
-    if ( freq_ == value ) return; // already there
-    IF* iptr = SingletonType<IF>::Instance();
-    Assert<BadArg>(value <= static_cast<SetType>(iptr->MaxFrequency()), Name());
-    typedef UnexpectedState US;
     std::string cmd = fg_->SetSquareWave();
     cmd += fg_->Concatenate();
     cmd += fg_->SetFrequency(convert<std::string>(value));
-    Assert<US>(command(cmd), Name());
-    freq_ = value;
-    isOff_ = false;
+    if ( shadow_.IsCurrent(FREQUENCY, cmd) ) return; // already there
+    IF* iptr = SingletonType<IF>::Instance();
+    Assert<BadArg>(value <= static_cast<SetType>(iptr->MaxFrequency()), Name());
+    send(FREQUENCY, cmd);
 }
 
 //=============
 // SetOffset()
 //=============
 void FunctionGenerator::SetOffset(const ProgramTypes::SetType& value) {
-    if ( offset_ == value ) return; // already there
+    std::string cmd = fg_->SetOffset(convert<std::string>(value));
+    if ( shadow_.IsCurrent(OFFSET, cmd) ) return; // already there
     IF* iptr = SingletonType<IF>::Instance();
     Assert<BadArg>(value <= static_cast<SetType>(iptr->MaxOffset()), Name());
-    typedef UnexpectedState US;
-    Assert<US>(command(fg_->SetOffset(convert<std::string>(value))), Name()); 
-    offset_ = value;
-    isOff_ = false;
+    send(OFFSET, cmd); 
+}
+
+//======================
+// SuppressedCommands()
+//======================
+long FunctionGenerator::SuppressedCommands() const {
+    return(shadow_.Suppressed());
 }
 
 //=============
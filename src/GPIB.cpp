@@ -13,6 +13,29 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================  
+   10/19/26, agent,
+   ================
+     Replaced the fixed 100 character read in query() with read(), which reads in
+       chunks until EOI into the address' reusable buffer.  Added queryBlock() to
+       parse IEEE 488.2 binary blocks in place.  talk() writes from a reusable
+       per-address buffer rather than a 1000 character stack copy, removing the
+       command length limit.  Device creation moved to device().
+     Added open() --> lets Instrument<> open handles at instrument construction.
+     Multiple GPIB boards: open() takes a board index, primary address and optional
+       secondary address and returns the key used for that device from then on.
+       device() decodes the key for ibdev().  Error messages name devices with
+       addressName() --> board:primary[:secondary] when not simply on board 0.
+     Per-board dispatch:  talk() starts an asynchronous write (ibwrta()) and returns
+       without waiting for it.  Each board carries one transfer at a time, so the
+       next talk() or read() on that board first calls finish() --> ibwait() for
+       the write and check its errors against the device written.  Boards do not
+       wait on one another:  writes to instruments on different boards overlap.
+       Only the bus transfer is overlapped:  an instrument still acts on a command
+       after its transfer completes, as before, so pauses after commands keep
+       their meaning to within the transfer time.  The destructor finishes every
+       board before taking devices offline.
+
    ==============  
    03/03/05, sjn,
    ==============
@@ -35,6 +58,20 @@
 namespace {
     typedef StationExceptionTypes::BusError        BusError;
     typedef StationExceptionTypes::UnexpectedState UnexpectedState;
+
+    // Bytes requested per ibrd() call
+    const long CHUNKSIZE = 1024;
+
+    // Largest response accepted --> guards against a talker that never sends EOI
+    const long MAXRESPONSE = 16L * 1024L * 1024L;
+
+    // Device keys: primary + KEYBASE * (secondary + 1, or 0 if none)
+    //                      + KEYBASE * KEYBASE * board
+    const long KEYBASE = 32;
+    const long MAXBOARD = KEYBASE - 1;
+
+    // NI-488.2 secondary addresses are 0x60 + (0 to 30)
+    const int SECONDARYBASE = 0x60;
 }
 
 /***************************************************************************************/
@@ -47,20 +84,118 @@ namespace SPTSInstrument {
 //=============
 // Constructor
 //=============
-GPIB::GPIB() : map_(new MapType)
+GPIB::GPIB() : map_(new MapType), pending_(new PendingType)
 { /* */ }
 
 //============
 // Destructor
 //============
 GPIB::~GPIB() { 
+    while ( !pending_->empty() ) { // finish() drops the board before any throw
+        try {
+            finish(pending_->begin()->first);
+        } catch(...) { /* going offline regardless */ }
+    } // while
+
     MapType::iterator beg = map_->begin(), end = map_->end();
     while ( beg != end ) {
-        ibonl(beg->second, 0);   /* Take the device offline */	        
+        ibonl(beg->second.Handle, 0);   /* Take the device offline */	        
         ++beg;
     }    
 }
 
+//===============
+// addressName()
+//===============
+std::string GPIB::addressName(long key) const {
+    long primary = key % KEYBASE;
+    long secondary = (key / KEYBASE) % KEYBASE;
+    long board = key / (KEYBASE * KEYBASE);
+    if ( (0 == board) && (0 == secondary) )
+        return(convert<std::string>(primary));
+    std::string toRtn = convert<std::string>(board) + ":" + 
+                        convert<std::string>(primary);
+    if ( secondary != 0 )
+        toRtn += ":" + convert<std::string>(secondary - 1);
+    return(toRtn);
+}
+
+//===========
+// boardOf()
+//===========
+long GPIB::boardOf(long key) const {
+    return(key / (KEYBASE * KEYBASE));
+}
+
+//==============
+// checkError()
+//==============
+void GPIB::checkError(long address) {
+    if ( isError() ) {
+        std::string error = whatError();
+        Assert<BusError>(error.empty(), name() + " " + error + " address: " 
+                         + addressName(address));
+    }
+}
+
+//==========
+// device()
+//==========
+GPIB::Device& GPIB::device(long address) {
+    MapType::iterator found = map_->find(address);
+    if ( found == map_->end() ) {
+        long primary = address % KEYBASE;
+        long secondary = (address / KEYBASE) % KEYBASE;
+        long board = boardOf(address);
+        finish(board); // one transfer at a time per board, ibclr() included
+
+        // Create a Device
+	    // copied from NI sample software
+	    int  Device = ibdev(        /* Create a unit descriptor handle         */
+            static_cast<int>(board),/* Board Index (GPIB0 = 0, GPIB1 = 1, ...) */
+            static_cast<int>(primary), /* Device primary address               */
+            (secondary == 0) ? 0 :  /* Device secondary address                */
+                 SECONDARYBASE + static_cast<int>(secondary - 1),
+            T10s,                   /* Timeout setting (T10s = 10 seconds)     */
+            1,                      /* Assert EOI line at end of write         */
+            0);   
+
+        Assert<BusError>(Device != -1, name() + " Address:" +
+                         addressName(address) + " ibdev");
+        ibclr(Device);
+
+        GPIB::Device dev;
+        dev.Handle = Device;
+        std::pair<MapType::iterator, bool> p;
+        p = map_->insert(std::make_pair(address, dev));
+        Assert<UnexpectedState>(p.second, name());
+        found = p.first;
+    }
+    return(found->second);
+}
+
+//==========
+// finish()
+//==========
+void GPIB::finish(long board) {
+    // Wait out the write in flight on board, if any
+    PendingType::iterator found = pending_->find(board);
+    if ( found == pending_->end() )
+        return;
+    long address = found->second;
+    pending_->erase(found);
+
+    Device& dev = device(address);
+    ibwait(dev.Handle, TIMO | CMPL);
+    if ( 0 == (ibsta & CMPL) ) { // timed out --> abandon the write
+        ibstop(dev.Handle);
+        throw(BusError(name() + " TIMO write not completed, address: " + 
+              addressName(address))
+             );
+    }
+    checkError(address);
+}
+
 //===========
 // isError()
 //===========
@@ -82,6 +217,24 @@ std::string GPIB::name() const {
     return("GPIB");
 }
 
+//========
+// open()
+//========
+long GPIB::open(long board, long primary, const std::pair<bool, long>& secondary) {
+    std::string where = name() + " board: " + convert<std::string>(board) + 
+                        " address: " + convert<std::string>(primary);
+    Assert<BusError>((board >= 0) && (board <= MAXBOARD), where);
+    Assert<BusError>((primary >= 0) && (primary <= maxAddress()), where);
+    long key = primary + (KEYBASE * KEYBASE * board);
+    if ( secondary.first ) {
+        Assert<BusError>((secondary.second >= 0) && (secondary.second <= maxAddress()),
+                         where);
+        key += KEYBASE * (secondary.second + 1);
+    }
+    device(key);
+    return(key);
+}
+
 //=========
 // query()
 //=========
@@ -92,97 +245,107 @@ std::string GPIB::query(long address, const std::string& command,
 		talk(address, command);
         Pause(pauseAfterCommand);
     }
+    Device& dev = device(address);
+    long size = read(address, dev);
+	return(std::string(&dev.ReadBuffer[0], size));
+}
 
-	const static long maxSize = 100;
-
-    MapType::iterator found = map_->find(address);
-    if ( found == map_->end() ) {
-        // Create a Device
-	    // copied from NI sample software
-	    int  Device = ibdev(        /* Create a unit descriptor handle         */
-            0,                      /* Board Index (GPIB0 = 0, GPIB1 = 1, ...) */
-            address,                /* Device primary address                  */
-            0,				        /* Device secondary address                */
-            T10s,                   /* Timeout setting (T10s = 10 seconds)     */
-            1,                      /* Assert EOI line at end of write         */
-            0);   
-
-        Assert<BusError>(Device != -1, name() + " Address:" +
-                         convert<std::string>(address) + " ibdev");
-        ibclr(Device);
-
-        std::pair<MapType::iterator, bool> p;
-        p = map_->insert(std::make_pair(address, Device));
-        Assert<UnexpectedState>(p.second, name());
-        found = p.first;
-    }   
-
-    char Buffer[maxSize+1];
-    try {	    
-	    ibrd(found->second, Buffer, maxSize);  
-    } catch(...) {
-        throw(BusError(name() +
-              " address: " + 
-              convert<std::string>(found->first))
-             );
-    }
-    if ( isError() ) {
-        std::string error = whatError();
-        Assert<BusError>(error.empty(), name() + " " + error + " address: " 
-                         + convert<std::string>(found->first));
+//==============
+// queryBlock()
+//==============
+BusBlock GPIB::queryBlock(long address, const std::string& command) {
+    // IEEE 488.2 block: #<n><n digits: length><data> or #0<data><NL^END>
+	if ( !command.empty() )
+		talk(address, command);
+    Device& dev = device(address);
+    long size = read(address, dev);
+    const char* data = &dev.ReadBuffer[0];
+    std::string badBlock = name() + " bad binary block, address: " + 
+                           addressName(address);
+    Assert<BusError>((size >= 2) && (data[0] == '#'), badBlock);
+    Assert<BusError>((data[1] >= '0') && (data[1] <= '9'), badBlock);
+
+    long digits = data[1] - '0';
+    BusBlock toRtn;
+    if ( 0 == digits ) { // indefinite length --> runs to the terminator
+        toRtn.Data = data + 2;
+        toRtn.Size = size - 2;
+        if ( (toRtn.Size > 0) && (toRtn.Data[toRtn.Size-1] == '\n') )
+            --toRtn.Size;
+        return(toRtn);
     }
 
-	Buffer[ibcntl] = '\0';   
-	return(std::string(Buffer));
+    Assert<BusError>(size >= 2 + digits, badBlock);
+    long length = 0;
+    for ( long idx = 0; idx < digits; ++idx ) {
+        char c = data[2 + idx];
+        Assert<BusError>((c >= '0') && (c <= '9'), badBlock);
+        length = (length * 10) + (c - '0');
+    } // for
+    Assert<BusError>(2 + digits + length <= size, badBlock);
+    toRtn.Data = data + 2 + digits;
+    toRtn.Size = length;
+    return(toRtn);
+}
+
+//========
+// read()
+//========
+long GPIB::read(long address, Device& dev) {
+    // Chunked reads until the talker asserts EOI
+    finish(boardOf(address));
+    long total = 0;
+    while ( true ) {
+        std::size_t needed = static_cast<std::size_t>(total + CHUNKSIZE + 1);
+        if ( dev.ReadBuffer.size() < needed ) {
+            Assert<BusError>(total + CHUNKSIZE <= MAXRESPONSE, name() + 
+                             " response too large, address: " +
+                             addressName(address));
+            dev.ReadBuffer.resize(std::max(needed, 2 * dev.ReadBuffer.size()));
+        }
+
+        try {	    
+	        ibrd(dev.Handle, static_cast<void*>(&dev.ReadBuffer[total]), CHUNKSIZE);
+        } catch(...) {
+            throw(BusError(name() +
+                  " address: " + 
+                  addressName(address))
+                 );
+        }
+        checkError(address);
+        total += ibcntl;
+        if ( (ibsta & END) || (0 == ibcntl) )
+            break;
+    } // while
+    dev.ReadBuffer[total] = '\0';
+    return(total);
 }
 
 //========
 // talk()
 //========
 void GPIB::talk(long address, const std::string& command) {
-	MapType::iterator found = map_->find(address);
-    if ( found == map_->end() ) {
-        // Create a Device
-	    // copied from NI sample software
-	    int  Device = ibdev(        /* Create a unit descriptor handle         */
-            0,                      /* Board Index (GPIB0 = 0, GPIB1 = 1, ...) */
-            address,                /* Device primary address                  */
-            0,				        /* Device secondary address                */
-            T10s,                   /* Timeout setting (T10s = 10 seconds)     */
-            1,                      /* Assert EOI line at end of write         */
-            0);   
-
-        Assert<BusError>(Device != -1, name() + " Address:" +
-                         convert<std::string>(address) + " ibdev");
-        ibclr(Device);
-
-        std::pair<MapType::iterator, bool> p;
-        p = map_->insert(std::make_pair(address, Device));
-        Assert<UnexpectedState>(p.second, name());
-        found = p.first;
-    } 
-
+    // Start the write and return --> finish() completes it
+    Device& dev = device(address);
+    long board = boardOf(address);
+    finish(board);
     try {
-        static const int MAX = 1000;
-        char cpy[MAX];
-        Assert<UnexpectedState>(MAX > command.length(), name());
-        long i = 0, sz = static_cast<long>(command.size());
-        for ( ; i < sz; ++i )
-            cpy[i] = command[i];
-        cpy[i] = '\0';
-
-	    ibwrt(found->second, static_cast<void*>(cpy), sz);
+        std::size_t sz = command.size();
+        if ( dev.WriteBuffer.size() < sz + 1 )
+            dev.WriteBuffer.resize(sz + 1);
+        std::copy(command.begin(), command.end(), dev.WriteBuffer.begin());
+        dev.WriteBuffer[sz] = '\0';
+
+	    ibwrta(dev.Handle, static_cast<void*>(&dev.WriteBuffer[0]), 
+               static_cast<long>(sz));
     } catch(...) {
         throw(BusError(name() +
               " address: " + 
-              convert<std::string>(found->first))
+              addressName(address))
              );
     }
-    if ( isError() ) {
-        std::string error = whatError();
-        Assert<BusError>(error.empty(), name() + " " + error + " address: "
-                         + convert<std::string>(found->first));
-    }
+    checkError(address);
+    pending_->insert(std::make_pair(board, address));
 }
 
 //=============
@@ -6,8 +6,37 @@
 #include "Functions.h"
 #include "GenericAlgorithms.h"
 #include "I2C.h"
+#include "Instrument.h"
+#include "InstrumentFile.h"
+#include "SingletonType.h"
 #include "SPTSException.h"
 
+//=====================================================================================//
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
+//=====================================================================================//
+/*
+   ================
+   10/19/26, agent,
+   ================
+     Bitrate is per slave: Instrument<I2C>::getAddress() reads the optional "I2C
+       Bitrate" (kHz) entry into setBitrate(), and selectBitrate() reprograms the
+       adapter only when the slave changes rate.
+       Slaves without an entry stay at the old fixed 6kHz.
+     query() reads the query register with a single write-then-read transaction
+       (repeated start) in readRegister().  Any pause now comes after the command
+       and before that transaction, rather than with the bus held between the
+       register select and the read.
+     Added queryBatch() --> a queue of commands, each followed by its register
+       read, at one bitrate selection.  toWait is the slave's own settling time
+       between a command and its read; slaves needing none run back to back.
+     Removed the noStop_, setQueryReg_ and numBytes_ flags that query() used to
+       steer talk(), along with the 1000 byte stack buffers: write() and
+       readRegister() use reusable member buffers.
+*/
+//=====================================================================================//
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
+//=====================================================================================//
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -15,7 +44,15 @@
 
 namespace {
     typedef StationExceptionTypes::BusError        BusError;
+    typedef StationExceptionTypes::FileError       FileError;
     typedef StationExceptionTypes::UnexpectedState UnexpectedState;
+
+    // Bus speeds in kHz --> slaves not configured otherwise run at DEFAULTBITRATE
+    const long DEFAULTBITRATE = 6;
+    const long MAXBITRATE = 800; // Aardvark limit
+
+    // Bytes clocked out of the query register --> only the first is meaningful
+    const long READBYTES = 2;
 }
 
 /***************************************************************************************/
@@ -24,12 +61,8 @@ namespace {
 /***************************************************************************************/
 
 // The current implementation of this class is very specific to the Aardvark
-//  USB-2-I2C adapter.  It is further limited to having only one possible slave
-//  currently as it is very unlikely that multiple instruments in the station would
-//  ever communicate via I2C.  If it does become necessary, this implementation will
-//  need to be extended.  See GPIB.h/GPIB.cpp for an example.
-//  portNumber_, commandReg_ and queryReg_ are all hardcoded below for this
-//  hardware-specific implementation.
+//  USB-2-I2C adapter.  portNumber_, commandReg_ and queryReg_ are all hardcoded
+//  below for this hardware-specific implementation.
 
 // We use typedef's defined in Aardvark.h: aa_u08 and aa_u16
 
@@ -40,8 +73,9 @@ namespace SPTSInstrument {
 //=============
 I2C::I2C() : portNumber_(0),
              commandReg_(static_cast<char>(static_cast<short>(0x37))),
-             queryReg_(static_cast<char>(static_cast<short>(0x36))), noStop_(false),
-             numBytes_(2), bytesRead_(0), queryBytes_(1), setQueryReg_(false) {
+             queryReg_(static_cast<char>(static_cast<short>(0x36))),
+             bitrate_(DEFAULTBITRATE), bitrates_(new BitrateMap),
+             readBuffer_(READBYTES) {
 
     handle_ = aa_open(portNumber_);
     if ( handle_ <= 0 ) {
@@ -54,7 +88,7 @@ I2C::I2C() : portNumber_(0),
     aa_configure(handle_, AA_CONFIG_SPI_I2C);
     aa_i2c_pullup(handle_, AA_I2C_PULLUP_BOTH);
     aa_target_power(handle_, AA_TARGET_POWER_BOTH);
-    aa_i2c_bitrate(handle_, 6); // 6kHz
+    aa_i2c_bitrate(handle_, static_cast<int>(bitrate_));
     aa_i2c_free_bus(handle_);
 }
 
@@ -87,97 +121,134 @@ std::string I2C::name() const {
     return("I2C");
 }
 
+//========
+// open()
+//========
+long I2C::open(long board, long primary, const std::pair<bool, long>& secondary) {
+    // One adapter, opened by the constructor --> no boards or secondary addresses
+    Assert<BusError>((0 == board) && !secondary.first, name());
+    return(primary);
+}
+
 //=========
 // query()
 //=========
 std::string I2C::query(long address, const std::string& command, double toWait) {
-	if ( !command.empty() )
+	if ( !command.empty() ) {
 		talk(address, command);
-     
-    int keep = numBytes_;
-    try {
-        noStop_ = true;
-        setQueryReg_ = true;
-        char tmp = static_cast<char>(queryReg_);
-        std::string str;
-        str += tmp;   
-        numBytes_ = 1;
-        talk(address, str);
         Pause(toWait); // pause between talk and query for toWait
-        noStop_ = false;
-        setQueryReg_ = false;
-        numBytes_ = keep;
-    } catch(...) {
-        numBytes_ = keep;
-        noStop_ = false;
-        setQueryReg_ = false;
-        aa_i2c_free_bus(handle_);
-        throw;
     }
+    return(readRegister(address));
+}
 
-	const static long maxSize = 1000;
-    aa_u08 buffer[maxSize+1];
-    char toRtn[maxSize + 1];
-    aa_u16 numRead;
+//==============
+// queryBatch()
+//==============
+std::vector<std::string> I2C::queryBatch(long address,
+                                         const std::vector<std::string>& commands,
+                                         double toWait) {
+    std::vector<std::string> toRtn;
+    toRtn.reserve(commands.size());
+    std::vector<std::string>::const_iterator i = commands.begin();
+    while ( i != commands.end() ) {
+        talk(address, *i++);
+        Pause(toWait); // the slave's settling time --> none if zero
+        toRtn.push_back(readRegister(address));
+    } // while
+    return(toRtn);
+}
+
+//================
+// readRegister()
+//================
+std::string I2C::readRegister(long address) {
+    // Select the query register and read it back in one transaction: no stop
+    //  after the write --> the read goes out with a repeated start
+    write(address, std::string(1, queryReg_), false);
+    aa_u16 numRead = 0;
+    int status = AA_OK;
     try {
-	    aa_i2c_read_ext(handle_, static_cast<aa_u16>(address),
-                        AA_I2C_NO_FLAGS, static_cast<aa_u16>(numBytes_),
-                        buffer, &numRead);
-        bytesRead_ = numRead;
-        Assert<BusError>(numRead > 0, "I2C Bus Query Error", command);
+	    status = aa_i2c_read_ext(handle_, static_cast<aa_u16>(address),
+                                 AA_I2C_NO_FLAGS, static_cast<aa_u16>(READBYTES),
+                                 &readBuffer_[0], &numRead);
     } catch(...) {
+        aa_i2c_free_bus(handle_);
         throw(BusError(name() +
               " address: " + 
               convert<std::string>(address))
              );
     }
+    if ( (status != AA_OK) || (0 == numRead) ) {
+        aa_i2c_free_bus(handle_);
+        whatError_ = "Bus Query Error: " + convert<std::string>(status);
+    }
     Assert<BusError>(!isError(),
                      name() + " " + whatError() + 
                      " talking to address: " + convert<std::string>(address));
-    numRead = 1; // no read we will ever do goes beyond 0x05
-	buffer[numRead] = '\0';
-    
-    // convert from aa_u08 to char
-    aa_u16 i = 0;
-    for ( ; i < numRead; ++i )
-        toRtn[i] = static_cast<char>(buffer[i]);
-    toRtn[i] = '\0';
-    return(std::string(toRtn));
+
+    // no read we will ever do goes beyond 0x05; a zero byte reads as empty
+    if ( 0 == readBuffer_[0] )
+        return("");
+    return(std::string(1, static_cast<char>(readBuffer_[0])));
+}
+
+//=================
+// selectBitrate()
+//=================
+void I2C::selectBitrate(long address) {
+    BitrateMap::const_iterator found = bitrates_->find(address);
+    long rate = (found == bitrates_->end()) ? DEFAULTBITRATE : found->second;
+    if ( rate == bitrate_ )
+        return;
+    int actual = aa_i2c_bitrate(handle_, static_cast<int>(rate));
+    if ( actual <= 0 )
+        whatError_ = "Unable to set bitrate " + convert<std::string>(rate) + 
+                     "kHz Error Code: " + convert<std::string>(actual);
+    Assert<BusError>(!isError(), name() + " " + whatError() + " address: " +
+                     convert<std::string>(address));
+    bitrate_ = rate;
+}
+
+//==============
+// setBitrate()
+//==============
+void I2C::setBitrate(long address, long kHz) {
+    Assert<FileError>((kHz > 0) && (kHz <= MAXBITRATE), 
+                      name() + " bitrate", convert<std::string>(kHz));
+    (*bitrates_)[address] = kHz;
 }
 
 //========
 // talk()
 //========
 void I2C::talk(long address, const std::string& command) {
+    write(address, std::string(1, commandReg_) + command, true);
+}
+
+//=========
+// write()
+//=========
+void I2C::write(long address, const std::string& bytes, bool stop) {
+    selectBitrate(address);
+    writeBuffer_.assign(bytes.begin(), bytes.end());
+    aa_u16 numWrite = 0;
+    int status = AA_OK;
     try {
-        std::string tmp;
-        if ( !setQueryReg_ ) {
-            char hex = static_cast<char>(commandReg_);
-            tmp += hex;
-        }
-        tmp += command;
-        static const int MAX = 1000;
-        aa_u08 cpy[MAX];
-        Assert<UnexpectedState>(MAX > tmp.length(), name());
-        std::size_t i = 0;
-        for ( ; i < tmp.size(); ++i )
-            cpy[i] = tmp[i];
-        cpy[i] = '\0';
-        AA_I2C_FLAGS flag = AA_I2C_NO_FLAGS;
-        if ( noStop_ )
-            flag = AA_I2C_NO_STOP;
-        aa_u16 numWrite = 0;
-	    aa_i2c_write_ext(handle_, static_cast<aa_u16>(address),
-                         flag, static_cast<aa_u16>(numBytes_),
-                         cpy, &numWrite);
-        if ( numWrite <= 0 )
-            whatError_ = "Bus Command Error: ";
+	    status = aa_i2c_write_ext(handle_, static_cast<aa_u16>(address),
+                                  stop ? AA_I2C_NO_FLAGS : AA_I2C_NO_STOP, 
+                                  static_cast<aa_u16>(writeBuffer_.size()),
+                                  &writeBuffer_[0], &numWrite);
     } catch(...) {
+        aa_i2c_free_bus(handle_);
         throw(BusError(name() +
               " talking to address: " + 
               convert<std::string>(address))
              );
-    }    
+    }
+    if ( (status != AA_OK) || (numWrite != writeBuffer_.size()) ) {
+        aa_i2c_free_bus(handle_);
+        whatError_ = "Bus Command Error: " + convert<std::string>(status);
+    }
     std::string strAdd = convert<std::string>(address);
     Assert<BusError>(!isError(), name() + " " + whatError() + " address: " + strAdd);
 }
@@ -189,8 +260,30 @@ std::string I2C::whatError() const {
 	return(whatError_);
 }
 
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//===============================
+// Instrument<I2C>::getAddress()
+//===============================
+template <>
+long Instrument<I2C>::getAddress(InstrumentTypes::Types instrType) {
+    // Slave address as for any bus, plus its optional bitrate
+    InstrumentFile* ptr = SingletonType<InstrumentFile>::Instance();
+    long add = ptr->GetAddress(instrType);
+    Assert<FileError>((add > 0) && (add < bus_.maxAddress()), name());
+    add = bus_.open(0, add, std::make_pair(false, 0L));
+    std::pair<bool, long> rate = ptr->GetI2CBitrate(instrType);
+    if ( rate.first )
+        bus_.setBitrate(add, rate.second);
+    return(add);
+}
+
 } // namespace SPTSInstrument
 
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -11,6 +11,20 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added GetBoard() and GetSecondaryAddress() --> optional "GPIB Board" and "GPIB
+       Secondary Address" entries (with PS1/PS2/PS3 prefixes for main supplies, as
+       for "GPIB Address").  An instrument without a board entry is on board 0 and
+       one without a secondary address entry has none.  Added addressVariable().
+     Added GetLanAddress() --> "LAN Address" entry (host[:port]) for instruments
+       talked to over SocketSCPI.  Same PS1/PS2/PS3 prefixes.
+     Added GetI2CBitrate() --> optional "I2C Bitrate" entry in kHz.  Instruments
+       without one are left at the I2C bus' default rate.
+     GetAddress() keeps the numeric part of the "GPIB Address" entry; it used to
+       discard the result of GetNumericInteger().
+
    ==============
    11/14/05, sjn,
    ==============
@@ -101,24 +115,71 @@ namespace {
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
 /***************************************************************************************/
 
-//==============
-// GetAddress() 
-//==============
-long InstrumentFile::GetAddress(Types type) {
-    std::string add = "GPIB Address";
+//===================
+// addressVariable()
+//===================
+std::string InstrumentFile::addressVariable(Types type, const std::string& variable) {
     if ( type == InstrumentTypes::PS1 )
-        add = "PS1 GPIB Address";
+        return("PS1 " + variable);
     else if ( type == InstrumentTypes::PS2 )
-        add = "PS2 GPIB Address";
+        return("PS2 " + variable);
     else if ( type == InstrumentTypes::PS3 )
-        add = "PS3 GPIB Address";
+        return("PS3 " + variable);
+    return(variable);
+}
 
+//==============
+// GetAddress() 
+//==============
+long InstrumentFile::GetAddress(Types type) {
+    std::string add = addressVariable(type, "GPIB Address");
     add = if_.GetVariableValue(GetName(type), add);
     Assert<FileError>(!add.empty(), name());
-    GetNumericInteger(add);
+    add = GetNumericInteger(add);
     return(convert<long>(add));
 }    
 
+//============
+// GetBoard()
+//============
+long InstrumentFile::GetBoard(Types type) {
+    std::string board;
+    try {
+        board = if_.GetVariableValue(GetName(type), 
+                                     addressVariable(type, "GPIB Board"));
+    } catch(FileError&) {
+        return(0); // optional --> GPIB0
+    }
+    board = GetNumericInteger(board);
+    Assert<FileError>(!board.empty(), name());
+    return(convert<long>(board));
+}
+
+//=================
+// GetI2CBitrate()
+//=================
+std::pair<bool, long> InstrumentFile::GetI2CBitrate(Types type) {
+    std::string rate;
+    try {
+        rate = if_.GetVariableValue(GetName(type), addressVariable(type, "I2C Bitrate"));
+    } catch(FileError&) {
+        return(std::make_pair(false, 0L)); // optional
+    }
+    rate = GetNumericInteger(rate);
+    Assert<FileError>(!rate.empty(), name());
+    return(std::make_pair(true, convert<long>(rate)));
+}
+
+//=================
+// GetLanAddress()
+//=================
+std::string InstrumentFile::GetLanAddress(Types type) {
+    std::string add = addressVariable(type, "LAN Address");
+    add = RemoveAllWhiteSpace(if_.GetVariableValue(GetName(type), add));
+    Assert<FileError>(!add.empty(), name());
+    return(add);
+}
+
 //================
 // GetModelType()
 //================
@@ -190,6 +251,22 @@ std::string InstrumentFile::GetName(Types type) {
     };
 }
 
+//=======================
+// GetSecondaryAddress()
+//=======================
+std::pair<bool, long> InstrumentFile::GetSecondaryAddress(Types type) {
+    std::string add;
+    try {
+        add = if_.GetVariableValue(GetName(type), 
+                                   addressVariable(type, "GPIB Secondary Address"));
+    } catch(FileError&) {
+        return(std::make_pair(false, 0L)); // optional
+    }
+    add = GetNumericInteger(add);
+    Assert<FileError>(!add.empty(), name());
+    return(std::make_pair(true, convert<long>(add)));
+}
+
 //=================
 // getScopeRange()
 //=================
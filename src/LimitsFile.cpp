@@ -1,6 +1,7 @@
 // Files included
 #include "Assertion.h"
 #include "Converter.h"
+#include "DateTime.h"
 #include "GenericAlgorithms.h"
 #include "LimitsFile.h"
 #include "OperatorInterface.h"
@@ -12,6 +13,16 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Reload() skips rebuilding lf_ and tests_ when its inputs match the last load
+       and watcher_ reports no change to any file consulted --> in a run of like
+       dash numbers the limits files are read once, not once per DUT.  The step
+       position is still reset every time.  Today's date is one of the inputs:
+       deviation entries are chosen by their expiration date, so a lot that runs
+       past midnight reloads once.  Added #include "DateTime.h".
+
    ==============
    03/09/05, sjn,
    ==============
@@ -185,9 +196,23 @@ void LimitsFile::Reload() {
     bool engTest = operatorInterface_->IsEngineeringTest();
     bool teTest = operatorInterface_->IsTestEngineeringTest();
     teTest = teTest ? teTest : operatorInterface_->IsStationDebugMode();
+    bool gold = operatorInterface_->IsGoldStandardTest();
+
+    // Everything that selects the file and the tests within it --> deviations are
+    //  selected against today's date
+    std::string inputs = cptr->FamilyNumber() + "|" + dash + "|" + testType + "|" +
+                         wo + "|" + id + "|" + loc + "|" + (engTest ? "E" : "-") +
+                         (teTest ? "T" : "-") + "|" + Date::CurrentDate();
+    if ( gold )
+        inputs += "|GOLD|" + cptr->SerialNumber();
+    stepNumber_ = start_;
+    atEnd_= false;
+    if ( lf_.get() && tests_.get() && watcher_.Current(inputs) )
+        return; // same limits, unchanged on disk
 
+    watcher_.Reset();
     try {        
-        if ( operatorInterface_->IsGoldStandardTest() ) { // Gold Standard                        
+        if ( gold ) { // Gold Standard                        
             lf_.reset(new FileTypes::LimitsFileType(cptr->FamilyNumber(), true));
             tests_.reset(new LF::Tests(lf_->GetGoldTests(cptr->DashNumber(),
                                                          cptr->SerialNumber())));
@@ -202,10 +227,9 @@ void LimitsFile::Reload() {
     } catch(...) {
         throw(MinorExceptionTypes::NoLimitsFound());
     }
-    stepNumber_ = start_;
-    atEnd_= false;
     Assert<FileError>(!tests_->empty(), Name());
     checkArguments(testType);
+    watcher_.Watch(inputs, lf_->Sources());
 }
 
 //===============
@@ -20,6 +20,41 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes (in Main) <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added BatchScheduler support.  When a lot file exists for the work order, the
+       operator is told which DUT and test type to run next so that every DUT in
+       the lot is run at one temperature band before the base plate moves to the
+       next.  Running out of schedule is allowed but warned about.  Each completed
+       sequence is recorded so that the lot may be resumed; aborted sequences and
+       those ended by a DUT exception are not.  Bands are ordered from the measured
+       base plate temperature.  Lot problems (FileError) are logged at
+       ErrorRecord::WARNING and shown, and never stop testing.
+     In station debug mode, the sequence's dry-run time estimate (SequenceCost) is
+       shown once it has been synchronized, with the result cache's hit and miss
+       counts (TestSequence::GetCacheStatistics()).
+     Added showStartupTimes():  in station debug mode, the per-instrument
+       Initialize() times (SPTS::GetStartupTimes()) are shown once the station has
+       first been initialized.
+     Station-ending exceptions are logged at ErrorRecord::FATAL against the
+       instrument SPTS last reported in error (ErrorLogger::LastInstrument()).  The
+       unknown exception's dialog and number are logged as one message.
+     Added profileSequence():  after each sequence, the measured per-phase times
+       (SequenceProfiler) are appended to <family>Profile.csv beside the family's
+       local archive; in station debug mode they are also shown with the running
+       per-family summary and the instruments' suppressed command counts
+       (SPTS::GetSuppressedCommands()).
+     Added recordSkippedTests():  when a risk-ordered, fail-fast production run
+       stops early, the steps it never ran are appended to <family>Skipped.csv
+       beside the family's local archive.
+     Added saveSettleCurves():  settle curves learned during the sequence
+       (PauseStates) are written once per DUT; a failed write is logged at
+       ErrorRecord::WARNING and does not stop testing.
+     recordSkippedTests() also records steps left out by skip-lot testing, and each
+       row now ends with why the step was not run:  "Fail fast" or "Skip lot" with
+       the step's Cpk.
+
    ==============
    11/20/05, sjn,
    ==============
@@ -63,6 +98,7 @@
 
 // Files included
 #include "Assertion.h"
+#include "BatchScheduler.h"
 #include "Converter.h"
 #include "DataArchive.h"
 #include "DateTime.h"
@@ -71,8 +107,11 @@
 #include "ErrorLogger.h"
 #include "Functions.h"
 #include "LimitsFile.h"
+#include "MainSupplyTraits.h"
 #include "OperatorInterface.h"
 #include "OScopeSetupFile.h"
+#include "PauseStates.h"
+#include "SequenceProfiler.h"
 #include "Shutdown.h"
 #include "SingletonType.h"
 #include "SPTS.h"
@@ -94,8 +133,14 @@ namespace {
 
     // Function prototypes
     void archiveData(const DataArchive&, bool = false);
+    void checkSchedule(bool);
     template <typename PtrType>
     bool checkPtr(const PtrType& ptr);
+    void profileSequence();
+    void recordSkippedTests();
+    void saveSettleCurves();
+    void showNextScheduled();
+    void showStartupTimes();
     void synchronizeSingletons();
 }
 
@@ -153,6 +198,7 @@ int main() {
             // synchronize singleton variables
             try {
                 synchronizeSingletons();
+                checkSchedule(stationInitialized);
             } catch(SPTSExceptions::MinorStationBase& met) {
                 screen << met.GetExceptionInfo();
                 screen.DisplayInfo();
@@ -171,6 +217,8 @@ int main() {
                     StationNS::InitializeAlgorithms();                
                     StationNS::InitializeStation();
                     stationInitialized = true;
+                    if ( operatorInterface->IsStationDebugMode() )
+                        showStartupTimes();
                 }
                 else
                     spts->NewDUTSetup();
@@ -199,6 +247,19 @@ int main() {
 
                 // Synchronize the next test sequnce
                 testSequence->Synchronize();
+
+                // Debug mode --> show the dry-run time estimate before testing
+                if ( operatorInterface->IsStationDebugMode() ) {
+                    std::stringstream estimate;
+                    testSequence->EstimateSequence(
+                                         GetRoomTemperature().Value()).Report(estimate);
+                    std::pair<long, long> cache = testSequence->GetCacheStatistics();
+                    estimate << std::endl << "Result cache (since start): " 
+                             << cache.first << " hits, " << cache.second 
+                             << " misses" << std::endl;
+                    screen << estimate.str();
+                    screen.DisplayInfo();
+                }
             } catch(SPTSExceptions::MinorStationBase& met) { // Minor Station Exception
                 clock.StopTiming();
                 screen << met.GetExceptionInfo();
@@ -212,8 +273,10 @@ int main() {
             } // try
 
             // Run the test sequence
+            bool completed = false;
             try {
                 testSequence->PerformSequence();
+                completed = true;
             } catch(DUTExceptionTypes::TestAborted&) { // Aborted Test
                 ShutDown(noResetTemp);                    
                 StationNS::InitializeStation(noResetTemp);
@@ -232,9 +295,29 @@ int main() {
             // Stop timing
             clock.StopTiming();
 
+            // Record where the sequence's time went and how its readings settled
+            profileSequence();
+            saveSettleCurves();
+
             // Archive data if applicable
             DataArchive da(clock.ElapsedTime());
             archiveData(da);
+            recordSkippedTests();
+
+            // Record a completed sequence against the lot, if any; show what is next
+            if ( completed && testSequence->HasAnyTests() ) {
+                try { // lot scheduling is advisory --> never stops testing
+                    SingletonType<BatchScheduler>::Instance()->Record(
+                                   SingletonType<Converter>::Instance()->SerialNumber(),
+                                   operatorInterface->GetTestType(),
+                                   testSequence->SequenceStatus()
+                                                                     );
+                } catch(StationExceptionTypes::FileError& fe) {
+                    errorLog.Log(ErrorRecord::WARNING, BatchScheduler::Name(),
+                                 fe.GetExceptionInfo());
+                }
+                showNextScheduled();
+            }
            
             // Try to print; operator may still have chosen not to, however
               std::stringstream printValue;
@@ -287,7 +370,8 @@ int main() {
         }
     } catch(SPTSExceptions::MajorStationBase& met) {
         try {
-            errorLog << met.GetExceptionInfo();
+            errorLog.Log(ErrorRecord::FATAL, errorLog.LastInstrument(),
+                         met.GetExceptionInfo());
             try {
                 bool isError = true;
                 ProgramTypes::MType elapsedTime = 0;
@@ -317,7 +401,8 @@ int main() {
         }
     } catch(SPTSExceptions::ExceptionBase& eb) {
         try {
-            errorLog << eb.GetExceptionInfo();
+            errorLog.Log(ErrorRecord::FATAL, errorLog.LastInstrument(),
+                         eb.GetExceptionInfo());
             try {
                 bool isError = true;
                 ProgramTypes::MType elapsedTime = 0;
@@ -337,9 +422,11 @@ int main() {
     } catch(DoneTesting&) {
         // do nothing
     } catch(...) {
-        errorLog << UnknownException::GetDialog()
-                 << " Error Number: " 
-                 << UnknownException::GetValue();
+        std::stringstream unknown;
+        unknown << UnknownException::GetDialog()
+                << " Error Number: " 
+                << UnknownException::GetValue();
+        errorLog.Log(ErrorRecord::FATAL, errorLog.LastInstrument(), unknown.str());
         try {
             bool isError = true;
             ProgramTypes::MType elapsedTime = 0;
@@ -456,6 +543,43 @@ namespace {
         } // try
     }
 
+    //=================
+    // checkSchedule()
+    //=================
+    void checkSchedule(bool stationInitialized) {
+        // Advisory only --> operator may run out of order, but will cost a
+        //  base plate temperature transition.  A bad lot file is reported and
+        //  testing goes on without a schedule.
+        OperatorInterface* oi = SingletonType<OperatorInterface>::Instance();
+        BatchScheduler* bs = SingletonType<BatchScheduler>::Instance();
+        DialogBox& screen = (*SingletonType<DialogBox>::Instance());
+
+        // Bands are ordered from where the base plate actually is
+        ProgramTypes::SetType plate = GetRoomTemperature().Value(); // not started yet
+        if ( stationInitialized )
+            plate = SingletonType<SpacePowerTestStation::SPTS>::Instance()->
+                                                          MeasureBaseTemp().Value();
+        try {
+            bs->Synchronize(oi->GetWorkOrder(), plate);
+        } catch(StationExceptionTypes::FileError& fe) {
+            SingletonType<ErrorLogger>::Instance()->Log(ErrorRecord::WARNING, 
+                                                        BatchScheduler::Name(),
+                                                        fe.GetExceptionInfo());
+            screen << "Lot file not usable; testing without a lot schedule.  "
+                   << fe.GetExceptionInfo();
+            screen.DisplayInfo();
+            return;
+        }
+        std::string serial = SingletonType<Converter>::Instance()->SerialNumber();
+        if ( bs->IsScheduled(serial, oi->GetTestType()) )
+            return;
+
+        BatchScheduler::Job next = bs->Next();
+        screen << "Out of lot schedule.  Next scheduled: S/N " << next.SerialNumber
+               << " at " << next.TestType;
+        screen.DisplayInfo();
+    }
+
     //============
     // checkPtr()
     //============
@@ -464,6 +588,133 @@ namespace {
         return(ptr != 0);
     }
 
+    //===================
+    // profileSequence()
+    //===================
+    void profileSequence() {
+        SequenceProfiler* profiler = SingletonType<SequenceProfiler>::Instance();
+        profiler->Finish();
+        try { // profiling must never stop testing
+            std::string file = SingletonType<StationFile>::Instance()->LocalArchive();
+            file = file.substr(0, file.rfind('.')) + "Profile.csv";
+            profiler->Archive(file);
+        } catch(...) { /* */ }
+
+        if ( SingletonType<OperatorInterface>::Instance()->IsStationDebugMode() ) {
+            std::stringstream s;
+            profiler->Report(s);
+            s << std::endl;
+            profiler->Summary(s);
+            typedef SpacePowerTestStation::SPTS SPTS;
+            SPTS::SuppressedCommands skipped = 
+                          SingletonType<SPTS>::Instance()->GetSuppressedCommands();
+            s << std::endl << "Settings not resent (already current):" << std::endl;
+            SPTS::SuppressedCommands::const_iterator i = skipped.begin();
+            while ( i != skipped.end() ) {
+                s << i->first << ": " << i->second << std::endl;
+                ++i;
+            }
+            DialogBox& screen = (*SingletonType<DialogBox>::Instance());
+            screen << s.str();
+            screen.DisplayInfo();
+        }
+    }
+
+    //======================
+    // recordSkippedTests()
+    //======================
+    void recordSkippedTests() {
+        TestSequence* testSequence = SingletonType<TestSequence>::Instance();
+        if ( !testSequence->HasAnyTests() )
+            return;
+        std::vector<TestStepInfo> skipped;
+        if ( testSequence->IsRiskOrdered() )
+            skipped = testSequence->GetSkippedTests();
+        std::vector< std::pair<TestStepInfo, double> > sampledOut;
+        sampledOut = testSequence->GetSampledOutTests();
+        if ( skipped.empty() && sampledOut.empty() )
+            return;
+
+        std::string file;
+        try {
+            Converter* dut = SingletonType<Converter>::Instance();
+            file = SingletonType<StationFile>::Instance()->LocalArchive();
+            file = file.substr(0, file.rfind('.')) + "Skipped.csv";
+            std::ofstream of(file.c_str(), std::ofstream::app);
+            Assert<StationExceptionTypes::FileError>(checkPtr(of), name);
+            std::string prefix = Date::CurrentDate() + "," + Clock::CurrentTime() + ",";
+            prefix += dut->FamilyNumber() + "-" + dut->DashNumber() + ",";
+            prefix += dut->SerialNumber() + ",";
+            prefix += SingletonType<OperatorInterface>::Instance()->GetTestType() + ",";
+            std::vector<TestStepInfo>::iterator i = skipped.begin();
+            while ( i != skipped.end() ) {
+                TestStepInfo::TSPtr tptr = *i++;
+                of << prefix << tptr->TestName() << ",Fail fast" << std::endl;
+            }
+            of << std::setiosflags(std::ios::fixed) << std::setprecision(2);
+            std::vector< std::pair<TestStepInfo, double> >::iterator j;
+            for ( j = sampledOut.begin(); j != sampledOut.end(); ++j ) {
+                TestStepInfo::TSPtr tptr = j->first;
+                of << prefix << tptr->TestName() << ",Skip lot Cpk "
+                   << j->second << std::endl;
+            }
+        } catch(...) { // results are archived; note the loss without stopping
+            SingletonType<ErrorLogger>::Instance()->Log(ErrorRecord::WARNING, "",
+                                             "Unable to record skipped steps: " + file);
+        }
+    }
+
+    //====================
+    // saveSettleCurves()
+    //====================
+    void saveSettleCurves() {
+        try {
+            SingletonType<PauseStates>::Instance()->SaveSettleCurves();
+        } catch(...) { // kept for the next DUT; note the problem without stopping
+            SingletonType<ErrorLogger>::Instance()->Log(ErrorRecord::WARNING, "",
+                                             "Unable to save learned settle times");
+        }
+    }
+
+    //=====================
+    // showNextScheduled()
+    //=====================
+    void showNextScheduled() {
+        BatchScheduler* bs = SingletonType<BatchScheduler>::Instance();
+        if ( ! bs->IsActive() )
+            return;
+        DialogBox& screen = (*SingletonType<DialogBox>::Instance());
+        if ( bs->AtEnd() )
+            screen << "Lot complete";
+        else {
+            BatchScheduler::Job next = bs->Next();
+            screen << "Next in lot: S/N " << next.SerialNumber 
+                   << " at " << next.TestType << " ("
+                   << bs->RemainingTransitions() << " temperature band(s) remain)";
+        }
+        screen.DisplayInfo();
+    }
+
+    //====================
+    // showStartupTimes()
+    //====================
+    void showStartupTimes() {
+        typedef SpacePowerTestStation::SPTS SPTS;
+        const SPTS::StartupTimes& times = 
+                                SingletonType<SPTS>::Instance()->GetStartupTimes();
+        std::stringstream s;
+        s << "Station startup (seconds):" << std::endl;
+        s << std::setiosflags(std::ios::fixed) << std::setprecision(2);
+        SPTS::StartupTimes::const_iterator i = times.begin();
+        while ( i != times.end() ) {
+            s << i->first << ": " << i->second << std::endl;
+            ++i;
+        }
+        DialogBox& screen = (*SingletonType<DialogBox>::Instance());
+        screen << s.str();
+        screen.DisplayInfo();
+    }
+
     //=========================
     // synchronizeSingletons()
     //=========================
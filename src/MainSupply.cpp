@@ -8,6 +8,19 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added BeginTransaction(), CommitTransaction() and AbortTransaction() --> settings
+       made in between go to the supply as one concatenated command.  A commit that
+       wrote anything is followed by one IsError() check.
+     Initialize() sends its own supply's setup as one transaction.
+     Output, protection, volts and amps settings go through a ShadowState<> and are
+       not resent when the supply already has them.  Initialize(), an error from
+       IsError() and AbortTransaction() invalidate the shadow.  Added send(),
+       InvalidateShadow() and SuppressedCommands().
+     Added GetResolution().
+
    ==============
    11/14/05, sjn,
    ==============
@@ -202,6 +215,22 @@ MainSupply::MainSupply(const std::pair<
 MainSupply::~MainSupply() 
 { /* */ }
 
+//====================
+// AbortTransaction()
+//====================
+void MainSupply::AbortTransaction() {
+    Instrument<BT>::abortTransaction();
+    shadow_.Invalidate(); // unknown what got through
+}
+
+//====================
+// BeginTransaction()
+//====================
+void MainSupply::BeginTransaction() {
+    Assert<InstrumentError>(!locked_, name_);
+    Instrument<BT>::beginTransaction(address_, supply_->Concatenate());
+}
+
 //========================
 // bitprocess() overload1
 //========================
@@ -300,6 +329,17 @@ bool MainSupply::command(const std::string& cmd, long address) {
     return(Instrument<BT>::commandInstr(address, cmd)); 
 }
 
+//=====================
+// CommitTransaction()
+//=====================
+bool MainSupply::CommitTransaction() {
+    if ( ! Instrument<BT>::commitTransaction() )
+        return(false);
+    if ( Instrument<BT>::commitSent() && IsError() ) // one check for the whole write
+        throw(InstrumentError(name_ + std::string(": ") + WhatError()));
+    return(true);
+}
+
 //===============
 // GetAccuracy()
 //===============
@@ -315,6 +355,14 @@ ProgramTypes::SetType MainSupply::GetAmps() {
     return(iin_);
 }
 
+//=================
+// GetResolution()
+//=================
+ProgramTypes::SetType MainSupply::GetResolution() const {
+    typedef SingletonType<InstrumentFile> IF;
+    return(IF::Instance()->VoltageResolution(supplyType_));
+}
+
 //============
 // GetVolts()
 //============
@@ -329,10 +377,14 @@ bool MainSupply::Initialize() {
     isOff_  = true;
     locked_ = false;
     hasChanged_ = true;
+    shadow_.Invalidate();
     try {
+        Instrument<BT>::abortTransaction(); // nothing left over from before
+        BeginTransaction();
         Assert<InstrumentError>(command(supply_->Initialize()), name_);
         Assert<InstrumentError>(OutputOff(), name_);
         Assert<InstrumentError>(command(supply_->ClearErrors()), name_);
+        Assert<InstrumentError>(CommitTransaction(), name_);
 
         // Initialize unused supplies to ensure they are off, then delete
         for ( std::size_t idx = 0; idx < otherSupplies_.size(); ++idx ) {
@@ -353,12 +405,20 @@ bool MainSupply::Initialize() {
         }      
         otherSupplies_.erase(otherSupplies_.begin(), otherSupplies_.end());
     } catch(...) {
+        Instrument<BT>::abortTransaction();
         locked_ = true;
         throw;
     }
     return(true);
 }
 
+//====================
+// InvalidateShadow()
+//====================
+void MainSupply::InvalidateShadow() {
+    shadow_.Invalidate(); // another instrument's error: state here is suspect too
+}
+
 //===========
 // IsError()
 //===========
@@ -366,7 +426,10 @@ bool MainSupply::IsError() {
     std::string reg = query(supply_->IsError());
     bool toRtn = bitprocess(reg, Instrument<BT>::ERROR);
     reg = query(supply_->OverCurrentCheck());
-    return(bitprocess(reg) || toRtn);
+    toRtn = bitprocess(reg) || toRtn;
+    if ( toRtn ) // supply may no longer be where we left it
+        shadow_.Invalidate();
+    return(toRtn);
 }
 
 //========
@@ -417,9 +480,12 @@ bool MainSupply::OperationComplete() {
 // OutputOff()
 //=============
 bool MainSupply::OutputOff() {    
-    Assert<InstrumentError>(command(supply_->OutputOff()));
+    std::string cmd = supply_->OutputOff();
+    if ( ! shadow_.IsCurrent(OUTPUT, cmd) ) {
+        Assert<InstrumentError>(send(OUTPUT, cmd));
+        hasChanged_ = true;
+    }
     isOff_ = true;
-    hasChanged_ = true;
     return(isOff_);
 }
 
@@ -427,9 +493,12 @@ bool MainSupply::OutputOff() {
 // OutputOn()
 //============
 bool MainSupply::OutputOn() {
-    Assert<InstrumentError>(command(supply_->OutputOn()));
+    std::string cmd = supply_->OutputOn();
+    if ( ! shadow_.IsCurrent(OUTPUT, cmd) ) {
+        Assert<InstrumentError>(send(OUTPUT, cmd));
+        hasChanged_ = true;
+    }
     isOff_ = false;
-    hasChanged_ = true;
     return(!isOff_);
 }
 
@@ -448,14 +517,26 @@ bool MainSupply::Reset() {
     return(Initialize());
 }
 
+//========
+// send()
+//========
+bool MainSupply::send(Setting key, const std::string& cmd) {
+    shadow_.Invalidate(key); // unknown until the supply takes cmd
+    if ( ! command(cmd) )
+        return(false);
+    shadow_.Update(key, cmd);
+    return(true);
+}
+
 //==============
 // SetCurrent()
 //==============
 bool MainSupply::SetCurrent(const ProgramTypes::SetType& limit) {
     Assert<BadArg>(limit >= ProgramTypes::SetType(0), name_);
-    if ( iin_ == limit )
+    std::string cmd = supply_->SetAmps(limit);
+    if ( shadow_.IsCurrent(AMPS, cmd) )
         return(true); // already there
-    if ( command(supply_->SetAmps(limit)) ) {
+    if ( send(AMPS, cmd) ) {
         iin_ = limit;
         hasChanged_ = true;
         return(true);
@@ -468,7 +549,10 @@ bool MainSupply::SetCurrent(const ProgramTypes::SetType& limit) {
 // SetCurrentProtection()
 //========================
 bool MainSupply::SetCurrentProtection(Switch state) {
-    return(command(supply_->SetCurrentProtection(state)));
+    std::string cmd = supply_->SetCurrentProtection(state);
+    if ( shadow_.IsCurrent(PROTECTION, cmd) )
+        return(true); // already there
+    return(send(PROTECTION, cmd));
 }
 
 //============
@@ -476,9 +560,10 @@ bool MainSupply::SetCurrentProtection(Switch state) {
 //============
 bool MainSupply::SetVolts(const ProgramTypes::SetType& value) {   
     Assert<BadArg>(value >= ProgramTypes::SetType(0), name_);
-    if ( vin_ == value ) // already there
+    std::string cmd = supply_->SetVolts(value);
+    if ( shadow_.IsCurrent(VOLTS, cmd) ) // already there
         return(true); 
-    if ( command(supply_->SetVolts(value)) ) {
+    if ( send(VOLTS, cmd) ) {
         vin_ = value;
         hasChanged_ = true;
         return(true);
@@ -487,6 +572,13 @@ bool MainSupply::SetVolts(const ProgramTypes::SetType& value) {
     return(false);
 }
 
+//======================
+// SuppressedCommands()
+//======================
+long MainSupply::SuppressedCommands() const {
+    return(shadow_.Suppressed());
+}
+
 //=============
 // WhatError()
 //=============
@@ -4,6 +4,7 @@
 #include "InstrumentTypes.h"
 #include "Measurement.h"
 #include "OScopeParameters.h"
+#include "SequenceProfiler.h"
 #include "SPTSException.h"
 #include "StationAlgorithms.h"
 
@@ -12,6 +13,17 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+   Added Reset() so that one object per measurement type may be reused for every
+     step of every sequence (see TestSequence::Synchronize()).
+   Measure(), MeasureWithoutPrePostConditions(), preMeasurement() and
+     postMeasurement() time their phases through SequenceProfiler::Timer.
+     preMeasurement() is split into Vin, loads, sync, relays (shorts and pre-misc
+     lines), aux supplies and inhibits; the rest is charged to PREMEASUREMENT.
+   Added DependsOn() and dependsOn().
+
    ==============
    06/23/05, sjn,
    ==============
@@ -58,6 +70,8 @@ namespace {
     typedef StationExceptionTypes::BadCommand      BadCommand;
     typedef StationExceptionTypes::InstrumentError InstrumentError;
     typedef StationExceptionTypes::OutOfRange      OutOfRange;
+
+    typedef SequenceProfiler Profiler;
 }
 
 /***************************************************************************************/
@@ -115,6 +129,23 @@ bool Measurement::dealWithRampVinInBase() const {
     return(true);
 }
 
+//=============
+// DependsOn()
+//=============
+std::string Measurement::DependsOn() const {
+    // Name of the measurement whose ExtraMeasurements() supply this one's value;
+    //  empty if this measurement stands alone
+    return(dependsOn());
+}
+
+//=============
+// dependsOn()
+//=============
+std::string Measurement::dependsOn() const {
+    // virtual which may be overridden
+    return("");
+}
+
 //===============
 // DoneAlready()
 //===============
@@ -165,6 +196,7 @@ Measurement::ReturnType Measurement::Measure(ConditionsPtr conditions,
 
     // Make measurement
     try {
+        Profiler::Timer timer(Profiler::MEASURE);
         operator()(conditions, limits);
     } catch(SPTSExceptions::DUTCriticalBase& dcb) {
         errorCode_ = dcb.GetExceptionID();
@@ -192,6 +224,7 @@ Measurement::ReturnType
 
     // Make measurement
     try {
+        Profiler::Timer timer(Profiler::MEASURE);
         operator()(conditions, limits);
     } catch(SPTSExceptions::DUTCriticalBase& dcb) {
         errorCode_ = dcb.GetExceptionID();
@@ -231,6 +264,7 @@ void Measurement::onException() {
 // postMeasurement()
 //===================
 void Measurement::postMeasurement(ConditionsPtr conditions) {
+    Profiler::Timer timer(Profiler::POSTMEASUREMENT);
 
     // Deal with abnormal input line condition
     ProgramTypes::SetType s = spts_->GetVin();
@@ -335,6 +369,7 @@ void Measurement::postMeasurement(ConditionsPtr conditions) {
 // preMeasurement()
 //==================
 void Measurement::preMeasurement(ConditionsPtr conditions) {
+    Profiler::Timer timer(Profiler::PREMEASUREMENT);
 
     // Get pause value for all optional initial conditions
     PauseStates* ps = SingletonType<PauseStates>::Instance();        
@@ -342,14 +377,21 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
     SetType mPause = ps->GetPauseValue(PauseStates::MISCELLANEOUSINITIALCONDITIONS);
 
     // Set vin and iout values
-    spts_->SetVin(conditions->Vin());
-    spts_->SetLoad(conditions->Iouts());
+    {
+        Profiler::Timer vin(Profiler::VIN);
+        spts_->SetVin(conditions->Vin());
+    }
+    {
+        Profiler::Timer loads(Profiler::LOADS);
+        spts_->SetLoad(conditions->Iouts());
+    }
 
     // static local --> does not change from converter-2-converter
     static SetType syncPause = ps->GetPauseValue(PauseStates::SYNCINPUT);
 
     // Deal with a sync input signal
     if ( conditions->SyncIn() ) {
+        Profiler::Timer sync(Profiler::SYNC);
         spts_->SafeInhibit(ON);
         spts_->SetSync(
             conditions->Freq(),
@@ -364,6 +406,7 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
     
     // Deal with load shorts
     if ( !conditions->Shorted().empty() ) {
+        Profiler::Timer relays(Profiler::RELAYS);
         SpacePowerTestStation::Short(conditions->Shorted(), ON);
         Pause(optionPause);
         // Measure each applicable vout and ensure < 'maxShortVout'
@@ -385,6 +428,7 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
 
     // Deal with primary aux supply
     if ( conditions->APSPrimary() != TestStepInfo::UNDEFINEDSETTYPE ) {
+        Profiler::Timer aux(Profiler::AUXSUPPLY);
         spts_->SafeInhibit(ON);
         spts_->SetAPS(SpacePowerTestStation::APS::PRIMARY, 
                       SpacePowerTestStation::APS::VOLTS,
@@ -396,6 +440,7 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
 
     // Deal with secondary aux supply
     if ( conditions->APSSecondary() != TestStepInfo::UNDEFINEDSETTYPE ) {
+        Profiler::Timer aux(Profiler::AUXSUPPLY);
         spts_->SafeInhibit(ON);
         spts_->SetAPS(SpacePowerTestStation::APS::SECONDARY,
                         SpacePowerTestStation::APS::VOLTS,
@@ -411,6 +456,7 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
     std::vector<ControlMatrixTraits::RelayTypes::MiscRelay> toPass;
     std::copy(preMisc.begin(), preMisc.end(), std::back_inserter(toPass));
     if ( !toPass.empty() ) {
+        Profiler::Timer relays(Profiler::RELAYS);
         spts_->SafeInhibit(ON);
         Pause(mPause);
         spts_->SetPath(toPass);
@@ -425,18 +471,21 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
 
     // Deal with a primary inhibit condition
     if ( conditions->PrimaryInhibited() ) {
+        Profiler::Timer inhibit(Profiler::INHIBIT);
         spts_->StrongInhibit(ON);            
         Pause(optionPause);
     }
 
     // Deal with a secondary inhibit condition
     if ( conditions->SecondaryInhibited() ) {
+        Profiler::Timer inhibit(Profiler::INHIBIT);
         spts_->SetPath(ControlMatrixTraits::RelayTypes::SECONDARYINHIBIT);
         Pause(optionPause);
     }
 
     // Deal with a ramping input voltage condition, if applicable
     if ( conditions->VinRamp() && dealWithRampVinInBase() ) {
+        Profiler::Timer vin(Profiler::VIN);
         Assert<BadCommand>(conditions->VinNext() != TestStepInfo::UNDEFINEDSETTYPE, 
                            GetName());
         spts_->SetVin(conditions->VinNext());
@@ -445,6 +494,16 @@ void Measurement::preMeasurement(ConditionsPtr conditions) {
     }
 }
 
+//=========
+// Reset()
+//=========
+void Measurement::Reset() {
+    // Back to the state of a newly constructed object
+    errorCode_ = TestStepInfo::TestStep::NODUTERROR;
+    returnType_ = ReturnType();
+    extraMeasures_->clear();
+}
+
 //================
 // WhatDUTError()
 //================
@@ -19,6 +19,28 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added TransientEngine to the unnamed namespace and rewrote
+       LoadTransientResponse::performTest() around it.  Every XST event is measured:
+       the load toggles on each trigger, so captures alternate between the forward
+       edge (Iouts to IoutsNext) and the return edge, each analyzed in its own
+       polarity from one waveform upload (SPTS::UploadScope()).  Peak deviation,
+       settled value and recovery time come from the samples; the settled value
+       replaces the two MeasureVoutDC() reads used to cancel load regulation.
+     Load Transient Response is now the worse of the two edges, each averaged over
+       two captures, and Load Transient Recovery the longer of their recovery times
+       (still reported through extraMeasures_).  Was the forward edge only.
+     The iterative 4-step vertical zoom is replaced by TransientEngine::Zoom(): one
+       capture of each edge, with at most one jump of at most 25x in between.  The old
+       zoom loop re-triggered without returning the load, so every other capture was
+       actually the opposite edge.  A measurement is 6 XST events, down from up to 21,
+       and at most 3 vertical scale changes, down from 6.
+     Frequency() sets (and resets) the sync out midtest line along with the scope path
+       as one path change, and LoadTransientResponse::performTest() does the same for
+       its transient and trigger paths --> one relay settling pause each.
+     Added LoadTransientRecovery::dependsOn().
 	
 	=============
 	12/08/08, reb
@@ -265,6 +287,224 @@ namespace { // unnamed
 	    return(std::make_pair(first, container));
     }
 
+    //=================
+    // TransientEngine
+    //=================
+    // Characterizes both edges of a load transient.  The load toggles between its
+    //  two levels on every XST event, so Capture() alternately fires the forward
+    //  edge (Iouts to IoutsNext) and the return edge, and measures whichever it
+    //  fired: no event is spent only to put the load back.  Each capture holds the
+    //  waveform, uploads it once and takes the peak deviation (in that edge's
+    //  polarity), settled value and recovery time from the samples.
+    class TransientEngine {
+    public:
+        typedef Measurement::MType   MType;
+        typedef Measurement::SetType SetType;
+        typedef SPTSInstrument::Oscilloscope::Waveform Waveform;
+
+        struct Edge {
+            Edge() : Forward(true), Peak(0), Settled(0), Recovery(0), 
+                     Recovered(false) { /* */ }
+            bool Forward;   // Iouts to IoutsNext; false for the return edge
+            MType Peak;     // worst case deviation
+            MType Settled;  // end of record deviation --> load regulation shift
+            MType Recovery; // time until back within the recovery reference band
+            bool Recovered; // false if Recovery could not be measured this edge
+        };
+
+        TransientEngine(SpacePowerTestStation::SPTS* spts, 
+                        OScopeChannels::Channel scopeChan,
+                        OScopeMeasurements::MeasurementType peakType,
+                        const SetType& pause) 
+                  : spts_(spts), scopeChan_(scopeChan), peakType_(peakType), 
+                    pause_(pause), forward_(true), recovery_(false), 
+                    fromChan_(scopeChan), slope1_(OScopeParameters::POSITIVE), 
+                    levelFrom_(0), refLevel_(0), negativeSlope_(true), vScale_(0)
+        { /* */ }
+
+        //=============
+        // AtInitial()
+        //=============
+        bool AtInitial() const {
+            // Load at Iouts --> the next capture is a forward edge
+            return(forward_);
+        }
+
+        //===========
+        // Capture()
+        //===========
+        Edge Capture() {
+            Edge edge;
+            edge.Forward = forward_;
+            spts_->WaitOnScope();
+            Pause(pause_); // converter recovery from the previous edge
+            spts_->LoadTransientTrigger();
+            forward_ = !forward_;
+            spts_->StopScope(); // hold waveform; includes spts_->WaitOnScope()
+            try {
+                analyze(edge);
+            } catch(...) {
+                spts_->StartScope();
+                throw;
+            }
+            spts_->StartScope();
+            return(edge);
+        }
+
+        //===============
+        // SetRecovery()
+        //===============
+        void SetRecovery(OScopeChannels::Channel fromChan, 
+                         OScopeParameters::SlopeType slope1,
+                         const SetType& levelFrom, const SetType& refLevel,
+                         bool negativeSlope, const SetType& vScale) {
+            // Arguments describe the forward edge
+            recovery_      = true;
+            fromChan_      = fromChan;
+            slope1_        = slope1;
+            levelFrom_     = levelFrom;
+            refLevel_      = absolute(refLevel);
+            negativeSlope_ = negativeSlope;
+            vScale_        = vScale;
+        }
+
+        //========
+        // Zoom()
+        //========
+        SetType Zoom(const SetType& startScale, long numberVertDvns) {
+            // One capture of each edge, leaving the load at Iouts.  The forward edge
+            //  at the starting scale sizes a single jump (2x headroom, at most 25x
+            //  in: a peak measured on a coarse scale carries that scale's
+            //  quantization error); the final scale fits the larger of the two.
+            SetType halfScreen = numberVertDvns / 2;
+            MType forward = absolute(Capture().Peak);
+            SetType target = SetType(forward.Value()) / (halfScreen - SetType(1));
+            if ( target * SetType(2) < startScale ) { // worth a closer look
+                SetType minScale = startScale / SetType(25);
+                SetType scale = (target > minScale ? target * SetType(2) : minScale);
+                spts_->SetScopeExplicit(scopeChan_, 
+                                     SpacePowerTestStation::ExplicitScope::VERTSCALE, 
+                                     scale);
+            }
+            MType back = absolute(Capture().Peak);
+            MType measured = (forward > back ? forward : back);
+            SetType scale = SetType(measured.Value()) / (halfScreen - SetType(1));
+            spts_->SetScopeExplicit(scopeChan_, 
+                                    SpacePowerTestStation::ExplicitScope::VERTSCALE,
+                                    scale);
+            return(scale);
+        }
+
+    private:
+        //===========
+        // analyze()
+        //===========
+        void analyze(Edge& edge) {
+            bool toPause = true;
+            const Waveform& wave = spts_->UploadScope(scopeChan_, toPause);
+            Assert<RescaleError>(!wave.Clipped, name());
+            Assert<ScopeMeasureError>(!wave.Volts.empty(), name());
+
+            // The return edge deviates the opposite way
+            typedef std::vector<double>::const_iterator Iter;
+            const std::vector<double>& v = wave.Volts;
+            bool toMax = ((peakType_ == OScopeMeasurements::MAXIMUMVALUE) == edge.Forward);
+            Iter peak = (toMax ? std::max_element(v.begin(), v.end()) : 
+                                 std::min_element(v.begin(), v.end()));
+            edge.Peak = *peak;
+
+            // Final tenth of the record
+            long tail = std::max(static_cast<long>(v.size()) / 10, 1L);
+            edge.Settled = std::accumulate(v.end() - tail, v.end(), 0.0) / tail;
+            if ( recovery_ )
+                recover(edge, wave, peak - v.begin());
+        }
+
+        //==========
+        // name()
+        //==========
+        std::string name() const {
+            return(LoadTransientResponse::Name());
+        }
+
+        //===========
+        // recover()
+        //===========
+        void recover(Edge& edge, const Waveform& wave, long peakIndex) {
+            SetType levelTo = refLevel_;
+            levelTo += absolute(edge.Settled).Value(); // cancel out load reg effects
+            SetType peak = absolute(edge.Peak).Value();
+            edge.Recovered = true;
+            if ( levelTo >= peak ) { // no recovery time to measure
+                edge.Recovery = 0;
+                return;
+            }
+
+            // First sample after the peak back within the band.  With a negative-
+            //  going forward edge the waveform is above the band, and the return
+            //  edge is the reverse.
+            bool fromAbove = (negativeSlope_ == edge.Forward);
+            double band = (fromAbove ? levelTo.Value() : -levelTo.Value());
+            const std::vector<double>& v = wave.Volts;
+            long idx = peakIndex, size = static_cast<long>(v.size());
+            while ( (idx < size) && (fromAbove ? (v[idx] > band) : (v[idx] < band)) )
+                ++idx;
+            if ( idx == size ) { // no recovery within the record?
+                SetType margin = 0.5; // allow up to half of a vertical division
+                if ( absolute(levelTo - peak) <= vScale_ * margin ) 
+                    edge.Recovery = 0; // ref value too close to peak value
+                else // time too long
+                    edge.Recovered = false;
+                return;
+            }
+            double stop = wave.Start + (idx * wave.Interval);
+            edge.Recovery = stop - start(edge, wave); // wave invalid after start()
+            Assert<MeasurementError>(edge.Recovery > MType(0), name());
+        }
+
+        //=========
+        // start()
+        //=========
+        double start(const Edge& edge, const Waveform& wave) {
+            // Time fromChan_ crosses levelFrom_.  The electronic load's trigger
+            //  output fires the same way on either edge; a passive load's transition
+            //  is seen on the output itself and reverses with the edge.  If there is
+            //  no crossing, use the trigger instant.
+            OScopeParameters::SlopeType slope = slope1_;
+            if ( (fromChan_ == scopeChan_) && !edge.Forward )
+                slope = (slope1_ == OScopeParameters::POSITIVE ? 
+                                    OScopeParameters::NEGATIVE : 
+                                    OScopeParameters::POSITIVE);
+            bool noPause = false;
+            const Waveform& from = (fromChan_ == scopeChan_ ? wave : 
+                                           spts_->UploadScope(fromChan_, noPause));
+            const std::vector<double>& v = from.Volts;
+            double level = levelFrom_.Value();
+            for ( std::size_t idx = 1; idx < v.size(); ++idx ) {
+                bool crossed = (slope == OScopeParameters::POSITIVE ?
+                                (v[idx-1] < level) && (v[idx] >= level) :
+                                (v[idx-1] > level) && (v[idx] <= level));
+                if ( crossed )
+                    return(from.Start + (idx * from.Interval));
+            } // for
+            return(0);
+        }
+
+    private:
+        SpacePowerTestStation::SPTS* spts_;
+        OScopeChannels::Channel scopeChan_;
+        OScopeMeasurements::MeasurementType peakType_;
+        SetType pause_;
+        bool forward_;
+        bool recovery_;
+        OScopeChannels::Channel fromChan_;
+        OScopeParameters::SlopeType slope1_;
+        SetType levelFrom_;
+        SetType refLevel_;
+        bool negativeSlope_;
+        SetType vScale_;
+    };
+
 } // unnamed namespace
 
 
@@ -588,6 +828,7 @@ void Frequency::operator()(ConditionsPtr conditions, const PairMType& limits) {
             FilterSelects::FilterType thisFilter; // filter line for this measurement
 
             // Sync out requires a midtest miscellaneous line to be set
+            spts_->BeginPathChange();
             if ( path == ACPaths::SYNCOUT ) {
                 std::set<ControlMatrixTraits::RelayTypes::MiscRelay> midMisc = 
                                                                conditions->MidtestMisc();
@@ -602,6 +843,7 @@ void Frequency::operator()(ConditionsPtr conditions, const PairMType& limits) {
  
             // Set path to scope
             spts_->SetPath(path, thisFilter);
+            spts_->CommitPathChange();
 
             // Make sure explicit and non-explicit settings cover everything
             std::size_t numberExplicitTests = 1;
@@ -654,6 +896,7 @@ void Frequency::operator()(ConditionsPtr conditions, const PairMType& limits) {
                 if ( done ) 
                     break;
             } // for
+            spts_->BeginPathChange();
             spts_->ResetPath(path, filter);
 
             // Sync Out requires a midtest miscellaneous line to be reset
@@ -665,7 +908,9 @@ void Frequency::operator()(ConditionsPtr conditions, const PairMType& limits) {
                 Assert<BadCondition>(! midTest.empty(), Name());
                 spts_->ResetPath(midTest); 
             }
+            spts_->CommitPathChange();
         } catch(...) {
+            spts_->AbortPathChange(); // no-op unless mid path change
             spts_->ResetPath(path, filter);   
             throw;
         }               
@@ -1165,6 +1410,13 @@ bool LoadTransientRecovery::beenDone(ConditionsPtr current,
 		  );
 }
 
+//=============
+// dependsOn()
+//=============
+std::string LoadTransientRecovery::dependsOn() const {
+    return(LoadTransientResponse::Name());
+}
+
 
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
@@ -1300,8 +1552,15 @@ void LoadTransientResponse::performTest(ConditionsPtr conditions,
         Assert<UnexpectedState>(selected, Name());
         
         // Set path to oscilloscope
-        spts_->SetPath(StationNS::ACPathTypes::LOADTRANSIENT, thisChannel);                                                          
-        spts_->SetPath(StationNS::ACPathTypes::LOADTRIGGER);
+        spts_->BeginPathChange();
+        try {
+            spts_->SetPath(StationNS::ACPathTypes::LOADTRANSIENT, thisChannel);
+            spts_->SetPath(StationNS::ACPathTypes::LOADTRIGGER);
+        } catch(...) {
+            spts_->AbortPathChange();
+            throw;
+        }
+        spts_->CommitPathChange();
         
         // File scope settings for this test
         std::set<OScopeSetupFile::Parameters> params;
@@ -1358,114 +1617,9 @@ void LoadTransientResponse::performTest(ConditionsPtr conditions,
         SetType transientPause = 
                   PS::Instance()->GetPauseValue(PauseStates::TRANSIENTTRIGGER);
 
-        // Measure Vout Initial
-        MTypeContainer loadReg;
-        bool useDMM = false;
-        MeasureVoutDC(loadReg, conditions->Channel(), useDMM);
-        Assert<UnexpectedState>(loadReg.size() > std::size_t(0), Name());
-        MType voutLoadReg = loadReg[0];
-        loadReg.erase(loadReg.begin(), loadReg.end());
-        
-        // Trigger Load
-        spts_->WaitOnScope();
-        Pause(transientPause);
-        spts_->LoadTransientTrigger();
-        spts_->StopScope(); // hold waveform for measure; includes spts_->WaitOnScope()
-
-        // Calculate load regulation effects --> used for response time
-        MeasureVoutDC(loadReg, conditions->Channel(), useDMM);
-        Assert<UnexpectedState>(loadReg.size() > std::size_t(0), Name());
-        voutLoadReg -= loadReg[0];
-        
-        // Make initial measurement and rescale for better resolution
-        MType measured = 0;
-        bool toPause = true, toRescale = false;
-        measured = spts_->MeasureScope(toMeasure, scopeChan, toPause, toRescale);
-        spts_->StartScope(); // restart scope
-
-		/* Added this sequence that should allow the station to try 4 times to get the signal*/
-		int Tries = 0;
-        SetType VPD = scale;
-		while(Tries<4){
-			Tries++;
-			VPD/=5;
-			if(absolute(measured).Value()< VPD){
-				VPD *= 2.5;
-				spts_->SetScopeExplicit(scopeChan, StationNS::ExplicitScope::VERTSCALE, VPD);
-				// Trigger Load
-				spts_->WaitOnScope();
-				Pause(transientPause);
-				spts_->LoadTransientTrigger();
-				spts_->StopScope(); // hold waveform for measure; includes spts_->WaitOnScope()
-
-				// Get a closer look at the signal.
-				measured = spts_->MeasureScope(toMeasure, scopeChan, toPause, toRescale);
-				spts_->StartScope(); // restart scope
-			}else{
-				Tries = 4;
-			}
-		}
-		vScale = (absolute(measured).Value() / (spts_->NumberScopeVertDvns() / 2 - 1));
-
-		spts_->SetScopeExplicit(scopeChan, StationNS::ExplicitScope::VERTSCALE, vScale);
-
-        MType Avgmeasure = 0;
-		MType maxcycles = 8;
-		for(int loopcount; loopcount<maxcycles; loopcount++){
-	        // Re-trigger load
-			spts_->LoadTransientTrigger();
-
-			// Re-trigger and measure --> actual measurement for this test
-			Pause(transientPause); // for converter recovery
-			spts_->WaitOnScope();
-			spts_->LoadTransientTrigger();
-			spts_->StopScope(); // hold waveform for measure; includes spts_->WaitOnScope()
-
-			try{// Added this measurement to correct for rescale failures. 09/05/07
-				measured = absolute(spts_->MeasureScope(toMeasure, scopeChan, 
-													toPause, toRescale));
-			} catch(RescaleError&) { // waveform clipping
-				spts_->StartScope(); // restart scope
-				vScale = vScale + vScale;
-				spts_->SetScopeExplicit(scopeChan, StationNS::ExplicitScope::VERTSCALE, vScale);
-
-				// Re-trigger load
-				spts_->LoadTransientTrigger();
-
-				// Re-trigger and measure --> Final measurement for this test
-				Pause(transientPause); // for converter recovery
-				spts_->WaitOnScope();
-				spts_->LoadTransientTrigger();
-				spts_->StopScope(); // hold waveform for measure; includes spts_->WaitOnScope()
-				measured = absolute(spts_->MeasureScope(toMeasure, scopeChan, 
-														toPause, toRescale));
-			}
-			Avgmeasure += measured;
-		}
-		measured = Avgmeasure/maxcycles;
-
-        Assert<MeasurementError>(measured > MType(0), Name());
-        returnType_ = makeRtnType(Name(), measured);
-        spts_->LoadTransientOff();
-
-
-        //==========================================
-        // Load Transient Recovery Time measurement
-        //==========================================
-
-        // Measure recovery time and store in extraMeasures_        
-        SetType levelFrom = 2.5, levelTo = conditions->RefVal();
-        if ( levelTo == undefinedValue ) // use default value
-            levelTo = dut_->Vout(thisChannel) * SetType(0.01);
-        levelTo = absolute(levelTo);
-        levelTo += (absolute(voutLoadReg)).Value(); // cancel out load reg effects
-        MType peakMeasure = measured;
-
-        if ( levelTo >= peakMeasure ) { // no recovery time to measure
-            extraMeasures_->push_back(makeRtnType(LoadTransientRecovery::Name(), 0));
-            spts_->StartScope(); // restart oscilloscope
-            return;
-        }
+        // Every capture below is one XST event, measured on whichever edge it fires
+        TransientEngine engine(spts_, scopeChan, toMeasure, transientPause);
+        vScale = engine.Zoom(scale, spts_->NumberScopeVertDvns());
 
         // Assign (slope1) depending on what the load type is
         OScopeChannels::Channel fromChan;
@@ -1480,33 +1634,60 @@ void LoadTransientResponse::performTest(ConditionsPtr conditions,
             fromChan = scopeChan;
         }
 
-        // If you do not have a negative-going slope, then waveform is below reference
-        if ( ! negativeSlope )
-            levelTo *= -1;
+        // Recovery time is measured on the same waveform as the peak deviation
+        SetType levelFrom = 2.5, levelTo = conditions->RefVal();
+        if ( levelTo == undefinedValue ) // use default value
+            levelTo = dut_->Vout(thisChannel) * SetType(0.01);
+        engine.SetRecovery(fromChan, slope1, levelFrom, levelTo, negativeSlope, vScale);
+
+        // Average the peak deviation of each edge over NUMBERPAIRS captures of it,
+        //  ending with the load back at Iouts.  Report the worse edge, and the
+        //  longer of the two recovery times from each edge's final capture.
+        static const long NUMBERPAIRS = 2;
+        MType peakSum[2] = { 0, 0 };
+        long count[2] = { 0, 0 };
+        TransientEngine::Edge last[2];
+        bool rescaled = false;
+        while ( (count[0] < NUMBERPAIRS) || (count[1] < NUMBERPAIRS) || 
+                !engine.AtInitial() ) {
+            TransientEngine::Edge edge;
+            try { // Added this measurement to correct for rescale failures. 09/05/07
+                edge = engine.Capture();
+            } catch(RescaleError&) { // waveform clipping
+                if ( rescaled )
+                    throw;
+                rescaled = true;
+                vScale = vScale + vScale;
+                spts_->SetScopeExplicit(scopeChan, StationNS::ExplicitScope::VERTSCALE,
+                                        vScale);
+                engine.SetRecovery(fromChan, slope1, levelFrom, levelTo, 
+                                   negativeSlope, vScale);
+                continue;
+            }
+            long which = (edge.Forward ? 0 : 1);
+            peakSum[which] += absolute(edge.Peak);
+            last[which] = edge;
+            ++count[which];
+        } // while
+        MType forward = peakSum[0] / MType(count[0]);
+        MType back = peakSum[1] / MType(count[1]);
+        MType measured = (forward > back ? forward : back);
 
-        toPause = false;
-        try {
-            measured = spts_->MeasureScope(OScopeMeasurements::DELAY,
-                                           fromChan, scopeChan, levelFrom, levelTo, 
-                                           slope1, slope2, toPause);
-            Assert<MeasurementError>(measured > MType(0), Name());
-        } catch(ScopeMeasureError&) { // no recovery actually occured within time?
-            SetType refValue = absolute(levelTo), pMeas = absolute(peakMeasure).Value();
-            SetType margin = 0.5; // allow up to half of a vertical division
-            if ( absolute(refValue - pMeas) <= vScale * margin ) 
-                measured = 0; // ref value too close to peak value                
-            else // time too long
-                measured = Measurement::BadMeasurement;
-        } catch(RescaleError& re) { // bad error; would have been caught at pk measure
-            SetType refValue = absolute(levelTo), pMeas = absolute(peakMeasure).Value();
-            SetType margin = 0.5; // allow up to half a vertical division
-            if ( absolute(refValue - pMeas) <= vScale * margin ) 
-                measured = 0; // ref value too close to peak value                
-            else // actual bad measurement
-                throw(re);
-        }
-        extraMeasures_->push_back(makeRtnType(LoadTransientRecovery::Name(), measured));
-        spts_->StartScope(); // restart oscilloscope
+        Assert<MeasurementError>(measured > MType(0), Name());
+        returnType_ = makeRtnType(Name(), measured);
+        spts_->LoadTransientOff();
+
+
+        //==========================================
+        // Load Transient Recovery Time measurement
+        //==========================================
+
+        // Store the longer recovery time of the two edges in extraMeasures_
+        MType recovery = Measurement::BadMeasurement; // time too long
+        if ( last[0].Recovered && last[1].Recovered )
+            recovery = (last[0].Recovery > last[1].Recovery ? 
+                                           last[0].Recovery : last[1].Recovery);
+        extraMeasures_->push_back(makeRtnType(LoadTransientRecovery::Name(), recovery));
     } catch(RescaleError&) { // waveform clipping
         spts_->LoadTransientOff();
         spts_->StartScope();
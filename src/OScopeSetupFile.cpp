@@ -11,6 +11,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+    Reload() rebuilds sf_ only when the family number changes or watcher_ reports a
+       change to the scope setup file.  locked_ is set either way.
+
    ==============
    10/11/04, sjn,
    ==============
@@ -346,8 +352,12 @@ std::string SS::name() {
 void SS::Reload() {
     Converter* cptr = SingletonType<Converter>::Instance();
     std::string familyNumber = cptr->FamilyNumber();
-    sf_.reset(new FileTypes::ScopeSetupFileType(familyNumber));
     locked_ = true;  // must call SetTestName()  
+    if ( sf_.get() && watcher_.Current(familyNumber) )
+        return; // same setup file, unchanged on disk
+    watcher_.Reset();
+    sf_.reset(new FileTypes::ScopeSetupFileType(familyNumber));
+    watcher_.Watch(familyNumber, sf_->Sources());
 }
 
 //===============
@@ -11,6 +11,21 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Constructor gets its address through Instrument<>::getAddress() so that the GPIB
+       board and secondary address in the instrument file are used.
+     Concatenate() now opens and commits an Instrument<> transaction in place of
+       totalSyntax_.  The queued syntax is still sent whole, as one command, with
+       one bus status check, and is followed by one IsError() check.
+     Initialize() records the AUTO trigger mode its initialization string selects
+       instead of sending it again --> the reset is a single command, so SPTS can
+       carry on with other instruments while the scope resets.
+     Added Upload(): selects the waveform source once per channel, then reads the
+       scaling and the samples as one binary block (Instrument<>::queryBlockInstr())
+       decoded in place into the reused waveform_.
+
    ==============
    05/23/05, sjn,
    ==============
@@ -322,12 +337,13 @@ void SChannel::TurnOn() {
 //=============
 Oscilloscope::Oscilloscope() : locked_(true), concatenate_(false), clipping_(false),
                                channelMap_(new ChannelMap), syntax_(""), name_(Name()),
-                               totalSyntax_(""), trigMode_(AUTO), 
+                               trigMode_(AUTO), 
                                trigSource_(OScopeChannels::ALL), horzScale_(-1),
-                               trigModeSet_(false), stopped_(false) {
+                               trigModeSet_(false), stopped_(false),
+                               waveSource_(OScopeChannels::ALL) {
                                
     InstrumentFile* ptr = SingletonType<InstrumentFile>::Instance();
-    address_ = ptr->GetAddress(InstrumentFile::OSCOPE);
+    address_ = Instrument<BT>::getAddress(InstrumentFile::OSCOPE);
 
     typedef OscilloscopeTraits::ScopeFactoryType SF;
     std::set<std::string> possibilities = SF::Instance()->GetAllRegistered();
@@ -451,23 +467,9 @@ void Oscilloscope::ChannelOn(Channel chan) {
 //===========
 bool Oscilloscope::command() {
 	Assert<UnexpectedState>(!locked_, name_);
-	if ( ! syntax_.empty() ) {
-		if ( ! totalSyntax_.empty() ) {
-			totalSyntax_ += scope_->Concatenate();
-			totalSyntax_ += syntax_;
-		}
-		else
-			totalSyntax_ = syntax_;
-	}
-
-	bool result = false;
-	if ( concatenate_ ) // Store syntax for later use
-		result = true;
-	else { // Talk to instrument
-		result = (totalSyntax_.size()) ? 
-                          Instrument<BT>::commandInstr(address_, totalSyntax_) : true;
-		totalSyntax_ = "";
-	}
+	bool result = true;
+	if ( ! syntax_.empty() ) // queued while concatenating
+		result = Instrument<BT>::commandInstr(address_, syntax_);
 	syntax_ = "";
 	return(result);
 }
@@ -476,9 +478,19 @@ bool Oscilloscope::command() {
 // Concatenate()
 //==============
 void Oscilloscope::Concatenate(Switch state) {
-    state == ON ? concatenate_ = true : concatenate_ = false;
-    if ( ! concatenate_ )
-        Assert<InstrumentError>(command(), name_);
+    if ( state == ON ) {
+        if ( ! concatenate_ )
+            Instrument<BT>::beginTransaction(address_, scope_->Concatenate());
+        concatenate_ = true;
+        return;
+    }
+    concatenate_ = false;
+    Assert<InstrumentError>(command(), name_);
+    if ( Instrument<BT>::inTransaction() ) {
+        Assert<InstrumentError>(Instrument<BT>::commitTransaction(), name_);
+        if ( Instrument<BT>::commitSent() && IsError() ) // one check per write
+            throw(InstrumentError(name_ + std::string(": ") + WhatError()));
+    }
 }
 
 //================
@@ -513,7 +525,7 @@ ProgramTypes::SetType Oscilloscope::GetVertScale(Channel chan) {
 void Oscilloscope::ImmediateMode() {
     concatenate_ = false;
     syntax_      = "";
-    totalSyntax_ = "";
+    Instrument<BT>::abortTransaction();
 }
 
 //==============
@@ -523,7 +535,8 @@ bool Oscilloscope::Initialize() {
     concatenate_ = false;    
     trigModeSet_ = false;
     trigSource_  = OScopeChannels::ALL;
-    totalSyntax_ = "";
+    waveSource_  = OScopeChannels::ALL; // *RST restores the default source
+    Instrument<BT>::abortTransaction();
     try {
         // First re-add all known channels
         locked_ = true;
@@ -544,7 +557,11 @@ bool Oscilloscope::Initialize() {
         locked_ = false;
         syntax_ = scope_->Initialize();
         Assert<InstrumentError>(command(), name_);
-        SetTriggerMode(AUTO); // workaround to set trigModeSet_
+
+        // scope_->Initialize() selects AUTO: record it rather than follow the reset
+        //  with a command that would have to wait for it to finish
+        trigMode_    = AUTO;
+        trigModeSet_ = true;
 
     } catch(StationBaseException& error) {
         locked_ = true; 
@@ -843,6 +860,52 @@ void Oscilloscope::Stop() {
     stopped_ = true;
 }
 
+//==========
+// Upload()
+//==========
+const Oscilloscope::Waveform& Oscilloscope::Upload(Channel chan) {
+    // A running scope may re-trigger between the scaling and data queries
+    Assert<BadArg>(validChannel(chan), Name());
+    Assert<UnexpectedState>(stopped_, Name());
+    waitOnScope();
+    if ( waveSource_ != chan ) {
+        waveSource_ = OScopeChannels::ALL;
+        syntax_ = scope_->WaveformSource(chan);
+        Assert<InstrumentError>(command(), Name());
+        waveSource_ = chan;
+    }
+    syntax_ = scope_->WaveformScaling(chan);
+    OScopeInterface::WaveformScale scale = scope_->WaveformScaling(query());
+
+    Assert<InstrumentError>(!(concatenate_ || locked_), Name());
+    BusBlock block = Instrument<BT>::queryBlockInstr(address_, 
+                                                     scope_->WaveformData(chan));
+    long width = scale.BytesPerSample;
+    Assert<ScopeMeasureError>((width == 1) || (width == 2), Name());
+    Assert<ScopeMeasureError>((block.Size > 0) && (block.Size % width == 0), Name());
+
+    // Decode straight from the bus buffer
+    long points = block.Size / width;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(block.Data);
+    const long range = 1L << (8 * width);
+    waveform_.Volts.resize(points);
+    waveform_.Clipped = false;
+    for ( long idx = 0; idx < points; ++idx, data += width ) {
+        long code = data[0];
+        if ( 2 == width ) // most significant byte first
+            code = (code << 8) | data[1];
+        if ( scale.IsSigned && (code >= range / 2) )
+            code -= range;
+        if ( (code <= scale.MinCode) || (code >= scale.MaxCode) )
+            waveform_.Clipped = true;
+        waveform_.Volts[idx] = (code - scale.YReference) * scale.YIncrement + 
+                                                                      scale.YOrigin;
+    } // for
+    waveform_.Interval = scale.XIncrement;
+    waveform_.Start    = scale.XOrigin - (scale.XReference * scale.XIncrement);
+    return(waveform_);
+}
+
 //================
 // validChannel()
 //================
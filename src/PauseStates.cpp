@@ -8,12 +8,32 @@
 #include "ScaleUnits.h"
 #include "SingletonType.h"
 #include "SPTSException.h"
+#include "StringAlgorithms.h"
 
 
 //=====================================================================================//
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added settle learning.  With "Settle Learning" set to LEARN or APPLY in the pause
+       file, callers sample readings at SettlePoints() through a pause and hand the
+       curve to AddSettleCurve().  The time each curve settles is kept per pause type
+       and family in "<pause file>.settle".  ProposedPauseValue() is the longest
+       settle time seen times a safety margin, once enough runs are in.  In APPLY
+       mode GetPauseValue() returns the proposal when it is shorter than the
+       configured value.  Without learned data, the configured values are used.
+     Only LEARN mode samples through pauses (IsLearning()); APPLY pauses once.
+       AddSettleCurve() no longer writes the ".settle" file:  SaveSettleCurves()
+       writes it once per DUT and the caller decides what a failed write means.
+       settleTime() fits only readings that differ from the final one --> readings
+       quantized to the final value no longer reach std::log(0).
+     Families without their own pause file share the default pauses but not their
+       learned settle times:  those go to "<default pause file>.<family>.settle",
+       so one family's curves never shorten another's pauses in APPLY mode.
+
    ==============
    11/14/05, sjn,
    ==============
@@ -35,7 +55,81 @@ namespace {
     typedef StationExceptionTypes::FileError   FileError;
     typedef StationExceptionTypes::NoFileFound NoFileFound;
     typedef StationExceptionTypes::OutOfRange  OutOfRange;
-}
+
+    typedef ProgramTypes::MType   MType;
+    typedef ProgramTypes::SetType SetType;
+
+    // Pause file parameter selecting the settle learning mode
+    const std::string SETTLELEARNING = "Settle Learning";
+
+    // Sample points through a pause while learning, as fractions of the pause
+    const double SETTLEFRACTIONS[] = { 0.1, 0.2, 0.35, 0.5, 0.75, 1.0 };
+    const std::size_t NUMSETTLEFRACTIONS = 
+                              sizeof(SETTLEFRACTIONS) / sizeof(SETTLEFRACTIONS[0]);
+
+    // Settled means within this fraction of the final reading, or SETTLEFLOOR
+    const double SETTLETOLERANCE = 1e-3;
+    const double SETTLEFLOOR     = 1e-4;
+
+    // Runs needed before a learned pause is proposed, and its safety margin
+    const long   MINSETTLERUNS = 5;
+    const double SETTLEMARGIN  = 1.5;
+
+    //============
+    // fileSafe()
+    //============
+    std::string fileSafe(const std::string& s) {
+        // Family numbers as part of a file name --> anything odd becomes '_'
+        std::string toRtn = s;
+        for ( std::string::size_type idx = 0; idx < toRtn.size(); ++idx ) {
+            char c = toRtn[idx];
+            if ( !isalnum(static_cast<unsigned char>(c)) && (c != '-') )
+                toRtn[idx] = '_';
+        } // for
+        return(toRtn);
+    }
+
+    //==============
+    // settleTime()
+    //==============
+    double settleTime(const PauseStates::SettleCurve& curve) {
+        // Earliest sample time from which every reading stays within tolerance of
+        //  the final reading.  A first-order fit of the earlier, unsettled errors
+        //  may predict a later time than the sampling shows --> keep the later.
+        double last = curve.back().second.Value();
+        double tolerance = std::max(std::fabs(last) * SETTLETOLERANCE, SETTLEFLOOR);
+        std::size_t k = curve.size() - 1;
+        while ( (k > 0) && (std::fabs(curve[k-1].second.Value() - last) <= tolerance) )
+            --k;
+        double toRtn = curve[k].first.Value();
+        if ( k < 2 )
+            return(toRtn);
+
+        // Least squares fit of ln(error) = a + b * t --> b = -1/tau.  Quantized
+        //  readings may equal the final one early on --> no error to fit there.
+        double sumT = 0, sumL = 0, sumTT = 0, sumTL = 0, n = 0;
+        for ( std::size_t idx = 0; idx < k; ++idx ) {
+            double error = std::fabs(curve[idx].second.Value() - last);
+            if ( error <= 0 )
+                continue;
+            double t = curve[idx].first.Value();
+            double l = std::log(error);
+            sumT += t; sumL += l; sumTT += t * t; sumTL += t * l; ++n;
+        } // for
+        double denom = n * sumTT - sumT * sumT;
+        if ( (n < 2) || (denom <= 0) )
+            return(toRtn);
+        double b = (n * sumTL - sumT * sumL) / denom;
+        double a = (sumL - b * sumT) / n;
+        if ( b >= 0 ) // not decaying --> nothing to predict
+            return(toRtn);
+        double predicted = (std::log(tolerance) - a) / b;
+        double longest = curve.back().first.Value();
+        if ( predicted > longest )
+            predicted = longest;
+        return(std::max(toRtn, predicted));
+    }
+} // unnamed namespace
 
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
@@ -48,9 +142,27 @@ namespace {
 PauseStates::PauseStates() 
                   : familyNumber_(""), 
                     defaultFile_(new FileTypes::PauseFileType("Default Pause File")),
-                    name_("Pause States File") 
+                    mode_(NOSETTLE), unsaved_(false), name_("Pause States File") 
 { /* */ }
 
+//==================
+// AddSettleCurve()
+//==================
+void PauseStates::AddSettleCurve(PauseTypes type, const SettleCurve& curve) {
+    Assert<BadArg>(! curve.empty(), name_);
+    checkForNewDUT();
+    SetType settled = settleTime(curve);
+    LearnedType::iterator find = learned_.find(type);
+    if ( find == learned_.end() )
+        learned_.insert(std::make_pair(type, std::make_pair(1L, settled)));
+    else {
+        ++find->second.first;
+        if ( settled > find->second.second )
+            find->second.second = settled;
+    }
+    unsaved_ = true; // see SaveSettleCurves()
+}
+
 //==================
 // checkForNewDUT()
 //==================
@@ -58,6 +170,10 @@ void PauseStates::checkForNewDUT() {
     std::string famNumber = SingletonType<Converter>::Instance()->FamilyNumber();
     if ( famNumber == familyNumber_ ) // no change
         return;
+    try { // last family's curves, if its DUT's SaveSettleCurves() failed
+        SaveSettleCurves();
+    } catch(...) { /* reported when SaveSettleCurves() failed */ }
+    unsaved_ = false;
     familyNumber_ = famNumber;
 
     // Throws NoFileFound if no specific pauses for this (familyNumber_)
@@ -77,9 +193,11 @@ void PauseStates::checkForNewDUT() {
 //===========================
 ProgramTypes::SetType PauseStates::GetPauseValue(PauseTypes type) {    
     checkForNewDUT();
-    MapType::iterator find = map_->find(type);
-	Assert<BadArg>(find != map_->end(), name_);
-    return(find->second);
+    SetType value = configured(type);
+    if ( mode_ != APPLYSETTLE )
+        return(value);
+    SetType proposed = ProposedPauseValue(type);
+    return((proposed < value) ? proposed : value);
 }
 
 //===========================
@@ -94,6 +212,66 @@ ProgramTypes::SetType PauseStates::GetPauseValue(StationPauses type) {
         return(1); // Defined through experimentation
 }
 
+//==============
+// IsLearning()
+//==============
+bool PauseStates::IsLearning() {
+    // Only LEARN samples through pauses; APPLY uses what was learned
+    checkForNewDUT();
+    return(mode_ == LEARNSETTLE);
+}
+
+//======================
+// ProposedPauseValue()
+//======================
+ProgramTypes::SetType PauseStates::ProposedPauseValue(PauseTypes type) {
+    // The configured value until there is enough evidence to replace it
+    checkForNewDUT();
+    LearnedType::iterator find = learned_.find(type);
+    if ( (find == learned_.end()) || (find->second.first < MINSETTLERUNS) )
+        return(configured(type));
+    return(find->second.second.Value() * SETTLEMARGIN);
+}
+
+//====================
+// SaveSettleCurves()
+//====================
+void PauseStates::SaveSettleCurves() {
+    // Once per DUT --> throws FileError if the ".settle" file cannot be written;
+    //  curves are kept and written with the next DUT's
+    if ( ! unsaved_ )
+        return;
+    std::ofstream out(learnedPath_.c_str());
+    Assert<FileError>(out.is_open(), name_);
+    MapStringType names = getString();
+    LearnedType::iterator i = learned_.begin();
+    while ( i != learned_.end() ) {
+        out << i->second.second.Value() << " " << i->second.first << " " 
+            << names[i->first] << std::endl;
+        ++i;
+    }
+    out.close();
+    Assert<FileError>(! out.fail(), name_);
+    unsaved_ = false;
+}
+
+//================
+// SettlePoints()
+//================
+std::vector<ProgramTypes::SetType> PauseStates::SettlePoints(PauseTypes type) {
+    // Seconds after a state change at which to sample while learning --> the last
+    //  is the configured pause itself
+    SetType value = configured(type);
+    std::vector<SetType> toRtn;
+    if ( value <= SetType(0) ) {
+        toRtn.push_back(value);
+        return(toRtn);
+    }
+    for ( std::size_t idx = 0; idx < NUMSETTLEFRACTIONS; ++idx )
+        toRtn.push_back(value.Value() * SETTLEFRACTIONS[idx]);
+    return(toRtn);
+}
+
 //===========================
 // SupplyCCModeChangePause()
 //===========================
@@ -103,6 +281,16 @@ ProgramTypes::SetType
     return(ifile->SupplyCCModeChangePause(whichSupply));
 }
 
+//==============
+// configured()
+//==============
+ProgramTypes::SetType PauseStates::configured(PauseTypes type) {
+    checkForNewDUT();
+    MapType::iterator find = map_->find(type);
+	Assert<BadArg>(find != map_->end(), name_);
+    return(find->second);
+}
+
 //=============
 // getString()
 //=============
@@ -128,6 +316,37 @@ PauseStates::MapStringType PauseStates::getString() {
     return(toRtn);
 }
 
+//===============
+// loadLearned()
+//===============
+void PauseStates::loadLearned() {
+    // Lines of "<longest settle seconds> <runs> <pause name>" --> none is fine
+    learned_.clear();
+    std::ifstream in(learnedPath_.c_str());
+    if ( ! in )
+        return;
+    MapStringType names = getString();
+    std::string line;
+    while ( std::getline(in, line) ) {
+        std::stringstream s(line);
+        double seconds = 0;
+        long runs = 0;
+        std::string pauseName;
+        if ( ! (s >> seconds >> runs) )
+            continue;
+        std::getline(s, pauseName);
+        RemoveFrontBackSpace(pauseName);
+        MapStringType::iterator i = names.begin();
+        while ( i != names.end() ) {
+            if ( Uppercase(i->second) == Uppercase(pauseName) ) {
+                learned_[i->first] = std::make_pair(runs, SetType(seconds));
+                break;
+            }
+            ++i;
+        }
+    } // while
+}
+
 //============
 // loadType()
 //============
@@ -155,6 +374,26 @@ void PauseStates::loadType(Types t) {
         map_->insert(std::make_pair(i->first, value));
         ++i;
     }
+
+    // Settle learning is off unless called out
+    std::string mode;
+    if ( t == SPECIFIC )
+        mode = pf_->GetValue(SETTLELEARNING);
+    if ( mode.empty() )
+        mode = defaultFile_->GetValue(SETTLELEARNING);
+    mode = Uppercase(mode);
+    RemoveFrontBackSpace(mode);
+    if ( mode == "LEARN" )
+        mode_ = LEARNSETTLE;
+    else if ( mode == "APPLY" )
+        mode_ = APPLYSETTLE;
+    else
+        mode_ = NOSETTLE;
+    if ( t == SPECIFIC )
+        learnedPath_ = pf_->Path() + ".settle";
+    else // the default file serves many families --> keep each one's apart
+        learnedPath_ = defaultFile_->Path() + "." + fileSafe(familyNumber_) + ".settle";
+    loadLearned();
 }
 
 /***************************************************************************************/
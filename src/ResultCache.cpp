@@ -0,0 +1,173 @@
+// Files included
+#include "Assertion.h"
+#include "ResultCache.h"
+#include "SPTSException.h"
+#include "StringAlgorithms.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    typedef ProgramTypes::MType   MType;
+    typedef ProgramTypes::SetType SetType;
+
+    // Prime number of buckets --> a sequence stores a few hundred values at most
+    const std::size_t NUMBUCKETS = 211;
+
+    // FNV-1a
+    const unsigned long FNVBASIS = 2166136261UL;
+    const unsigned long FNVPRIME = 16777619UL;
+
+    void hashBytes(unsigned long& h, const void* data, std::size_t sz) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for ( std::size_t idx = 0; idx < sz; ++idx ) {
+            h ^= p[idx];
+            h = (h * FNVPRIME) & 0xFFFFFFFFUL;
+        }
+    }
+
+    void hashValue(unsigned long& h, double d) {
+        d += 0.0; // -0.0 and 0.0 compare equal --> must hash equal
+        hashBytes(h, &d, sizeof(d));
+    }
+
+    void hashValue(unsigned long& h, long l) {
+        hashBytes(h, &l, sizeof(l));
+    }
+
+    void hashValue(unsigned long& h, const std::string& s) {
+        hashBytes(h, s.data(), s.size());
+        hashValue(h, static_cast<long>(s.size()));
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+ResultCache::ResultCache() : buckets_(NUMBUCKETS), temperature_(0),
+                             hits_(0), misses_(0), size_(0)
+{ /* */ }
+
+//============
+// Destructor
+//============
+ResultCache::~ResultCache()
+{ /* */ }
+
+//=========
+// Clear()
+//=========
+void ResultCache::Clear(const SetType& temperature) {
+    // Statistics are kept --> only stored values are dropped
+    std::vector<Bucket>::iterator i = buckets_.begin();
+    while ( i != buckets_.end() )
+        (i++)->clear();
+    temperature_ = temperature.Value();
+    size_ = 0;
+}
+
+//========
+// Find()
+//========
+std::pair<bool, MType> ResultCache::Find(const TestStepInfo& current,
+                                         SPTSMeasurement::Measurement* toMeasure) {
+    Assert<BadArg>(toMeasure != 0, Name());
+    TestStepInfo::CondPtr cptr = current;
+    TestStepInfo::TSPtr tptr = current;
+    std::string measure = Uppercase(tptr->SoftwareTestName());
+    unsigned long k = key(measure, cptr);
+    Bucket& b = buckets_[k % NUMBUCKETS];
+    Bucket::iterator i = b.begin();
+    while ( i != b.end() ) {
+        if ( (i->Key == k) && (i->Channel == cptr->Channel()) &&
+             (i->Measure == measure) && toMeasure->DoneAlready(cptr, *i->Source) ) {
+            MType toRtn = i->Value;
+            b.erase(i); // don't reuse this value
+            --size_;
+            ++hits_;
+            return(std::make_pair(true, toRtn));
+        }
+        ++i;
+    } // while
+    ++misses_;
+    return(std::make_pair(false, MType(0)));
+}
+
+//========
+// Hits()
+//========
+long ResultCache::Hits() const {
+    return(hits_);
+}
+
+//==========
+// Insert()
+//==========
+void ResultCache::Insert(const std::string& measureName,
+                         ConverterOutput::Output channel, const MType& value,
+                         const TestStepInfo& source) {
+    Entry e;
+    e.Measure = Uppercase(measureName);
+    e.Key = key(e.Measure, source);
+    e.Channel = channel;
+    e.Value = value;
+    e.Source = &source;
+    buckets_[e.Key % NUMBUCKETS].push_back(e);
+    ++size_;
+}
+
+//=======
+// key()
+//=======
+unsigned long ResultCache::key(const std::string& measureName,
+                               TestStepInfo::CondPtr cptr) const {
+    // Conditions::Hash() covers only what every beenDone() implementation
+    //  compares --> anything finer is left to DoneAlready() so no reuse is lost
+    unsigned long h = FNVBASIS;
+    hashValue(h, measureName);
+    hashValue(h, temperature_);
+    hashValue(h, static_cast<long>(cptr->Hash()));
+    return(h);
+}
+
+//==========
+// Misses()
+//==========
+long ResultCache::Misses() const {
+    return(misses_);
+}
+
+//========
+// Name()
+//========
+std::string ResultCache::Name() const {
+    return("Result Cache");
+}
+
+//========
+// Size()
+//========
+long ResultCache::Size() const {
+    return(size_);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
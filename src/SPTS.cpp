@@ -1,6 +1,7 @@
 // Files included
 #include "Assertion.h"
 #include "ConfigureRelays.h"
+#include "ErrorLogger.h"
 #include "TestFixtureFile.h"
 #include "Functions.h"
 #include "GenericAlgorithms.h"
@@ -19,6 +20,47 @@
 /*
    
    
+   ================
+   10/19/26, agent,
+   ================
+     Initialize() starts the scope, DMM and function generator resets as soon as the
+       AuxSupply rails are up.  Each is a single command that the instrument carries
+       out on its own while the relay controllers, load, main supply, temperature
+       controller, current probe and switch matrix are set up; the scope's first
+       follow-up (SetScope(ALL, ON)) comes last.  Reset() resets those three first
+       for the same reason.  Per-instrument Initialize() times are kept and
+       returned by GetStartupTimes(), with the scope's follow-up as "... ready".
+       Instrument<>::getAddress() now opens each bus handle, so every handle is open
+       once the instruments are constructed.
+     Added BeginPathChange(), CommitPathChange() and AbortPathChange().  Path changes
+       made in between are sent to the switch matrix as one command per card and
+       share a single relay settling pause, paid at CommitPathChange().  Control
+       matrix relays are not queued:  switch matrix changes queued before one are
+       sent first (flushPathChange()), so relays still change in the order asked
+       for --> e.g. the sync out line is released only once the scope path is open.
+       Transactions nest; only the outermost one commits.  An inner AbortPathChange()
+       marks the change aborted (pathAborted_) --> the outermost commit or abort
+       drops what is still queued.
+     SetSync() sends its function generator settings, and SetVin() its supply
+       settings, as one transaction each.
+     SetVin() learns the supply and fixture droop versus operating state (vinModel_)
+       when Vin is checked with the DMM, and sets a corrected supply value up front.
+       The DMM check moved to settleVin(): it holds the Vin path for the whole check
+       rather than switching relays per reading, and finishes as soon as a reading is
+       within accuracy.  Once a window of readings (VinModel::IsSettled()) agrees
+       within the supply's resolution, a settled reading off target is learned and
+       corrected in one step, by no more than the droop measured plus tolerance.
+       vinState() keys the model on the supply's current limit and on whether the
+       DUT may be in dropout (Vin below low line) as well.
+     newDUTSetup() clears vinModel_.  GetVin() and PowerDown() report the Vin asked
+       for rather than a droop-corrected supply setpoint.
+     Added GetSuppressedCommands() --> per-instrument counts of settings not resent
+       because the instrument already had them.  IsError() invalidates every
+       instrument's shadow (invalidateShadows()) whenever any error is seen, since
+       its else-if chain stops at the first instrument reporting one.
+     WhatError() tells ErrorLogger (SetInstrument()) which instrument is in error.
+     Added UploadScope() --> a held waveform in volts, for analysis in software.
+
    =================
    03/27/06, HQP,FAC
    =================
@@ -205,6 +247,12 @@ namespace { // unnamed
 
     // DUT Exceptions
     typedef DUTExceptionTypes::SevereOscillation SevereOscillation;
+
+    // Largest droop correction SetVin() applies, as a fraction of the Vin asked for
+    const double MAXVINCORRECTION = 0.05;
+
+    // Conservative DMM accuracy estimate (volts) used when verifying Vin
+    const double DMMVINACCURACY = 10e-3;
 } // unnamed
 
 /***************************************************************************************/
@@ -437,8 +485,10 @@ SPTS::SPTS()
       dMM_(0), scope_(0), tempControl_(0), funcGen_(0), currentProbe_(0), 
       mainSupply_(0), auxSupply_(0), pathOpen_(false), setShort_(true), locked_(true), 
       customReset_(false), pSpec_(false), poweredDown_(false), noReset_(false),
-      alwaysReset_(false), iinShunt_(StationFile::SMALLOHM), whatError_(""),
-      lastVin_(-1), dut_(0), errorInstr_(InstrumentTypes::PS3), name_(Name())
+      alwaysReset_(false), pathAborted_(false), pathDepth_(0), pathPending_(false),
+      iinShunt_(StationFile::SMALLOHM), whatError_(""), lastVin_(-1),
+      vinSet_(SetType(-1), SetType(-1)), dut_(0), errorInstr_(InstrumentTypes::PS3),
+      name_(Name())
 { /* */ }
 
 //============
@@ -447,6 +497,53 @@ SPTS::SPTS()
 SPTS::~SPTS() 
 { /* */ }
 
+//===================
+// AbortPathChange()
+//===================
+void SPTS::AbortPathChange() {
+    // Drop any queued switch matrix changes --> nothing was sent for them.  Nested
+    //  --> only mark the change aborted; the outermost level drops it.
+    if ( pathDepth_ > 0 )
+        --pathDepth_;
+    pathAborted_ = true;
+    if ( pathDepth_ > 0 )
+        return;
+    pathAborted_ = false;
+    pathPending_ = false;
+    if ( (switchMatrix_.get() != 0) && switchMatrix_->InTransaction() )
+        switchMatrix_->AbortTransaction();
+}
+
+//===================
+// BeginPathChange()
+//===================
+void SPTS::BeginPathChange() {
+    Assert<UnexpectedState>(!locked_, name_);
+    if ( pathDepth_++ == 0 ) {
+        pathAborted_ = false;
+        pathPending_ = false;
+        switchMatrix_->BeginTransaction();
+    }
+}
+
+//====================
+// CommitPathChange()
+//====================
+void SPTS::CommitPathChange() {
+    Assert<UnexpectedState>(pathDepth_ > 0, name_);
+    if ( --pathDepth_ > 0 ) // outermost transaction pays the pause
+        return;
+    if ( pathAborted_ ) { // an inner level aborted --> send nothing
+        AbortPathChange();
+        return;
+    }
+    bool changed = switchMatrix_->CommitTransaction();
+    if ( changed || pathPending_ ) {
+        pathPending_ = false;
+        setPathPause();
+    }
+}
+
 //===========================
 // Convert2ConverterOutput()
 //===========================
@@ -650,6 +747,20 @@ void SPTS::EmergencyShutdown(bool resetTemp, const SetType& offset) {
     locked_ = true; // Can call Initialize() now
 }
 
+//===================
+// flushPathChange()
+//===================
+void SPTS::flushPathChange() {
+    // A control matrix relay is about to change --> send switch matrix changes
+    //  queued so far first, keeping the order asked for.  Only the settling pause
+    //  is left to CommitPathChange(); an abort after this drops only later changes.
+    if ( (0 == pathDepth_) || pathAborted_ || !switchMatrix_->InTransaction() )
+        return;
+    if ( switchMatrix_->CommitTransaction() )
+        pathPending_ = true;
+    switchMatrix_->BeginTransaction();
+}
+
 //========================
 // GetCurrentProbeScale()
 //========================
@@ -819,6 +930,27 @@ SPTS::SetType SPTS::GetScopeVertScale(OScopeChannels::Channel chan) const {
     return(scope_->GetVertScale(chan));
 }
 
+//===================
+// GetStartupTimes()
+//===================
+const SPTS::StartupTimes& SPTS::GetStartupTimes() const {
+    return(startupTimes_);
+}
+
+//=========================
+// GetSuppressedCommands()
+//=========================
+SPTS::SuppressedCommands SPTS::GetSuppressedCommands() const {
+    SuppressedCommands toRtn;
+    toRtn.push_back(std::make_pair(mainSupply_->Name(), 
+                                   mainSupply_->SuppressedCommands()));
+    toRtn.push_back(std::make_pair(auxSupply_->Name(), 
+                                   auxSupply_->SuppressedCommands()));
+    toRtn.push_back(std::make_pair(dMM_->Name(), dMM_->SuppressedCommands()));
+    toRtn.push_back(std::make_pair(funcGen_->Name(), funcGen_->SuppressedCommands()));
+    return(toRtn);
+}
+
 //==========================
 // GetTemperatureSetpoint()
 //==========================
@@ -834,7 +966,8 @@ ProgramTypes::SetType SPTS::GetTemperatureSetpoint() const {
 ProgramTypes::SetType SPTS::GetVin() const {	
     if ( ! mainSupply_->IsOn() )
         return(0);
-	return(mainSupply_->GetVolts());
+    SetType volts = mainSupply_->GetVolts(); // may include a droop correction
+	return((volts == vinSet_.first) ? vinSet_.second : volts);
 }
 
 //==============
@@ -862,6 +995,8 @@ void SPTS::Initialize(bool resetTemp) {
             toChange = true;
         } 
         locked_ = false;
+        startupTimes_.clear();
+        std::clock_t start = std::clock();
         auxSupply_->Initialize();
         SetAPS(APS::SYSTEM5V, ON);
         SetAPS(APS::SYSTEM12V, ON);
@@ -873,27 +1008,51 @@ void SPTS::Initialize(bool resetTemp) {
         SetAPS(APS::SYSTEM12V, APS::CURRENT, APS::MAX);
         SetAPS(APS::PRIMARY, APS::CURRENT, APS::MAX);
         SetAPS(APS::SECONDARY, APS::CURRENT, APS::MAX);
-        inputRelays_->Underlying()->Initialize(); 
-        newDUTSetup(); // other member vars - instruments - taken care of here              
+        startupTime(auxSupply_->Name(), start);
+
+        // With the rails up, start the slowest resets: the scope, DMM and function
+        //  generator each take their whole initialization as one command and carry
+        //  it out on their own.  The scope's first follow-up command comes last.
+        start = std::clock();
         scope_->AddScopeChannel(OScopeChannels::ONE);
         scope_->AddScopeChannel(OScopeChannels::TWO);
         scope_->AddScopeChannel(OScopeChannels::THREE);
         scope_->AddScopeChannel(OScopeChannels::TRIGGER);
         scope_->Initialize();
-        SetScope(OScopeChannels::ALL, ON);
+        startupTime(scope_->Name(), start);
+        start = std::clock();
         dMM_->Initialize();
+        startupTime(dMM_->Name(), start);
+        start = std::clock();
+        funcGen_->Initialize();
+        startupTime(funcGen_->Name(), start);
+
+        start = std::clock();
+        inputRelays_->Underlying()->Initialize(); 
+        startupTime(inputRelays_->Underlying()->Name(), start);
+        start = std::clock();
+        newDUTSetup(); // other member vars - instruments - taken care of here              
+        startupTime(load_->Name() + ", " + mainSupply_->Name(), start);
         if ( resetTemp || (tempControl_.get() == 0) ) {
+            start = std::clock();
             tempControl_.reset(new TemperatureController);
             tempControl_->Initialize();
             setTemperatureBaseLimits();            
+            startupTime(tempControl_->Name(), start);
         }
-        funcGen_->Initialize();
+        start = std::clock();
         currentProbe_->Initialize();
+        startupTime(currentProbe_->Name(), start);
+        start = std::clock();
         inputRelays_->Initialize();
         outputRelays_->Initialize();
         switchMatrix_->Initialize();
         if ( miscLines_.get() != 0 )
             miscLines_->Initialize();
+        startupTime(switchMatrix_->Name(), start);
+        start = std::clock();
+        SetScope(OScopeChannels::ALL, ON); // waits out whatever is left of the reset
+        startupTime(scope_->Name() + " ready", start);
         alwaysReset_ = true;
         ResetPath();
         alwaysReset_ = false;
@@ -905,6 +1064,17 @@ void SPTS::Initialize(bool resetTemp) {
     }
 } 
 
+//=====================
+// invalidateShadows()
+//=====================
+void SPTS::invalidateShadows() {
+    // An error anywhere may have upset instruments other than the one reporting it
+    mainSupply_->InvalidateShadow();
+    auxSupply_->InvalidateShadow();
+    dMM_->InvalidateShadow();
+    funcGen_->InvalidateShadow();
+}
+
 //===========
 // IsError()
 //===========
@@ -992,6 +1162,8 @@ bool SPTS::IsError() {
             errorInstr_ = InstrumentTypes::MISC;
         }        
     }
+    if ( result )
+        invalidateShadows();
     return(result);
 }
 
@@ -1243,6 +1415,7 @@ void SPTS::newDUTSetup() {
     load_->Initialize();    
     mainSupply_->Initialize();
     mainSupply_->OutputOn();
+    vinModel_.Clear(); // new fixture wiring and DUT
 }
 
 //===============
@@ -1423,7 +1596,8 @@ void SPTS::partSpecific() {
 void SPTS::PowerDown() {
     // Load, then Power Supply
     SetLoad(LoadTraits::ALL, OFF);
-    lastVin_ = mainSupply_->GetVolts();
+    SetType volts = mainSupply_->GetVolts(); // may include a droop correction
+    lastVin_ = (volts == vinSet_.first) ? vinSet_.second : volts;
     SetVin(static_cast<SetType>(0));
     poweredDown_ = true;
 }
@@ -1514,86 +1688,88 @@ bool SPTS::Reset(bool resetController) {
     std::string stationError = "";
     bool toAssert = true;
     try {
+        // Slowest resets first: each is one command, carried out by the scope, DMM
+        //  and function generator on their own while the rest are reset
         try {
-            Assert<InstrumentError>(load_->Reset(), load_->Name());
+            Assert<InstrumentError>(scope_->Reset(), scope_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
-        } 
+        }
         try {
-            Assert<InstrumentError>(mainSupply_->Reset(), mainSupply_->Name());
+            Assert<InstrumentError>(dMM_->Reset(), dMM_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(switchMatrix_->Reset(), switchMatrix_->Name());
+            Assert<InstrumentError>(funcGen_->Reset(), funcGen_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(cm->Initialize(), cm->Name());
+            Assert<InstrumentError>(load_->Reset(), load_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
-        }
+        } 
         try {
-            Assert<InstrumentError>(inputRelays_->Reset(), inputRelays_->Name());
+            Assert<InstrumentError>(mainSupply_->Reset(), mainSupply_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(outputRelays_->Reset(), outputRelays_->Name());
+            Assert<InstrumentError>(switchMatrix_->Reset(), switchMatrix_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(auxSupply_->Reset(), auxSupply_->Name());
+            Assert<InstrumentError>(cm->Initialize(), cm->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(dMM_->Reset(), dMM_->Name());
+            Assert<InstrumentError>(inputRelays_->Reset(), inputRelays_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(currentProbe_->Reset(), currentProbe_->Name());     
+            Assert<InstrumentError>(outputRelays_->Reset(), outputRelays_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(scope_->Reset(), scope_->Name());
+            Assert<InstrumentError>(auxSupply_->Reset(), auxSupply_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
-        }        
+        }
         try {
-            if ( resetController )
-                Assert<InstrumentError>(tempControl_->Reset(), tempControl_->Name());
+            Assert<InstrumentError>(currentProbe_->Reset(), currentProbe_->Name());     
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
             stationError += " ";
         }
         try {
-            Assert<InstrumentError>(funcGen_->Reset(), funcGen_->Name());
+            if ( resetController )
+                Assert<InstrumentError>(tempControl_->Reset(), tempControl_->Name());
         } catch(StationBaseException& error) {
             toAssert = false;
             stationError += error.GetExceptionInfo();
@@ -1637,9 +1813,13 @@ void SPTS::resetMemberVariables() {
     locked_       = false;
     whatError_    = "";
     pathOpen_     = false;
+    pathAborted_  = false;
+    pathDepth_    = 0;
+    pathPending_  = false;
     setShort_     = true;
     poweredDown_  = false;
     lastVin_      = -1;
+    vinSet_       = std::make_pair(SetType(-1), SetType(-1));
     iinShunt_     = StationFile::BIGOHM;
 }
 
@@ -1839,6 +2019,7 @@ void SPTS::ResetPath() {
         switchMatrix_->CustomReset(SwitchMatrix::RF);
         switchMatrix_->CustomReset(SwitchMatrix::FILTER);
         switchMatrix_->CustomReset(SwitchMatrix::DC);
+        flushPathChange(); // inside a path change --> matrix before misc lines
         if ( miscChange )
             miscLines_->CustomReset();
         SafeInhibit(OFF);
@@ -2452,6 +2633,8 @@ void SPTS::SetPath(ACPathTypes::ExplicitPaths exPath, FilterSelects::FilterType
 
 	// Set or Reset SIM and fixture relays
     reset1 = false, reset2 = false;
+    if ( !(inputBoxRelays.empty() && outputBoxRelays.empty()) )
+        flushPathChange();
 	if ( pathOpen_ ) { // pathOpen_ set from inside ResetPath()
         if ( ! inputBoxRelays.empty() )
 		    reset1 = inputRelays_->TurnOff(inputBoxRelays);
@@ -2476,6 +2659,7 @@ void SPTS::SetPath(ACPathTypes::ExplicitPaths exPath, FilterSelects::FilterType
 //=====================
 void SPTS::SetPath(ControlMatrixTraits::RelayTypes::MiscRelay relay) {
     Assert<UnexpectedState>(miscLines_.get() != 0, name_);
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = miscLines_->TurnOff(relay);       
@@ -2489,6 +2673,7 @@ void SPTS::SetPath(ControlMatrixTraits::RelayTypes::MiscRelay relay) {
 // SetPath() Overload4
 //=====================
 void SPTS::SetPath(ControlMatrixTraits::RelayTypes::InputRelay relay) {
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = inputRelays_->TurnOff(relay);
@@ -2502,6 +2687,7 @@ void SPTS::SetPath(ControlMatrixTraits::RelayTypes::InputRelay relay) {
 // SetPath() Overload5
 //=====================
 void SPTS::SetPath(ControlMatrixTraits::RelayTypes::OutputRelay relay) {
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = outputRelays_->TurnOff(relay);
@@ -2521,6 +2707,7 @@ void SPTS::SetPath(const std::vector<ControlMatrixTraits::RelayTypes::MiscRelay>
     Assert<UnexpectedState>(miscLines_.get() != 0, name_);
     ControlMatrix::Misc::MiscContainer r;
     std::copy(relays.begin(), relays.end(), std::back_inserter(r));
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = miscLines_->TurnOff(r);
@@ -2537,6 +2724,7 @@ void SPTS::SetPath(const std::vector<ControlMatrixTraits::RelayTypes::InputRelay
 {
     ControlMatrix::InputRelayControl::RelayContainer r;
     std::copy(relays.begin(), relays.end(), std::back_inserter(r));
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = inputRelays_->TurnOff(r);
@@ -2553,6 +2741,7 @@ void SPTS::SetPath(const std::vector<ControlMatrixTraits::RelayTypes::OutputRela
                                                                             relays) {
     ControlMatrix::OutputRelayControl::RelayContainer r;
     std::copy(relays.begin(), relays.end(), std::back_inserter(r));
+    flushPathChange();
     bool reset = false;
     if ( pathOpen_ )
         reset = outputRelays_->TurnOff(r);
@@ -2610,10 +2799,23 @@ void SPTS::setPath(ACPathTypes::ImplicitPaths impPath, ConverterOutput::Output c
 	SetPath(Convert2ExplicitPath(impPath, chan), bw); 
 }
 
+//===============
+// startupTime()
+//===============
+void SPTS::startupTime(const std::string& instrName, std::clock_t start) {
+    // std::clock() is wall time under the Microsoft runtime
+    double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    startupTimes_.push_back(std::make_pair(instrName, seconds));
+}
+
 //================
 // setPathPause()
 //================
 void SPTS::setPathPause() {    
+    if ( pathDepth_ > 0 ) { // paid once by CommitPathChange()
+        pathPending_ = true;
+        return;
+    }
     if ( !noReset_ ) {
         PauseStates* ps = SingletonType<PauseStates>::Instance();
         Pause(ps->GetPauseValue(PauseStates::RELAYSTATECHANGE));
@@ -2831,10 +3033,17 @@ void SPTS::SetSync(const ProgramTypes::SetType& freq, const ProgramTypes::SetTyp
     r.push_back(ControlMatrixTraits::RelayTypes::SYNCENABLE);
     r.push_back(ControlMatrixTraits::RelayTypes::SYNCIN);
     SetPath(r);
-    funcGen_->SetAmplitude(ampl);
-    funcGen_->SetDutyCycle(dc);
-    funcGen_->SetOffset(offset);
-    funcGen_->SetFrequency(freq);
+    funcGen_->BeginTransaction();
+    try {
+        funcGen_->SetAmplitude(ampl);
+        funcGen_->SetDutyCycle(dc);
+        funcGen_->SetOffset(offset);
+        funcGen_->SetFrequency(freq);
+        Assert<InstrumentError>(funcGen_->CommitTransaction(), name_);
+    } catch(...) {
+        funcGen_->AbortTransaction();
+        throw;
+    }
 }
 
 //======================
@@ -2854,6 +3063,67 @@ void SPTS::setTemperatureBaseLimits() {
     tempControl_->SetTemperatureLimits(min, max);
 }
 
+//=============
+// settleVin()
+//=============
+void SPTS::settleVin(const SetType& vinValue, SetType setpoint) {
+    /*
+       Wait on the DMM for Vin to reach vinValue at the DUT.  Done as soon as a
+        reading is within accuracy.  Otherwise, once a window of readings agrees
+        within the supply's resolution the supply has stopped moving: what is left
+        is droop --> learn it and correct the supply setpoint in one step, by no
+        more than the droop just measured (plus tolerance).
+       The Vin path is held for the whole check rather than switched per reading.
+    */
+    static SetType zero = static_cast<SetType>(0);
+    typedef SwitchMatrixTraits::RelayTypes SMR;
+
+    const MType multiplier = SingletonType<TestFixtureFile>::Instance()->VinMultiplier();
+    const MType tolerance = mainSupply_->GetAccuracy() + MType(DMMVINACCURACY);
+    const SetType resolution = mainSupply_->GetResolution();
+    const SetType maxCorrection = vinValue * MAXVINCORRECTION;
+    const std::string state = vinState(vinValue);
+    const bool canCorrect = (vinValue > zero);
+
+    SetPath(SMR::INPUTVOLTAGE);
+    SetDMM(dut_->HighestVinSeen() / multiplier.Value());
+    try {
+        long counter = -1, maxCounter = 50;
+        std::vector<MType> readings; // since the last setpoint change
+        while ( true ) {
+            Assert<MainSupplyTimeout>(++counter < maxCounter, Name());
+            MType latest = MeasureDCV() * multiplier;
+            readings.push_back(latest);
+            if ( absolute(MType(latest.Value() - vinValue.Value())) <= tolerance )
+                break; // in tolerance
+            if ( !vinModel_.IsSettled(readings, resolution) )
+                continue; // still slewing
+
+            // Settled off target --> learn the droop and correct the setpoint
+            if ( canCorrect && (latest > MType(0)) ) {
+                vinModel_.Learn(state, setpoint, latest);
+                double droop = std::fabs(setpoint.Value() - latest.Value());
+                SetType cap = droop + tolerance.Value();
+                if ( cap > maxCorrection )
+                    cap = maxCorrection;
+                SetType next = vinModel_.Setpoint(state, vinValue, cap);
+                if ( next != setpoint ) {
+                    setpoint = next;
+                    Assert<InstrumentError>(mainSupply_->SetVolts(setpoint), name_);
+                    vinSet_.first = setpoint;
+                    readings.clear();
+                }
+            }
+        } // while
+    } catch(...) {
+        ResetPath(SMR::INPUTVOLTAGE);
+        SetDMM(); // To auto range
+        throw;
+    }
+    ResetPath(SMR::INPUTVOLTAGE);
+    SetDMM(); // To auto range
+}
+
 //==========
 // SetVin() 
 //==========
@@ -2871,9 +3141,18 @@ void SPTS::SetVin(const SetType& vinValue, bool canCheckWithDMM) {
     Assert<BadArg>(vinValue >= zero, name_);
 
     ProgramTypes::SetType current = mainSupply_->GetVolts();    
+    bool canTrustSupply = mainSupply_->CanTrustVoltsMeasure() || !canCheckWithDMM;
+    SetType setpoint = vinValue;
     if ( vinValue == zero ) { // Turn supply off if vinValue == 0
-        Assert<InstrumentError>(mainSupply_->OutputOff(), name_);
-        Assert<InstrumentError>(mainSupply_->SetVolts(vinValue), name_);
+        mainSupply_->BeginTransaction();
+        try {
+            Assert<InstrumentError>(mainSupply_->OutputOff(), name_);
+            Assert<InstrumentError>(mainSupply_->SetVolts(vinValue), name_);
+            Assert<InstrumentError>(mainSupply_->CommitTransaction(), name_);
+        } catch(...) {
+            mainSupply_->AbortTransaction();
+            throw;
+        }
     }
     else {
         poweredDown_ = false;
@@ -2895,30 +3174,45 @@ void SPTS::SetVin(const SetType& vinValue, bool canCheckWithDMM) {
             }
         }
 
+        // Only the DMM sees the droop between the supply and the DUT
+        if ( !canTrustSupply ) {
+            SetType maxCorrection = vinValue * MAXVINCORRECTION;
+            setpoint = vinModel_.Setpoint(vinState(vinValue), vinValue, 
+                                          maxCorrection);
+        }
+
         // Set voltage.  If supply is off, then turn on.
-        Assert<InstrumentError>(mainSupply_->SetVolts(vinValue), name_);
-        if ( !mainSupply_->IsOn() )
-            Assert<InstrumentError>(mainSupply_->OutputOn(), name_);
-        else if ( vinValue == current )
+        bool wasOn = mainSupply_->IsOn();
+        mainSupply_->BeginTransaction();
+        try {
+            Assert<InstrumentError>(mainSupply_->SetVolts(setpoint), name_);
+            if ( !wasOn )
+                Assert<InstrumentError>(mainSupply_->OutputOn(), name_);
+            Assert<InstrumentError>(mainSupply_->CommitTransaction(), name_);
+        } catch(...) {
+            mainSupply_->AbortTransaction();
+            throw;
+        }
+        vinSet_ = std::make_pair(setpoint, vinValue);
+        if ( wasOn && (setpoint == current) )
             return; // already there
     }
 
     // Ensure Vin is where we want it to be before leaving this routine
     //  This allows the station's algorithms to be less dependent upon 
     //  the speed of any power supply going from X volts to Y volts.
-    bool canTrustSupply = mainSupply_->CanTrustVoltsMeasure() || !canCheckWithDMM;
-    long counter = -1, maxCounter = 50;
-    MType voltValue = 0;
-    const MType n = mainSupply_->GetAccuracy();
-    MType m = n + MType(1);
-    while ( m > n ) {
-        MType voltValue = canTrustSupply ?
-                             mainSupply_->MeasureVolts() :
-                             MeasureVinDC();
-        m = absolute(MType(voltValue.Value() - vinValue.Value()));
-        m -= canTrustSupply ? 0 : 10e-3; /* conservative DMM acc. estimate */
-        Assert<MainSupplyTimeout>(++counter < maxCounter, Name());
-    } // while
+    if ( canTrustSupply ) {
+        long counter = -1, maxCounter = 50;
+        const MType n = mainSupply_->GetAccuracy();
+        MType m = n + MType(1);
+        while ( m > n ) {
+            MType voltValue = mainSupply_->MeasureVolts();
+            m = absolute(MType(voltValue.Value() - vinValue.Value()));
+            Assert<MainSupplyTimeout>(++counter < maxCounter, Name());
+        } // while
+    }
+    else
+        settleVin(vinValue, setpoint);
 
     // Grab Pause Value for power supply changes
     static PauseStates* ps = SingletonType<PauseStates>::Instance();
@@ -3013,6 +3307,40 @@ void SPTS::temporaryPreloadDUT() {
     load_->Concatenate(OFF);
 }
 
+//===============
+// UploadScope()
+//===============
+const SPTSInstrument::Oscilloscope::Waveform& 
+                         SPTS::UploadScope(OScopeChannels::Channel chan, bool toPause) {
+    // Held waveform; valid until the next UploadScope()
+    Assert<BadArg>(chan != OScopeChannels::ALL, name_);
+    if ( toPause )
+        measureScopePause();
+    return(scope_->Upload(chan));
+}
+
+//============
+// vinState()
+//============
+std::string SPTS::vinState(const SetType& vinValue) {
+    // Everything that sets the DUT's input current for a given Vin --> keys vinModel_
+    //  A DUT below low line may be in dropout, and one held at the supply's current
+    //  limit has tripped it; neither draws the current of a running DUT.
+    std::string toRtn = convert<std::string>(mainSupply_->WhichSupply());
+    toRtn += ";" + convert<std::string>(mainSupply_->GetAmps());
+    toRtn += (vinValue < dut_->LowLine()) ? ";D" : ";R";
+    typedef ControlMatrixTraits::RelayTypes CMR;
+    toRtn += (inputRelays_->CurrentState(CMR::PRIMARYINHIBIT) == ON) ? ";I" : ";-";
+    LoadChannels::iterator i = activeLoadChannels_.begin();
+    while ( i != activeLoadChannels_.end() ) {
+        std::pair<Switch, SetType> value = load_->GetLoadValue(*i);
+        toRtn += ";" + convert<std::string>(load_->GetMode(*i));
+        toRtn += (value.first == ON) ? "," + convert<std::string>(value.second) : ",-";
+        ++i;
+    }
+    return(toRtn);
+}
+
 //===============
 // WaitOnScope()
 //===============
@@ -3033,6 +3361,9 @@ void SPTS::WaitOnScope() {
 std::pair<SPTSInstrument::InstrumentTypes::Types, std::string> SPTS::WhatError() {
     std::string toRtn = whatError_;
     whatError_ = "";
+    InstrumentFile* ifile = SingletonType<InstrumentFile>::Instance();
+    ErrorLogger* errorLog = SingletonType<ErrorLogger>::Instance();
+    errorLog->SetInstrument(ifile->GetModelType(errorInstr_));
     return(std::make_pair(errorInstr_, toRtn));
 }
 
@@ -10,6 +10,14 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+    SPTSFiles<PauseFileTag> keeps its file's path --> added Path().
+    Added Sources() to SPTSFiles<LimitsFileTag>, SPTSFiles<ScopeSetupFileTag> and
+      SPTSFiles<VariablesFileTag>.  Each constructor records the pointed-to file,
+      every .support file it looks for and any non-production file it loads.
+
 Revision N.01, 10/7/08, MBuck
 	Changed Parser in SPTSFiles<LimitsFileTag>::Tests, SPTSFiles<VariablesFileTag>::getTable
 	SPTSFiles<VariablesFileTag>::GetVariables() to allow the use of the second, "alpha", dash
@@ -457,6 +465,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles<LimitsFileTag>(const std::string& familyNumb
     bool eng = false, dev = false, testEng = false;
     try {
         limFilePath = pointerFile.getFilePath<Type>(familyNumber);
+        sources_.push_back(limFilePath);
         bool done = false;
         std::string::size_type pos = limFilePath.rfind("\\");
         Assert<FileError>(pos != std::string::npos, Type::Name());
@@ -465,6 +474,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles<LimitsFileTag>(const std::string& familyNumb
 
         if ( testEngTest ) { // try to load test engineering limits
             std::string tefile = limFilePath.substr(0, pos) + "TestEng.support";
+            sources_.push_back(tefile);
             std::ifstream te(tefile.c_str());
             if ( te ) {
                 finalFile = findEngineeringPath<FileFormatError>(familyNumber, 
@@ -478,6 +488,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles<LimitsFileTag>(const std::string& familyNumb
         }
         if ( engTest && !done ) { // try to load engineering limits
             std::string efile = limFilePath.substr(0, pos) + "Engineering.support";
+            sources_.push_back(efile);
             std::ifstream engFile(efile.c_str());
             if ( engFile ) {
                 finalFile = findEngineeringPath<FileFormatError>(familyNumber, 
@@ -491,6 +502,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles<LimitsFileTag>(const std::string& familyNumb
         }
         if ( !done ) { // try to load deviation limits
             std::string file = limFilePath.substr(0, pos) + "Deviation.support";
+            sources_.push_back(file);
             std::ifstream deviations(file.c_str());
             if ( deviations ) {
                 finalFile = findDeviationPath<FileFormatError>(familyNumber, 
@@ -505,6 +517,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles<LimitsFileTag>(const std::string& familyNumb
             throw(false); // nothing found --> load regular limits
 
         finalFile = limFilePath.substr(0, pos) + finalFile;
+        sources_.push_back(finalFile);
         try {
             std::ifstream infile(finalFile.c_str());
             fn_.reset(new FileNode(infile));
@@ -536,6 +549,7 @@ SPTSFiles<LimitsFileTag>::SPTSFiles(const std::string& familyNumber, bool)
                               isDev_(false) {
     // Should be called for gold standards only
     std::string limFilePath = pointerFile.getFilePath<GoldType>(familyNumber);
+    sources_.push_back(limFilePath);
     std::ifstream infile(limFilePath.c_str());
     fn_.reset(new FileNode(infile));
     Assert<NoFileFound>(fn_->Size() > 0, GoldType::Name());
@@ -778,6 +792,13 @@ bool SPTSFiles<LimitsFileTag>::IsSetGold() {
     return(isGold_);
 }
 
+//===========
+// Sources()
+//===========
+std::vector<std::string> SPTSFiles<LimitsFileTag>::Sources() const {
+    return(sources_);
+}
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -802,6 +823,7 @@ SPTSFiles<PauseFileTag>::SPTSFiles<PauseFileTag>(const std::string& familyNumber
     std::ifstream infile(pausePath.c_str());
     fn_.reset(new FileNode(infile));
     Assert<NoFileFound>(fn_->Size() > 0, Type::Name());    
+    path_ = pausePath;
 }
 
 //============
@@ -834,6 +856,13 @@ std::string SPTSFiles<PauseFileTag>::GetValue(const std::string& parameter) {
     
 } 
 
+//========
+// Path()
+//========
+std::string SPTSFiles<PauseFileTag>::Path() const {
+    return(path_);
+}
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -850,6 +879,7 @@ SPTSFiles<ScopeSetupFileTag>::SPTSFiles<ScopeSetupFileTag>
                                     (const std::string& familyNumber) : fn_(0) {
     // Create a FileNode for the file that contains scope setup info for FamilyNumber
     std::string setupFilePath = pointerFile.getFilePath<Type>(familyNumber);
+    sources_.push_back(setupFilePath);
     std::ifstream infile(setupFilePath.c_str());
     fn_.reset(new FileNode(infile));
     Assert<NoFileFound>(fn_->Size() > 0, Type::Name());
@@ -875,6 +905,13 @@ SPTSFiles<ScopeSetupFileTag>::Parameters
     return(separate(v));  
 }
 
+//===========
+// Sources()
+//===========
+std::vector<std::string> SPTSFiles<ScopeSetupFileTag>::Sources() const {
+    return(sources_);
+}
+
 /***************************************************************************************/
 ////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
 //////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
@@ -1146,6 +1183,7 @@ SPTSFiles<VariablesFileTag>::SPTSFiles<VariablesFileTag>(
     try {
         bool done = false;
         variablePath = pointerFile.getFilePath<Type>(familyNumber);
+        sources_.push_back(variablePath);
         std::string::size_type pos = variablePath.rfind("\\");
         Assert<FileError>(pos != std::string::npos, Type::Name());
         ++pos;
@@ -1153,6 +1191,7 @@ SPTSFiles<VariablesFileTag>::SPTSFiles<VariablesFileTag>(
 
         if ( testEngTest ) { // try to load test engineering variables
             std::string tefile = variablePath.substr(0, pos) + "TestEng.support";
+            sources_.push_back(tefile);
             std::ifstream te(tefile.c_str());
             if ( te ) {
                 finalFile = findEngineeringPath<FileFormatError>(familyNumber, 
@@ -1166,6 +1205,7 @@ SPTSFiles<VariablesFileTag>::SPTSFiles<VariablesFileTag>(
         }
         if ( engTest && !done ) { // try to load engineering variables
             std::string efile = variablePath.substr(0, pos) + "Engineering.support";
+            sources_.push_back(efile);
             std::ifstream engFile(efile.c_str());
             if ( engFile ) {
                 finalFile = findEngineeringPath<FileFormatError>(familyNumber, 
@@ -1179,6 +1219,7 @@ SPTSFiles<VariablesFileTag>::SPTSFiles<VariablesFileTag>(
         }
         if ( !done ) { // try to load deviation variables
             std::string file = variablePath.substr(0, pos) + "Deviation.support";
+            sources_.push_back(file);
             std::ifstream deviations(file.c_str());
             if ( deviations ) {
                 finalFile = findDeviationPath<FileFormatError>(familyNumber, 
@@ -1192,6 +1233,7 @@ SPTSFiles<VariablesFileTag>::SPTSFiles<VariablesFileTag>(
         if ( finalFile.empty() )
             throw(false); // nothing found --> load regular variables
         finalFile = variablePath.substr(0, pos) + finalFile;
+        sources_.push_back(finalFile);
         try {
             std::ifstream infile(finalFile.c_str());
             fn_.reset(new FileNode(infile));
@@ -1453,6 +1495,13 @@ bool SPTSFiles<VariablesFileTag>::IsDeviationTest() const {
     return(isDev_);
 }
 
+//===========
+// Sources()
+//===========
+std::vector<std::string> SPTSFiles<VariablesFileTag>::Sources() const {
+    return(sources_);
+}
+
 } // namespace FileTypes
 
 
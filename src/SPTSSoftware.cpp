@@ -54,7 +54,9 @@
 //          files are moved out to a network location (if moved to the current working
 //          directory with certain tradeoffs).  The one associated with ErrorLogger.h
 //          should remain on the local drive in my opinion - see ErrorLogger.h for more
-//          details.
+//          details.  Its directory may be overridden with the SPTSERRORLOG environment
+//          variable; tools/ErrorLogReader.cpp prints the binary log it writes.  That
+//          tool is not part of this project --> compile it with ErrorRecord.cpp alone.
 /***************************************************************************************/
 
 /***************************************************************************************/
@@ -0,0 +1,402 @@
+// Files included
+#include "Assertion.h"
+#include "Converter.h"
+#include "MainSupplyTraits.h"
+#include "PauseStates.h"
+#include "SequenceCost.h"
+#include "SingletonType.h"
+#include "SPTSException.h"
+#include "StationFile.h"
+#include "StringAlgorithms.h"
+#include "VariablesFile.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    typedef SequenceCost::SetType SetType;
+    typedef PauseStates::PauseTypes PauseTypes;
+
+    enum Search { NOSEARCH, TRIPSEARCH, DROPOUTSEARCH };
+
+    // Hardware activity of one measurement type, per output measured
+    struct Profile {
+        const char* name_;
+        long dmmReads_;
+        long scopeReads_;
+        PauseTypes pause_;
+        long relayCycles_; // safe inhibit cycles within the measurement
+        long vinChanges_;
+        Search search_;
+    };
+
+    // Approximations of MeasurementFunctions.cpp --> keep in step with it
+    const Profile profiles[] = {
+        { "Case Temperature",        1, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "Cross Regulation",        2, 0, PauseStates::VOUTDC,       0, 0, NOSEARCH },
+        { "Cross Regulation XX",     2, 0, PauseStates::VOUTDC,       0, 0, NOSEARCH },
+        { "Efficiency",              3, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "Frequency",               0, 1, PauseStates::MEASURESCOPE, 0, 0, NOSEARCH },
+        { "Generic Voltage Measurement",
+                                     1, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "Iin DC",                  1, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "Iin PARD",                0, 1, PauseStates::MEASURESCOPE, 0, 0, NOSEARCH },
+        { "Inhibit Cycle Test",      1, 0, PauseStates::INHIBITPULSEWIDTH,
+                                                                      1, 0, NOSEARCH },
+        { "Iout DC",                 1, 0, PauseStates::IOUTDC,       0, 0, NOSEARCH },
+        { "Iout Trip Point",         0, 0, PauseStates::TRIPPOINT,    0, 0, TRIPSEARCH },
+        { "Iout Trip Pretrim",       0, 0, PauseStates::TRIPPOINT,    0, 0, TRIPSEARCH },
+        { "Line Regulation",         2, 0, PauseStates::VOUTDC,       0, 1, NOSEARCH },
+        { "Load Regulation",         2, 0, PauseStates::VOUTDC,       0, 0, NOSEARCH },
+        { "Load Transient Recovery", 0, 1, PauseStates::TRANSIENTTRIGGER,
+                                                                      0, 0, NOSEARCH },
+        { "Load Transient Response", 0, 1, PauseStates::TRANSIENTTRIGGER,
+                                                                      0, 0, NOSEARCH },
+        { "Low Line Dropout",        0, 0, PauseStates::LLDO,         0, 2, DROPOUTSEARCH },
+        { "Power Dissipation",       3, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "SC Release Delay",        0, 1, PauseStates::MEASURESCOPE, 1, 0, NOSEARCH },
+        { "SC Release Overshoot",    0, 1, PauseStates::MEASURESCOPE, 1, 0, NOSEARCH },
+        { "Turn On Delay",           0, 1, PauseStates::TOD,          1, 0, NOSEARCH },
+        { "Turn On Overshoot",       0, 1, PauseStates::TOD,          1, 0, NOSEARCH },
+        { "Vin DC",                  1, 0, PauseStates::MEASUREDMM,   0, 0, NOSEARCH },
+        { "Vin Ramp Delay",          0, 1, PauseStates::MEASURESCOPE, 0, 1, NOSEARCH },
+        { "Vin Ramp Overshoot",      0, 1, PauseStates::MEASURESCOPE, 0, 1, NOSEARCH },
+        { "Vout DC",                 1, 0, PauseStates::VOUTDC,       0, 0, NOSEARCH },
+        { "Vout DC Pretrim",         1, 0, PauseStates::VOUTDC,       0, 0, NOSEARCH },
+        { "Vout PARD",               0, 1, PauseStates::MEASURESCOPE, 0, 0, NOSEARCH }
+    };
+    const std::size_t NUMPROFILES = sizeof(profiles) / sizeof(profiles[0]);
+
+    // Anything not listed above is charged as a single DMM measurement
+    const Profile unknownProfile =
+                    { "", 1, 0, PauseStates::MEASUREDMM, 0, 0, NOSEARCH };
+
+    // Low line dropout search window, as in LowLineDropout::measure()
+    const double LLDOLOWFRACTION = 0.8;
+    const double LLDOHIGHOFFSET  = 3;
+
+    // Fallback rates when the station file has no "Cost ..." entry
+    const double DEFBUSCOMMAND    = 5e-3;  // seconds per instrument command
+    const double DEFDMMREADING    = 50e-3; // seconds per DMM reading
+    const double DEFSCOPEREADING  = 1;     // seconds per scope reading
+    const double DEFVINSETTLE     = 0.2;   // seconds per main supply change
+    const double DEFTEMPRAMP      = 10;    // seconds per degree C
+    const double DEFLOADRESOLUTION = 10e-3; // amps
+    const double DEFVINRESOLUTION  = 10e-3; // volts
+
+    const Profile& findProfile(const std::string& softwareName) {
+        std::string upper = Uppercase(softwareName);
+        for ( std::size_t idx = 0; idx < NUMPROFILES; ++idx ) {
+            if ( Uppercase(profiles[idx].name_) == upper )
+                return(profiles[idx]);
+        }
+        return(unknownProfile);
+    }
+
+    double rate(const std::string& item, double fallback) {
+        std::pair<bool, SetType> p =
+                   SingletonType<StationFile>::Instance()->CostCalibration(item);
+        return(p.first ? p.second.Value() : fallback);
+    }
+
+    long searchIterations(double span, double stepSize) {
+        // Binary search halves (span) until within (stepSize)
+        if ( span <= stepSize || stepSize <= 0 )
+            return(1);
+        return(static_cast<long>(std::ceil(std::log(span / stepSize) / std::log(2.0))));
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+SequenceCost::SequenceCost() : totals_(NUMCATEGORIES, 0)
+{ /* */ }
+
+//============
+// Destructor
+//============
+SequenceCost::~SequenceCost()
+{ /* */ }
+
+//=================
+// CategoryTotal()
+//=================
+SequenceCost::SetType SequenceCost::CategoryTotal(Category cat) const {
+    Assert<BadArg>(cat >= PAUSE && cat < NUMCATEGORIES, name());
+    return(SetType(totals_[cat]));
+}
+
+//============
+// Estimate()
+//============
+void SequenceCost::Estimate(const std::vector<TestStepInfo>& sequence,
+                            const SetType& startTemperature) {
+    names_.clear();
+    steps_.clear();
+    totals_.assign(NUMCATEGORIES, 0);
+
+    Rates r = rates();
+    double target = SingletonType<VariablesFile>::Instance()->GetTemperature().Value();
+    const TestStepInfo* last = 0;
+    std::vector<TestStepInfo>::const_iterator i = sequence.begin();
+    while ( i != sequence.end() ) {
+        Costs step(NUMCATEGORIES, 0);
+        if ( 0 == last ) // ramp to test temperature once, before the first step
+            charge(step, TEMPERATURE,
+                   std::fabs(target - startTemperature.Value()) * r.tempRamp_);
+
+        TestStepInfo::CondPtr cptr = static_cast<TestStepInfo::CondPtr>(*i);
+        TestStepInfo::TSPtr tptr = static_cast<TestStepInfo::TSPtr>(*i);
+        conditionCost(step, cptr, last, r);
+        measurementCost(step, tptr, cptr, r);
+
+        for ( std::size_t idx = 0; idx < step.size(); ++idx )
+            totals_[idx] += step[idx];
+        names_.push_back(tptr->TestName());
+        steps_.push_back(step);
+        last = &(*i);
+        ++i;
+    } // while
+}
+
+//========
+// Name()
+//========
+std::string SequenceCost::Name(Category cat) {
+    switch(cat) {
+        case PAUSE:
+            return("Pause");
+        case TEMPERATURE:
+            return("Temperature");
+        case RELAY:
+            return("Relay");
+        case VIN:
+            return("Vin");
+        case SEARCH:
+            return("Search");
+        case BUS:
+            return("Bus");
+        default:
+            throw(BadArg("Sequence Cost"));
+    };
+}
+
+//===============
+// NumberSteps()
+//===============
+long SequenceCost::NumberSteps() const {
+    return(static_cast<long>(steps_.size()));
+}
+
+//==========
+// Report()
+//==========
+void SequenceCost::Report(std::ostream& os) const {
+    static const int nameWidth = 28, colWidth = 12;
+    os << std::setiosflags(std::ios::fixed) << std::setprecision(2);
+    os << std::setw(6) << std::left << "Step" << std::setw(nameWidth) << "Test";
+    for ( int cat = PAUSE; cat < NUMCATEGORIES; ++cat )
+        os << std::setw(colWidth) << std::right << Name(static_cast<Category>(cat));
+    os << std::setw(colWidth) << "Total" << std::endl;
+
+    for ( std::size_t idx = 0; idx < steps_.size(); ++idx ) {
+        os << std::setw(6) << std::left << (idx + 1);
+        os << std::setw(nameWidth) << names_[idx].substr(0, nameWidth - 1);
+        for ( std::size_t cat = 0; cat < steps_[idx].size(); ++cat )
+            os << std::setw(colWidth) << std::right << steps_[idx][cat];
+        os << std::setw(colWidth) << StepTotal(static_cast<long>(idx)).Value();
+        os << std::endl;
+    } // for
+
+    os << std::setw(6 + nameWidth) << std::left << "All Steps (seconds)";
+    for ( std::size_t cat = 0; cat < totals_.size(); ++cat )
+        os << std::setw(colWidth) << std::right << totals_[cat];
+    os << std::setw(colWidth) << Total().Value() << std::endl;
+}
+
+//=============
+// StepTotal()
+//=============
+SequenceCost::SetType SequenceCost::StepTotal(long step) const {
+    Assert<BadArg>(step >= 0 && step < NumberSteps(), name());
+    const Costs& c = steps_[step];
+    return(SetType(std::accumulate(c.begin(), c.end(), 0.0)));
+}
+
+//=========
+// Total()
+//=========
+SequenceCost::SetType SequenceCost::Total() const {
+    return(SetType(std::accumulate(totals_.begin(), totals_.end(), 0.0)));
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//==========
+// charge()
+//==========
+void SequenceCost::charge(Costs& step, Category cat, double seconds) const {
+    step[cat] += seconds;
+}
+
+//=================
+// conditionCost()
+//=================
+void SequenceCost::conditionCost(Costs& step, TestStepInfo::CondPtr cptr,
+                                 const TestStepInfo* last, const Rates& r) const {
+    // Mirrors Measurement::preMeasurement() and postMeasurement()
+    PauseStates* ps = SingletonType<PauseStates>::Instance();
+    double option = ps->GetPauseValue(PauseStates::OPTIONALINITIALCONDITIONS).Value();
+    double misc = ps->GetPauseValue(PauseStates::MISCELLANEOUSINITIALCONDITIONS).Value();
+    double relay = ps->GetPauseValue(PauseStates::RELAYSTATECHANGE).Value();
+    double safeCycle = ps->GetPauseValue(PauseStates::SAFEINHIBITON).Value() +
+                       ps->GetPauseValue(PauseStates::SAFEINHIBITOFF).Value();
+    double vinChange = ps->GetPauseValue(PauseStates::POWERSUPPLYCHANGE).Value() +
+                       r.vinSettle_;
+
+    TestStepInfo::CondPtr lptr = 0;
+    if ( last )
+        lptr = static_cast<TestStepInfo::CondPtr>(*last);
+    if ( !lptr || (lptr->Vin() != cptr->Vin()) ) {
+        charge(step, VIN, vinChange);
+        charge(step, BUS, r.busCommand_);
+    }
+    if ( !lptr || (lptr->Iouts() != cptr->Iouts()) )
+        charge(step, BUS, r.busCommand_ * cptr->Iouts().size());
+
+    if ( cptr->SyncIn() ) {
+        charge(step, RELAY, safeCycle);
+        charge(step, PAUSE,
+               1.5 * ps->GetPauseValue(PauseStates::SYNCINPUT).Value());
+        charge(step, BUS, 4 * r.busCommand_);
+    }
+    if ( !cptr->Shorted().empty() ) {
+        long nShorts = static_cast<long>(cptr->Shorted().size());
+        charge(step, RELAY, relay + safeCycle); // short on, then off afterwards
+        charge(step, PAUSE, option);
+        charge(step, BUS, nShorts * (r.dmmReading_ + r.busCommand_));
+    }
+    if ( cptr->APSPrimary() != TestStepInfo::UNDEFINEDSETTYPE ) {
+        charge(step, RELAY, safeCycle);
+        charge(step, PAUSE, option);
+        charge(step, BUS, 2 * r.busCommand_);
+    }
+    if ( cptr->APSSecondary() != TestStepInfo::UNDEFINEDSETTYPE ) {
+        charge(step, RELAY, safeCycle);
+        charge(step, PAUSE, option);
+        charge(step, BUS, 2 * r.busCommand_);
+    }
+    if ( !cptr->PretestMisc().empty() ) {
+        charge(step, RELAY, safeCycle + relay);
+        charge(step, PAUSE, 2 * misc);
+        charge(step, BUS, r.busCommand_);
+    }
+    if ( cptr->PrimaryInhibited() || cptr->SecondaryInhibited() ) {
+        charge(step, RELAY, relay);
+        charge(step, PAUSE, option);
+        charge(step, BUS, r.busCommand_);
+    }
+    if ( cptr->IsInhibited() )
+        charge(step, RELAY, safeCycle);
+    if ( cptr->VinRamp() ) {
+        charge(step, VIN, vinChange);
+        charge(step, PAUSE, 2 * option);
+        charge(step, BUS, r.busCommand_);
+    }
+}
+
+//===================
+// measurementCost()
+//===================
+void SequenceCost::measurementCost(Costs& step, TestStepInfo::TSPtr tptr,
+                                   TestStepInfo::CondPtr cptr, const Rates& r) const {
+    PauseStates* ps = SingletonType<PauseStates>::Instance();
+    Converter* dut = SingletonType<Converter>::Instance();
+    const Profile& p = findProfile(tptr->SoftwareTestName());
+    double pause = ps->GetPauseValue(p.pause_).Value();
+    double vinChange = ps->GetPauseValue(PauseStates::POWERSUPPLYCHANGE).Value() +
+                       r.vinSettle_;
+
+    long nOutputs = 1;
+    if ( ConverterOutput::ALL == cptr->Channel() )
+        nOutputs = static_cast<long>(dut->Outputs().size());
+    long reads = p.dmmReads_ + p.scopeReads_;
+    if ( reads > 0 )
+        charge(step, PAUSE, nOutputs * pause);
+    charge(step, BUS, nOutputs * (p.dmmReads_ * (r.dmmReading_ + r.busCommand_) +
+                                  p.scopeReads_ * (r.scopeReading_ + r.busCommand_)));
+    if ( p.relayCycles_ > 0 ) {
+        double safeCycle = ps->GetPauseValue(PauseStates::SAFEINHIBITON).Value() +
+                           ps->GetPauseValue(PauseStates::SAFEINHIBITOFF).Value();
+        charge(step, RELAY, nOutputs * p.relayCycles_ * safeCycle);
+    }
+    if ( p.vinChanges_ > 0 )
+        charge(step, VIN, p.vinChanges_ * vinChange);
+
+    // Each search iteration is one setting, one pause and one DMM reading
+    double span = 0, resolution = 0;
+    std::pair<ProgramTypes::MType, ProgramTypes::MType> limits = tptr->ScaledLimits();
+    if ( TRIPSEARCH == p.search_ ) {
+        span = limits.second.Value();
+        if ( ConverterOutput::ALL != cptr->Channel() )
+            span -= dut->Iout(cptr->Channel()).Value();
+        resolution = 2 * r.loadResolution_;
+    }
+    else if ( DROPOUTSEARCH == p.search_ ) {
+        span = (dut->LowLine().Value() + LLDOHIGHOFFSET) -
+               (LLDOLOWFRACTION * limits.first.Value());
+        resolution = 2 * r.vinResolution_;
+    }
+    if ( NOSEARCH != p.search_ ) {
+        long iterations = nOutputs * searchIterations(std::fabs(span), resolution);
+        charge(step, SEARCH, iterations *
+                     (pause + r.dmmReading_ + 2 * r.busCommand_));
+    }
+}
+
+//========
+// name()
+//========
+std::string SequenceCost::name() const {
+    return("Sequence Cost");
+}
+
+//=========
+// rates()
+//=========
+SequenceCost::Rates SequenceCost::rates() const {
+    Rates r;
+    r.busCommand_     = rate("Bus Command", DEFBUSCOMMAND);
+    r.dmmReading_     = rate("DMM Reading", DEFDMMREADING);
+    r.scopeReading_   = rate("Scope Reading", DEFSCOPEREADING);
+    r.vinSettle_      = rate("Vin Settle", DEFVINSETTLE);
+    r.tempRamp_       = rate("Temperature Ramp", DEFTEMPRAMP);
+    r.loadResolution_ = rate("Load Resolution", DEFLOADRESOLUTION);
+    r.vinResolution_  = rate("Vin Resolution", DEFVINRESOLUTION);
+    return(r);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
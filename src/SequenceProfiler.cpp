@@ -0,0 +1,279 @@
+// Files included
+#include "DateTime.h"
+#include "SequenceProfiler.h"
+#include "SPTSException.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    const std::string PRETEST = "Pretest";
+    const std::size_t SLOWEST = 5; // steps listed by Report()
+
+    std::string csv(std::string s) {
+        std::replace(s.begin(), s.end(), ',', ' ');
+        return(s);
+    }
+
+    double percent(double part, double whole) {
+        return((whole > 0) ? (100.0 * part / whole) : 0.0);
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+SequenceProfiler::SequenceProfiler() : current_(OTHER), running_(false),
+                                       since_(std::clock()), totals_(NUMPHASES, 0.0)
+{ /* */ }
+
+//============
+// Destructor
+//============
+SequenceProfiler::~SequenceProfiler()
+{ /* */ }
+
+//===========
+// Archive()
+//===========
+void SequenceProfiler::Archive(const std::string& file) const {
+    // Profiling must never stop testing --> quietly give up on any problem
+    try {
+        bool fresh = !std::ifstream(file.c_str());
+        std::ofstream of(file.c_str(), std::ios::app);
+        if ( !of )
+            return;
+        if ( fresh )
+            of << "Date,Time,Family,Serial,Step,Test,Phase,Seconds" << std::endl;
+
+        std::string when = Date::CurrentDate() + "," + Clock::CurrentTime();
+        of << std::setiosflags(std::ios::fixed) << std::setprecision(3);
+        for ( std::size_t idx = 0; idx < steps_.size(); ++idx ) {
+            for ( int phase = PREMEASUREMENT; phase < NUMPHASES; ++phase ) {
+                if ( steps_[idx][phase] <= 0 )
+                    continue;
+                of << when << "," << csv(family_) << "," << csv(serial_) << ","
+                   << idx << "," << csv(names_[idx]) << ","
+                   << Name(static_cast<Phase>(phase)) << "," << steps_[idx][phase]
+                   << std::endl;
+            } // for
+        } // for
+    } catch(...) { /* */ }
+}
+
+//==========
+// Finish()
+//==========
+void SequenceProfiler::Finish() {
+    if ( !running_ )
+        return;
+    charge();
+    running_ = false;
+
+    std::map<std::string, Family>::iterator f = families_.find(family_);
+    if ( f == families_.end() ) {
+        Family toAdd;
+        toAdd.duts_ = 0;
+        toAdd.totals_.assign(NUMPHASES, 0.0);
+        f = families_.insert(std::make_pair(family_, toAdd)).first;
+    }
+    ++f->second.duts_;
+    for ( int phase = PREMEASUREMENT; phase < NUMPHASES; ++phase )
+        f->second.totals_[phase] += totals_[phase];
+}
+
+//========
+// Name()
+//========
+std::string SequenceProfiler::Name(Phase phase) {
+    switch(phase) {
+        case PREMEASUREMENT:
+            return("Pre Measurement");
+        case VIN:
+            return("Vin");
+        case LOADS:
+            return("Loads");
+        case RELAYS:
+            return("Relays");
+        case SYNC:
+            return("Sync");
+        case INHIBIT:
+            return("Inhibit");
+        case AUXSUPPLY:
+            return("Aux Supply");
+        case MEASURE:
+            return("Measure");
+        case POSTMEASUREMENT:
+            return("Post Measurement");
+        case CACHE:
+            return("Result Cache");
+        case GUI:
+            return("GUI");
+        case TEMPERATURE:
+            return("Temperature");
+        case ERRORCHECK:
+            return("Error Check");
+        case OTHER:
+            return("Other");
+        default:
+            throw(BadArg("Sequence Profiler"));
+    };
+}
+
+//==========
+// Report()
+//==========
+void SequenceProfiler::Report(std::ostream& os) const {
+    static const int nameWidth = 28, colWidth = 12;
+    double total = std::accumulate(totals_.begin(), totals_.end(), 0.0);
+    os << std::setiosflags(std::ios::fixed) << std::setprecision(2);
+    os << "Measured: " << family_ << " " << serial_ << ", "
+       << steps_.size() << " step(s)" << std::endl;
+    os << std::setw(nameWidth) << std::left << "Phase"
+       << std::setw(colWidth) << std::right << "Seconds"
+       << std::setw(colWidth) << "Percent" << std::endl;
+    for ( int phase = PREMEASUREMENT; phase < NUMPHASES; ++phase ) {
+        os << std::setw(nameWidth) << std::left << Name(static_cast<Phase>(phase))
+           << std::setw(colWidth) << std::right << totals_[phase]
+           << std::setw(colWidth) << percent(totals_[phase], total) << std::endl;
+    }
+    os << std::setw(nameWidth) << std::left << "All Phases"
+       << std::setw(colWidth) << std::right << total << std::endl;
+
+    std::vector< std::pair<double, std::size_t> > slowest;
+    for ( std::size_t idx = 0; idx < steps_.size(); ++idx ) {
+        double t = std::accumulate(steps_[idx].begin(), steps_[idx].end(), 0.0);
+        slowest.push_back(std::make_pair(t, idx));
+    }
+    std::size_t show = std::min(SLOWEST, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + show, slowest.end(),
+                      std::greater< std::pair<double, std::size_t> >());
+    os << "Slowest Steps" << std::endl;
+    for ( std::size_t idx = 0; idx < show; ++idx ) {
+        std::size_t step = slowest[idx].second;
+        os << std::setw(6) << std::left << step
+           << std::setw(nameWidth - 6) << names_[step].substr(0, nameWidth - 7)
+           << std::setw(colWidth) << std::right << slowest[idx].first << std::endl;
+    }
+}
+
+//=========
+// Start()
+//=========
+void SequenceProfiler::Start(const std::string& family, const std::string& serial) {
+    family_ = family;
+    serial_ = serial;
+    names_.clear();
+    steps_.clear();
+    totals_.assign(NUMPHASES, 0.0);
+    current_ = OTHER;
+    running_ = true;
+    since_ = std::clock();
+    StartStep(PRETEST); // anything before the first step
+}
+
+//=============
+// StartStep()
+//=============
+void SequenceProfiler::StartStep(const std::string& step) {
+    if ( !running_ )
+        return;
+    charge();
+    names_.push_back(step);
+    steps_.push_back(Times(NUMPHASES, 0.0));
+}
+
+//===========
+// Summary()
+//===========
+void SequenceProfiler::Summary(std::ostream& os) const {
+    static const int nameWidth = 28, colWidth = 12;
+    os << std::setiosflags(std::ios::fixed) << std::setprecision(2);
+    std::map<std::string, Family>::const_iterator f = families_.begin();
+    while ( f != families_.end() ) {
+        const Times& t = f->second.totals_;
+        double duts = static_cast<double>(f->second.duts_);
+        double total = std::accumulate(t.begin(), t.end(), 0.0);
+        os << "Family " << f->first << ":  " << f->second.duts_
+           << " DUT(s), mean seconds per DUT" << std::endl;
+        for ( int phase = PREMEASUREMENT; phase < NUMPHASES; ++phase ) {
+            os << std::setw(nameWidth) << std::left << Name(static_cast<Phase>(phase))
+               << std::setw(colWidth) << std::right << t[phase] / duts
+               << std::setw(colWidth) << percent(t[phase], total) << std::endl;
+        }
+        os << std::setw(nameWidth) << std::left << "All Phases"
+           << std::setw(colWidth) << std::right << total / duts << std::endl;
+        ++f;
+    } // while
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//==========
+// charge()
+//==========
+void SequenceProfiler::charge() {
+    // Time since the last charge() goes to the current phase of the current step
+    std::clock_t now = std::clock();
+    if ( running_ && !steps_.empty() ) {
+        double seconds = static_cast<double>(now - since_) / CLOCKS_PER_SEC;
+        steps_.back()[current_] += seconds;
+        totals_[current_] += seconds;
+    }
+    since_ = now;
+}
+
+//========
+// name()
+//========
+std::string SequenceProfiler::name() const {
+    return("Sequence Profiler");
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//===================
+// Timer Constructor
+//===================
+SequenceProfiler::Timer::Timer(Phase phase) {
+    SequenceProfiler* profiler = SingletonType<SequenceProfiler>::Instance();
+    profiler->charge();
+    previous_ = profiler->current_;
+    profiler->current_ = phase;
+}
+
+//==================
+// Timer Destructor
+//==================
+SequenceProfiler::Timer::~Timer() {
+    SequenceProfiler* profiler = SingletonType<SequenceProfiler>::Instance();
+    profiler->charge();
+    profiler->current_ = previous_;
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,387 @@
+// Files included for Winsock
+#include <winsock2.h>
+
+// Files included
+#include "Assertion.h"
+#include "Functions.h"
+#include "GenericAlgorithms.h"
+#include "Instrument.h"
+#include "InstrumentFile.h"
+#include "SingletonType.h"
+#include "SocketSCPI.h"
+#include "SPTSException.h"
+#include "StringAlgorithms.h"
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BusError        BusError;
+    typedef StationExceptionTypes::FileError       FileError;
+    typedef StationExceptionTypes::UnexpectedState UnexpectedState;
+
+    // SCPI-RAW port (LXI) when the instrument file gives none
+    const long DEFAULTPORT = 5025;
+
+    // Bytes requested per recv() call
+    const long CHUNKSIZE = 1024;
+
+    // Largest response accepted --> guards against a talker that never terminates
+    const long MAXRESPONSE = 16L * 1024L * 1024L;
+
+    // Send and receive timeouts in milliseconds --> same as GPIB's T10s
+    const int TIMEOUT = 10000;
+
+    // Instruments on the LAN at once
+    const long MAXCONNECTIONS = 64;
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace SPTSInstrument {
+
+//=============
+// Constructor
+//=============
+SocketSCPI::SocketSCPI() : map_(new MapType) {
+    WSADATA wsaData;
+    int error = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if ( error != 0 ) {
+        whatError_ = "Unable to start Winsock Error Code: ";
+        whatError_ += convert<std::string>(error);
+        throw(BusError(whatError_));
+    }
+}
+
+//============
+// Destructor
+//============
+SocketSCPI::~SocketSCPI() {
+    MapType::iterator beg = map_->begin(), end = map_->end();
+    while ( beg != end ) {
+        if ( beg->second.Connected )
+            closesocket(static_cast<SOCKET>(beg->second.Socket));
+        ++beg;
+    }
+    WSACleanup();
+}
+
+//===========
+// connect()
+//===========
+void SocketSCPI::connect(Connection& conn) {
+    sockaddr_in where = sockaddr_in();
+    where.sin_family = AF_INET;
+    where.sin_port = htons(static_cast<u_short>(conn.Port));
+    where.sin_addr.s_addr = inet_addr(conn.Host.c_str());
+    if ( INADDR_NONE == where.sin_addr.s_addr ) {
+        hostent* h = gethostbyname(conn.Host.c_str());
+        Assert<BusError>((h != 0) && (h->h_addrtype == AF_INET),
+                         name() + " unknown host: " + conn.Host);
+        where.sin_addr = *reinterpret_cast<in_addr*>(h->h_addr_list[0]);
+    }
+
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    Assert<BusError>(s != INVALID_SOCKET, name() + " socket " + conn.Endpoint);
+    BOOL noDelay = TRUE; // Nagle off --> small commands are not held back
+    int timeout = TIMEOUT;
+    bool ok = 
+      (0 == setsockopt(s, IPPROTO_TCP, TCP_NODELAY, 
+                       reinterpret_cast<const char*>(&noDelay), sizeof(noDelay))) &&
+      (0 == setsockopt(s, SOL_SOCKET, SO_RCVTIMEO,
+                       reinterpret_cast<const char*>(&timeout), sizeof(timeout))) &&
+      (0 == setsockopt(s, SOL_SOCKET, SO_SNDTIMEO,
+                       reinterpret_cast<const char*>(&timeout), sizeof(timeout))) &&
+      (0 == ::connect(s, reinterpret_cast<sockaddr*>(&where), sizeof(where)));
+    if ( ! ok ) {
+        whatError_ = "Error Code: " + convert<std::string>(WSAGetLastError());
+        closesocket(s);
+        throw(BusError(name() + " unable to connect " + conn.Endpoint + " " + 
+                       whatError_));
+    }
+    conn.Socket = static_cast<std::size_t>(s);
+    conn.Connected = true;
+    conn.Start = 0;
+    conn.End = 0;
+    whatError_ = ""; // any earlier error was on the old connection
+}
+
+//==============
+// connection()
+//==============
+SocketSCPI::Connection& SocketSCPI::connection(long address) {
+    MapType::iterator found = map_->find(address);
+    Assert<BusError>(found != map_->end(), name() + " address: " +
+                     convert<std::string>(address) + " not open");
+    if ( ! found->second.Connected ) // dropped after an error --> try once more
+        connect(found->second);
+    return(found->second);
+}
+
+//========
+// drop()
+//========
+void SocketSCPI::drop(long address, Connection& conn, const std::string& error) {
+    // Whatever is in flight is lost --> close now, reconnect on next use
+    closesocket(static_cast<SOCKET>(conn.Socket));
+    conn.Connected = false;
+    conn.Start = 0;
+    conn.End = 0;
+    whatError_ = error;
+    throw(BusError(name() + " " + whatError_ + " " + conn.Endpoint + 
+                   " address: " + convert<std::string>(address)));
+}
+
+//========
+// fill()
+//========
+void SocketSCPI::fill(long address, Connection& conn) {
+    // Append one recv() worth of bytes after any unread ones
+    if ( conn.Start > 0 ) { // move unread bytes to the front
+        std::copy(conn.ReadBuffer.begin() + conn.Start,
+                  conn.ReadBuffer.begin() + conn.End, conn.ReadBuffer.begin());
+        conn.End -= conn.Start;
+        conn.Start = 0;
+    }
+    std::size_t needed = static_cast<std::size_t>(conn.End + CHUNKSIZE);
+    if ( conn.ReadBuffer.size() < needed ) {
+        Assert<BusError>(conn.End + CHUNKSIZE <= MAXRESPONSE, name() +
+                         " response too large: " + conn.Endpoint);
+        conn.ReadBuffer.resize(std::max(needed, 2 * conn.ReadBuffer.size()));
+    }
+
+    int got = recv(static_cast<SOCKET>(conn.Socket), &conn.ReadBuffer[conn.End],
+                   static_cast<int>(CHUNKSIZE), 0);
+    if ( got <= 0 )
+        drop(address, conn, (0 == got) ? "connection closed" : 
+                     "recv Error Code: " + convert<std::string>(WSAGetLastError()));
+    conn.End += got;
+}
+
+//===========
+// isError()
+//===========
+bool SocketSCPI::isError() {
+    return(!whatError_.empty());
+}
+
+//==============
+// maxAddress()
+//==============
+long SocketSCPI::maxAddress() const {
+	return(MAXCONNECTIONS);
+}
+
+//========
+// name()
+//========
+std::string SocketSCPI::name() const {
+    return("SocketSCPI");
+}
+
+//========
+// need()
+//========
+void SocketSCPI::need(long address, Connection& conn, long count) {
+    while ( conn.End - conn.Start < count )
+        fill(address, conn);
+}
+
+//========
+// open()
+//========
+long SocketSCPI::open(const std::string& lanAddress) {
+    std::string host = lanAddress;
+    long port = DEFAULTPORT;
+    std::string::size_type colon = lanAddress.find(':');
+    if ( colon != std::string::npos ) {
+        host = lanAddress.substr(0, colon);
+        std::string p = lanAddress.substr(colon + 1);
+        Assert<FileError>(IsInteger(p), name(), lanAddress);
+        port = convert<long>(p);
+    }
+    Assert<FileError>(!host.empty() && (port > 0) && (port < 65536), name(), 
+                      lanAddress);
+    std::string endpoint = host + ":" + convert<std::string>(port);
+
+    // Instruments sharing a LAN address (multi-channel boxes) share a connection
+    MapType::iterator i = map_->begin();
+    while ( i != map_->end() ) {
+        if ( i->second.Endpoint == endpoint )
+            return(i->first);
+        ++i;
+    }
+    long address = static_cast<long>(map_->size()) + 1;
+    Assert<BusError>(address < maxAddress(), name(), endpoint);
+
+    Connection conn;
+    conn.Socket = 0;
+    conn.Connected = false;
+    conn.Host = host;
+    conn.Port = port;
+    conn.Endpoint = endpoint;
+    conn.Start = 0;
+    conn.End = 0;
+    std::pair<MapType::iterator, bool> p;
+    p = map_->insert(std::make_pair(address, conn));
+    Assert<UnexpectedState>(p.second, name());
+    try {
+        connect(p.first->second);
+    } catch(...) {
+        map_->erase(p.first);
+        throw;
+    }
+    return(address);
+}
+
+//=========
+// query()
+//=========
+std::string SocketSCPI::query(long address, const std::string& command,
+                              double pauseAfterCommand) {
+	if ( !command.empty() ) {
+		talk(address, command);
+        Pause(pauseAfterCommand);
+    }
+    Connection& conn = connection(address);
+    long size = readLine(address, conn);
+    long length = size;
+    if ( (length > 0) && ('\r' == conn.ReadBuffer[conn.Start + length - 1]) )
+        --length; // CR LF terminated
+    std::string toRtn(&conn.ReadBuffer[conn.Start], length);
+    conn.Start += size + 1; // + newline
+    whatError_ = "";
+    return(toRtn);
+}
+
+//==============
+// queryBlock()
+//==============
+BusBlock SocketSCPI::queryBlock(long address, const std::string& command) {
+    // IEEE 488.2 block: #<n><n digits: length><data><NL> or #0<data><NL>
+	if ( !command.empty() )
+		talk(address, command);
+    Connection& conn = connection(address);
+    std::string badBlock = name() + " bad binary block: " + conn.Endpoint;
+    need(address, conn, 2);
+    const char* data = &conn.ReadBuffer[conn.Start];
+    Assert<BusError>((data[0] == '#') && (data[1] >= '0') && (data[1] <= '9'), 
+                     badBlock);
+
+    long digits = data[1] - '0';
+    BusBlock toRtn;
+    if ( 0 == digits ) { // indefinite length --> runs to the terminator
+        long size = readLine(address, conn);
+        toRtn.Data = &conn.ReadBuffer[conn.Start] + 2;
+        toRtn.Size = size - 2;
+        if ( (toRtn.Size > 0) && ('\r' == toRtn.Data[toRtn.Size - 1]) )
+            --toRtn.Size; // CR LF terminated
+        conn.Start += size + 1;
+        whatError_ = "";
+        return(toRtn);
+    }
+
+    need(address, conn, 2 + digits);
+    data = &conn.ReadBuffer[conn.Start];
+    long length = 0;
+    for ( long idx = 0; idx < digits; ++idx ) {
+        char c = data[2 + idx];
+        Assert<BusError>((c >= '0') && (c <= '9'), badBlock);
+        length = (length * 10) + (c - '0');
+    } // for
+    Assert<BusError>(length <= MAXRESPONSE, badBlock);
+
+    // Take the terminator (LF or CR LF) too so it is not seen as an empty
+    //  response later
+    long total = 2 + digits + length + 1;
+    need(address, conn, total);
+    data = &conn.ReadBuffer[conn.Start];
+    if ( '\r' == data[total-1] ) {
+        need(address, conn, ++total);
+        data = &conn.ReadBuffer[conn.Start];
+    }
+    Assert<BusError>(data[total-1] == '\n', badBlock);
+    toRtn.Data = data + 2 + digits;
+    toRtn.Size = length;
+    conn.Start += total;
+    whatError_ = "";
+    return(toRtn);
+}
+
+//============
+// readLine()
+//============
+long SocketSCPI::readLine(long address, Connection& conn) {
+    // Length of the next response, which starts at conn.Start --> the newline
+    //  is left in place for the caller to step over along with the response
+    long scanned = 0;
+    while ( true ) {
+        for ( ; conn.Start + scanned < conn.End; ++scanned ) {
+            if ( '\n' == conn.ReadBuffer[conn.Start + scanned] )
+                return(scanned);
+        } // for
+        fill(address, conn);
+    } // while
+}
+
+//========
+// talk()
+//========
+void SocketSCPI::talk(long address, const std::string& command) {
+    // Writes are not acknowledged --> back to back commands pipeline on the wire
+    Connection& conn = connection(address);
+    std::string toSend = command;
+    if ( toSend.empty() || (toSend[toSend.size()-1] != '\n') )
+        toSend += '\n';
+
+    std::size_t sent = 0;
+    while ( sent < toSend.size() ) {
+        int put = send(static_cast<SOCKET>(conn.Socket), toSend.data() + sent,
+                       static_cast<int>(toSend.size() - sent), 0);
+        if ( put <= 0 )
+            drop(address, conn, 
+                 "send Error Code: " + convert<std::string>(WSAGetLastError()));
+        sent += static_cast<std::size_t>(put);
+    } // while
+}
+
+//=============
+// whatError()
+//=============
+std::string SocketSCPI::whatError() const {
+    return(whatError_);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//======================================
+// Instrument<SocketSCPI>::getAddress()
+//======================================
+template <>
+long Instrument<SocketSCPI>::getAddress(InstrumentTypes::Types instrType) {
+    // LAN instruments are addressed by host[:port] rather than by GPIB address
+    InstrumentFile* ptr = SingletonType<InstrumentFile>::Instance();
+    return(bus_.open(ptr->GetLanAddress(instrType)));
+}
+
+} // namespace SPTSInstrument
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic 
+        constants are to regular code" 
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
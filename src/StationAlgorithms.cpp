@@ -3,6 +3,7 @@
 #include "ConfigureRelays.h"
 #include "Converter.h"
 #include "ConverterOutput.h"
+#include "DateTime.h"
 #include "Functions.h"
 #include "InstrumentTypes.h"
 #include "MainSupplyTraits.h"
@@ -19,12 +20,32 @@
 #include "SPTS.h"
 #include "SwitchMatrixTraits.h"
 #include "TestFixtureFile.h"
+#include "ThermalModel.h"
 #include "VariablesFile.h"
 
 //=====================================================================================//
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Modified EnforceTemperature() and InitializeBaseTemperature() to poll at a rate
+      set by a first-order ThermalModel fit on the fly instead of every 3 seconds.
+      Timeouts are now in elapsed seconds (same 600 second total as before).
+      InitializeBaseTemperature() also drives the controller past the target setpoint
+      when the model predicts a long approach, handing back to the target setpoint
+      near the tolerance band.  Flatleaded parts never see a step over maxDiff.
+     MeasureVoutDC() with ConverterOutput::ALL and the DMM now moves from one output's
+      relay to the next in a single path change (one switch matrix command, one
+      relay settling pause) rather than a separate reset and set per output.
+      VerifyPowerConnection() resets its misc line and DC relay together.
+     MeasureIoutDC() and MeasureVoutDC() pause and read through settleMeasure().  In
+      PauseStates' LEARN mode it reads at several points through the pause and
+      records the settling curve (ConverterOutput::ALL with the DMM then reads
+      output by output).  Otherwise it pauses once for GetPauseValue(), which in
+      APPLY mode is the learned value when that is shorter.
+
 	10/27/2009 MRB
 		Altered MeasureVoutDC to check if VariablesFile allows use of Load Meter.
 
@@ -168,6 +189,95 @@ namespace { // unnamed
         }
     };
     static EnumChecker checkEnums;
+
+    // Relay routing an output's DC voltage to the DMM
+    SwitchMatrixTraits::RelayTypes::DCRelay voutDCRelay(ConverterOutput::Output output) {
+        typedef SwitchMatrixTraits::RelayTypes SMR;
+        switch(stationPtr->Convert2LoadChannel(output)) {
+            case LoadTraits::TWO:   return(SMR::VOUTDC2);
+            case LoadTraits::THREE: return(SMR::VOUTDC3);
+            case LoadTraits::FOUR:  return(SMR::VOUTDC4);
+            case LoadTraits::FIVE:  return(SMR::VOUTDC5);
+            default:                return(SMR::VOUTDC1);
+        };
+    }
+
+    // Open the power connection check paths together --> one settling pause
+    void resetPowerCheckPaths(ControlMatrixTraits::RelayTypes::MiscRelay misc,
+                              SwitchMatrixTraits::RelayTypes::DCRelay relay) {
+        stationPtr->BeginPathChange();
+        try {
+            stationPtr->ResetPath(misc);
+            stationPtr->ResetPath(relay);
+        } catch(...) {
+            stationPtr->AbortPathChange();
+            throw;
+        }
+        stationPtr->CommitPathChange();
+    }
+
+    // One DMM reading through (relay) --> the relay is closed for the reading only
+    struct DMMReading {
+        explicit DMMReading(SwitchMatrixTraits::RelayTypes::DCRelay relay) 
+                                                               : relay_(relay)
+        { /* */ }
+        MType operator()() const {
+            stationPtr->SetPath(relay_);
+            stationPtr->SetDMM(); // auto by default
+            MType toRtn = stationPtr->MeasureDCV();
+            stationPtr->ResetPath(relay_);
+            return(toRtn);
+        }
+        SwitchMatrixTraits::RelayTypes::DCRelay relay_;
+    };
+
+    // One electronic load current reading
+    struct LoadCurrentReading {
+        explicit LoadCurrentReading(LoadTraits::Channels chan) : chan_(chan)
+        { /* */ }
+        MType operator()() const {
+            return(stationPtr->MeasureLoadCurrent(chan_));
+        }
+        LoadTraits::Channels chan_;
+    };
+
+    // One electronic load voltage reading, sign corrected by (mult)
+    struct LoadVoltsReading {
+        LoadVoltsReading(LoadTraits::Channels chan, const MType& mult) 
+                                                : chan_(chan), mult_(mult)
+        { /* */ }
+        MType operator()() const {
+            return(stationPtr->MeasureLoadVolts(chan_) * mult_);
+        }
+        LoadTraits::Channels chan_;
+        MType mult_;
+    };
+
+    // Pause for (type), then take one reading.  In LEARN mode the reading is taken
+    //  at each of PauseStates' settle points and the curve is recorded; the last is
+    //  at the full configured pause and is returned as usual.
+    template <typename Reading>
+    MType settleMeasure(PauseStates::PauseTypes type, const Reading& reading) {
+        PauseStates* ps = SingletonType<PauseStates>::Instance();
+        if ( ! ps->IsLearning() ) {
+            Pause(ps->GetPauseValue(type));
+            return(reading());
+        }
+        std::vector<SetType> points = ps->SettlePoints(type);
+        std::vector<SetType>::iterator i = points.begin();
+        PauseStates::SettleCurve curve;
+        std::clock_t start = std::clock();
+        while ( i != points.end() ) {
+            double elapsed = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+            if ( i->Value() > elapsed )
+                Pause(i->Value() - elapsed);
+            elapsed = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+            curve.push_back(std::make_pair(SetType(elapsed), reading()));
+            ++i;
+        } // while
+        ps->AddSettleCurve(type, curve);
+        return(curve.back().second);
+    }
 } // unnamed namespace
 
 /***************************************************************************************/
@@ -312,15 +422,21 @@ void EnforceTemperature(bool initialTemperature) {
     }
     
     try {
-        long counter = -1, maxCounter = 200;
-        bool done = false;        
-        SetType pauseBetweenMeasures = 3; // in seconds
+        // Poll rate follows the thermal model's predicted time to reach tolerance
+        const SetType defaultPause = 3, minPause = 1, maxPause = 10; // in seconds
+        const MType maxTime = 600; // in seconds
+        ThermalModel model;
+        Clock timer;
+        timer.StartTiming();
+        model.AddSample(timer.ElapsedTime(), currentTemperature);
         stationPtr->SetDMM(SPTSInstrument::DMM::AUTO, SPTSInstrument::DMM::TEMP);
-        while ( !done ) { // max time = maxCounter * pauseBetweenMeasures
+        while ( true ) {
             Assert<DUTExceptionTypes::TestAborted>(!oi->DidAbort(), name());
-            Assert<TemperatureTimeout>(++counter < maxCounter, name());
-            Pause(pauseBetweenMeasures);
+            Assert<TemperatureTimeout>(timer.ElapsedTime() < maxTime, name());
+            Pause(model.NextPause(lowerLimit, upperLimit, 
+                                  minPause, maxPause, defaultPause));
             currentTemperature = stationPtr->MeasureDUTTemperature();
+            model.AddSample(timer.ElapsedTime(), currentTemperature);
             if ( currentTemperature <= upperLimit ) {
                 if ( currentTemperature >= lowerLimit )
                     break;
@@ -465,36 +581,87 @@ void InitializeBaseTemperature(
     } // if
  
     // Go to temperature
-    bool first = true;
+    bool first = true, overshooting = false, overshot = false;
     OperatorInterface* oi = SingletonType<OperatorInterface>::Instance();
-    long cntr = 0, maxLoop = 200, pauseTime = 3; // timeout value = pauseTime * maxLoop
+    const SetType defaultPause = 3, minPause = 1, maxPause = 10; // in seconds
+    const SetType maxOvershoot = 10, handoff = tolerance * SetType(2);
+    const MType maxTime = 600, worthOvershoot = 60; // in seconds
+    ThermalModel model;
+    Clock timer;
     stationPtr->SetTemperatureBase(toTemp);
-    while ( difference > tolerance ) {       
-        Assert<DUTExceptionTypes::TestAborted>(!oi->DidAbort(), name());
-        Assert<TemperatureTimeout>(++cntr < maxLoop, name());
+    timer.StartTiming();
+    model.AddSample(timer.ElapsedTime(), currentTemp.Value());
+    try {
+        while ( difference > tolerance ) {       
+            Assert<DUTExceptionTypes::TestAborted>(!oi->DidAbort(), name());
+            Assert<TemperatureTimeout>(timer.ElapsedTime() < maxTime, name());
+
+            if ( first ) { // Update interface to show ramping temperature
+                if ( toTemp > currentTemp ) // heating
+                    oi->ShowWarmingTemperature();
+                else // cooling
+                    oi->ShowCoolingTemperature();
+                first = false;
+            }
+            currentTemp = stationPtr->MeasureBaseTemp().Value();                                   
+            if ( currentTemp >= zero ) {
+                if ( toTemp >= zero )
+                    difference = absolute(toTemp - currentTemp);
+                else // toTemp < zero
+                    difference = absolute(absolute(toTemp) + currentTemp);
+            }
+            else { // currentTemp < zero
+                if ( toTemp >= zero )
+                    difference = absolute(toTemp + absolute(currentTemp));
+                else // toTemp < zero
+                    difference = absolute(toTemp - currentTemp);
+            } // if
+            model.AddSample(timer.ElapsedTime(), currentTemp.Value());
+
+            if ( overshooting ) { // hand back to (toTemp) before reaching tolerance
+                if ( difference <= handoff ) {
+                    stationPtr->SetTemperatureBase(toTemp);
+                    model.Clear();
+                    overshooting = false;
+                }
+            }
+            else if ( (!overshot) && (difference > handoff) && model.IsFit() ) {
+                // Drive past (toTemp) only when the approach is predicted to be long
+                std::pair<bool, MType> remaining = model.TimeToReach(
+                                            MType((toTemp - tolerance).Value()),
+                                            MType((toTemp + tolerance).Value()));
+                if ( (!remaining.first) || (remaining.second > worthOvershoot) ) {
+                    SetType limit = maxOvershoot;
+                    if ( ! SingletonType<TestFixtureFile>::Instance()->DownLeaded() ) {
+                        SetType room = maxDiff - difference; // never step > maxDiff
+                        limit = (room < zero) ? zero : ((room < limit) ? room : limit);
+                    }
+                    SetType setpoint = model.OvershootSetpoint(toTemp, currentTemp, limit,
+                                                       iPtr->MinimumTemperature(),
+                                                       iPtr->MaximumTemperature());
+                    if ( setpoint != toTemp ) {
+                        stationPtr->SetTemperatureBase(setpoint);
+                        model.Clear();
+                        model.AddSample(timer.ElapsedTime(), currentTemp.Value());
+                        overshooting = overshot = true;
+                    }
+                }
+            }
 
-        if ( first ) { // Update interface to show ramping temperature
-            if ( toTemp > currentTemp ) // heating
-                oi->ShowWarmingTemperature();
-            else // cooling
-                oi->ShowCoolingTemperature();
-            first = false;
-        }
-        currentTemp = stationPtr->MeasureBaseTemp().Value();                                   
-        if ( currentTemp >= zero ) {
-            if ( toTemp >= zero )
-                difference = absolute(toTemp - currentTemp);
-            else // toTemp < zero
-                difference = absolute(absolute(toTemp) + currentTemp);
-        }
-        else { // currentTemp < zero
-            if ( toTemp >= zero )
-                difference = absolute(toTemp + absolute(currentTemp));
-            else // toTemp < zero
-                difference = absolute(toTemp - currentTemp);
-        } // if
-        Pause(pauseTime);
-    } // Loop while not within tolerance
+            if ( difference > tolerance ) {
+                SetType band = overshooting ? handoff : tolerance;
+                Pause(model.NextPause(MType((toTemp - band).Value()), 
+                                      MType((toTemp + band).Value()),
+                                      minPause, maxPause, defaultPause));
+            }
+        } // Loop while not within tolerance
+    } catch(...) {
+        if ( overshooting )
+            stationPtr->SetTemperatureBase(toTemp);
+        throw;
+    }
+    if ( overshooting ) // jumped straight into tolerance
+        stationPtr->SetTemperatureBase(toTemp);
 }
 
 //=====================
@@ -634,21 +801,15 @@ void MeasureIoutDC(ProgramTypes::MTypeContainer& iouts,
 				case LoadTraits::FIVE:  relay = SMR::IOUTDC5; break;
 			}; // Inner switch
 
-        // Pause
-        typedef SingletonType<PauseStates> PS;
-        Pause(PS::Instance()->GetPauseValue(PauseStates::IOUTDC));
-
-        // Use load for measurement if loadMeasure is set and using ELoad -
-        //   otherwise, use DMM
+        // Pause and measure: use load for measurement if loadMeasure is set and
+        //   using ELoad - otherwise, use DMM
         if ( loadMeasure && (stationPtr->LoadType() == LoadTraits::ELECTRONIC) ) {
             LoadTraits::Channels c = stationPtr->Convert2LoadChannel(output);        
-            iouts.push_back(stationPtr->MeasureLoadCurrent(c));
+            iouts.push_back(settleMeasure(PauseStates::IOUTDC, LoadCurrentReading(c)));
         } 
         else { // Use DMM
-            stationPtr->SetPath(relay);
-            stationPtr->SetDMM(); // Auto range, DCV mode by default
-			iouts.push_back(stationPtr->MeasureDCV() / tf->IoutShuntValue(fakeChan));
-            stationPtr->ResetPath(relay);        
+            MType volts = settleMeasure(PauseStates::IOUTDC, DMMReading(relay));
+			iouts.push_back(volts / tf->IoutShuntValue(fakeChan));
         }
 	}; // Outer switch
 }
@@ -673,52 +834,69 @@ ProgramTypes::MType MeasureVinDC() {
 void MeasureVoutDC(ProgramTypes::MTypeContainer& vouts, 
                    ConverterOutput::Output output, bool loadMeasure) {    
     typedef SwitchMatrixTraits::RelayTypes SMR;
-    typedef std::vector<LoadTraits::Channels> LoadChannels;
-    SMR::DCRelay relay = SMR::VOUTDC1;
+    typedef SingletonType<PauseStates> PS;
     std::vector<ConverterOutput::Output> outputs;
     std::vector<ConverterOutput::Output>::iterator i, j;
 
 	if(!SingletonType<Converter>::Instance()->UseLoadMeter()){
 		loadMeasure = SingletonType<Converter>::Instance()->UseLoadMeter();
 	}
+    bool useLoad = loadMeasure && (stationPtr->LoadType() == LoadTraits::ELECTRONIC);
 
 	switch(output) {
-		case ConverterOutput::ALL:  // Recursively call function for each output
+		case ConverterOutput::ALL:  
             outputs = SingletonType<Converter>::Instance()->Outputs();
             i = outputs.begin(); j = outputs.end();
-            while ( i != j ) {
-                MeasureVoutDC(vouts, *i, loadMeasure);
-                ++i;
+            if ( useLoad || PS::Instance()->IsLearning() ) { // Recurse per output
+                while ( i != j ) {
+                    MeasureVoutDC(vouts, *i, loadMeasure);
+                    ++i;
+                }
+            }
+            else if ( i != j ) { // Use DMM --> open last relay, close next as one
+                SMR::DCRelay last = voutDCRelay(*i);
+                try {
+                    while ( i != j ) {
+                        SMR::DCRelay relay = voutDCRelay(*i);
+                        Pause(PS::Instance()->GetPauseValue(PauseStates::VOUTDC));
+                        stationPtr->BeginPathChange();
+                        try {
+                            if ( relay != last )
+                                stationPtr->ResetPath(last);
+                            stationPtr->SetPath(relay);
+                        } catch(...) {
+                            stationPtr->AbortPathChange();
+                            throw;
+                        }
+                        stationPtr->CommitPathChange();
+                        last = relay;
+                        stationPtr->SetDMM(); // auto by default
+                        vouts.push_back(stationPtr->MeasureDCV());
+                        ++i;
+                    }
+                } catch(...) {
+                    stationPtr->ResetPath(last);
+                    throw;
+                }
+                stationPtr->ResetPath(last);
             }
 			break;
 
 		default:  // Any specific channel
             LoadTraits::Channels c = stationPtr->Convert2LoadChannel(output);
-            switch(c) {
-                case LoadTraits::ONE:   relay = SMR::VOUTDC1; break;
-                case LoadTraits::TWO:   relay = SMR::VOUTDC2; break;
-                case LoadTraits::THREE: relay = SMR::VOUTDC3; break;
-                case LoadTraits::FOUR:  relay = SMR::VOUTDC4; break;
-                case LoadTraits::FIVE:  relay = SMR::VOUTDC5; break;
-            }; // Inner switch
-
-            // Pause
-            typedef SingletonType<PauseStates> PS;
-            Pause(PS::Instance()->GetPauseValue(PauseStates::VOUTDC));
-
-            // Use Load unless loadMeasure is false or not using electronic loading
-            if ( loadMeasure && (stationPtr->LoadType() == LoadTraits::ELECTRONIC) ) {
+            SMR::DCRelay relay = voutDCRelay(output);
+
+            // Pause and measure: use Load unless loadMeasure is false or not using
+            //  electronic loading
+            if ( useLoad ) {
                 ProgramTypes::MType mult = 1;
                 if ( SingletonType<Converter>::Instance()->Vout(output) < 0 )
                     mult *= -1;
-                vouts.push_back(stationPtr->MeasureLoadVolts(c) * mult);
+                LoadVoltsReading reading(c, mult);
+                vouts.push_back(settleMeasure(PauseStates::VOUTDC, reading));
             }
-            else { // Use DMM
-                stationPtr->SetPath(relay);
-                stationPtr->SetDMM(); // auto by default
-			    vouts.push_back(stationPtr->MeasureDCV());
-                stationPtr->ResetPath(relay);
-            } // if-else
+            else // Use DMM
+			    vouts.push_back(settleMeasure(PauseStates::VOUTDC, DMMReading(relay)));
 	}; // Outer switch
 }
 
@@ -913,8 +1091,7 @@ std::pair<bool, ProgramTypes::MType> VerifyPowerConnection(
         ProgramTypes::MType vSource = stationPtr->MeasureDCV();
         stationPtr->SetVin(0);
         stationPtr->SetIinLimit(resetPSLimit);
-        stationPtr->ResetPath(powerMisc);
-        stationPtr->ResetPath(relay);
+        resetPowerCheckPaths(powerMisc, relay);
         Assert<InstrumentSetup>(vSource > zero, badConn);
         Assert<InstrumentSetup>(vin > zero, badConn);
         Assert<InstrumentSetup>(vSource > vin, badConn);
@@ -928,14 +1105,12 @@ std::pair<bool, ProgramTypes::MType> VerifyPowerConnection(
     } catch(InstrumentSetup&) {
         stationPtr->SetVin(0);
         stationPtr->SetIinLimit(resetPSLimit);
-        stationPtr->ResetPath(powerMisc);
-        stationPtr->ResetPath(relay);
+        resetPowerCheckPaths(powerMisc, relay);
         result = false;
     } catch(...) {
         stationPtr->SetVin(0);
         stationPtr->SetIinLimit(resetPSLimit);
-        stationPtr->ResetPath(powerMisc);
-        stationPtr->ResetPath(relay);
+        resetPowerCheckPaths(powerMisc, relay);
         throw;
     }
     return(std::make_pair(result, totalResistance));
@@ -15,6 +15,12 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     Added LotPath().
+     Added CostCalibration().
+
    ==============
    11/20/05, sjn,
    ==============
@@ -92,6 +98,28 @@ std::string StationFile::BackupLocalStorage() {
     return(toRtn);    
 }
 
+//===================
+// CostCalibration()
+//===================
+std::pair<bool, ProgramTypes::SetType> 
+                         StationFile::CostCalibration(const std::string& item) {
+    // Optional entries --> (false, 0) when "Cost <item>" is absent
+    typedef ProgramTypes::SetType SetType;
+    std::string value = RemoveAllWhiteSpace(sf_->GetVariableValue("Cost " + item));
+    if ( value.empty() )
+        return(std::make_pair(false, SetType(0)));
+
+    std::pair<SetType, ScaleUnits<SetType>::Units> p;
+    try {
+        p = ScaleUnits<SetType>::GetUnits(value);
+    } catch(...) {
+        throw(FileError(name()));
+    }
+    SetType toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);
+    Assert<FileError>(toRtn >= SetType(0), name());
+    return(std::make_pair(true, toRtn));
+}
+
 //=================
 // GetShuntValue()
 //=================
@@ -230,6 +258,16 @@ std::string StationFile::LocalTestEngArchive() {
     return(toRtn);
 }
 
+//===========
+// LotPath()
+//===========
+std::string StationFile::LotPath() {
+    std::string toRtn = 
+               RemoveAllWhiteSpace(sf_->GetVariableValue(archive, "Lot Path"));
+    Assert<FileError>(!toRtn.empty(), name());
+    return(toRtn);
+}
+
 //===================
 // MaxCurrentValue()
 //===================
@@ -8,6 +8,17 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Open() and Close() overloads now send one channel-list command per card, holding
+       only those relays that differ from the known state.  CustomReset() opens and
+       closes in a single command.
+     Added BeginTransaction(), CommitTransaction(), AbortTransaction() and
+       InTransaction().  While a transaction is open, Open(), Close() and
+       CustomReset() are queued and CommitTransaction() sends the net change as at
+       most one command per card.
+
    ==============
    05/23/05, sjn,
    ==============
@@ -28,6 +39,63 @@ namespace { // unnamed
     typedef StationExceptionTypes::ContainerState  ContainerState;
     typedef StationExceptionTypes::InstrumentError InstrumentError;
     typedef StationExceptionTypes::UnexpectedState UnexpectedState;
+
+    typedef SwitchMatrixTraits::ModelType::Language Language;
+
+    // Build a desired-state map from a list of relays
+    template <typename RelayMap, typename Container>
+    RelayMap wantedState(const Container& relays, Switch state) {
+        RelayMap toRtn;
+        typename Container::const_iterator i = relays.begin();
+        while ( i != relays.end() )
+            toRtn[*i++] = state;
+        return(toRtn);
+    }
+
+    // Copy (from) into (into) --> true if anything in (into) changed
+    template <typename RelayMap>
+    bool merge(RelayMap& into, const RelayMap& from, const std::string& name) {
+        bool changed = false;
+        typename RelayMap::const_iterator i = from.begin();
+        while ( i != from.end() ) {
+            typename RelayMap::iterator find = into.find(i->first);
+            Assert<ContainerState>(find != into.end(), name);
+            if ( find->second != i->second ) {
+                find->second = i->second;
+                changed = true;
+            }
+            ++i;
+        }
+        return(changed);
+    }
+
+    // Single command taking (known) to (wanted): opens first, then closes
+    template <typename RelayMap>
+    std::string pathSyntax(const RelayMap& known, const RelayMap& wanted, 
+                           const std::string& name) {
+        std::vector<long> toOpen, toClose;
+        typename RelayMap::const_iterator i = wanted.begin();
+        while ( i != wanted.end() ) {
+            typename RelayMap::const_iterator find = known.find(i->first);
+            Assert<ContainerState>(find != known.end(), name);
+            if ( find->second != i->second ) { // not already there
+                if ( i->second == ON )
+                    toClose.push_back(i->first);
+                else // OFF
+                    toOpen.push_back(i->first);
+            }
+            ++i;
+        }
+        std::string syntax;
+        if ( ! toOpen.empty() )
+            syntax = Language::Open(toOpen);
+        if ( ! toClose.empty() ) {
+            if ( ! syntax.empty() )
+                syntax += Language::Concatenate();
+            syntax += Language::Close(toClose);
+        }
+        return(syntax);
+    }
 } // unnamed
 
 /***************************************************************************************/
@@ -52,7 +120,11 @@ SwitchMatrix::SwitchMatrix(const RFRelayContainer& contRF,
       filter_(new FilterRelayMap),
       customResetDC_(new DCRelayMap),
       customResetRF_(new RFRelayMap),
-      customResetFilt_(new FilterRelayMap)  {
+      customResetFilt_(new FilterRelayMap),
+      inTransaction_(false),
+      pendingRF_(new RFRelayMap),
+      pendingDC_(new DCRelayMap),
+      pendingFilt_(new FilterRelayMap)  {
 
     Assert<BadArg>(!contRF.empty(), nameRF());
     Assert<BadArg>(!contDC.empty(), nameDC());
@@ -80,6 +152,25 @@ SwitchMatrix::SwitchMatrix(const RFRelayContainer& contRF,
 SwitchMatrix::~SwitchMatrix() 
 { /* */ }
 
+//====================
+// AbortTransaction()
+//====================
+void SwitchMatrix::AbortTransaction() {
+    // Nothing queued has been sent --> known states still match the hardware
+    inTransaction_ = false;
+}
+
+//====================
+// BeginTransaction()
+//====================
+void SwitchMatrix::BeginTransaction() {
+    Assert<UnexpectedState>(!inTransaction_, Name());
+    *pendingRF_   = *rf_;
+    *pendingDC_   = *dc_;
+    *pendingFilt_ = *filter_;
+    inTransaction_ = true;
+}
+
 //==============
 // bitprocess()
 //==============
@@ -141,14 +232,9 @@ bool SwitchMatrix::ChangedState(RelayType type) {
 // Close() Overload1
 //===================
 bool SwitchMatrix::Close(RFRelay relay) {
-    RFRelayMap::iterator find = rf_->find(relay);
-    Assert<ContainerState>(find != rf_->end(), nameRF());
-    if ( find->second == ON ) // already there
-        return(false);
-    std::string syntax = Language::Close(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::RF), nameRF());
-    find->second = ON;
-    return(true);
+    RFRelayMap wanted;
+    wanted[relay] = ON;
+    return(change(*rf_, *pendingRF_, wanted, RF, nameRF()));
 }
 
 //===================
@@ -156,49 +242,17 @@ bool SwitchMatrix::Close(RFRelay relay) {
 //===================
 bool SwitchMatrix::Close(const RFRelayContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameRF());
-    RFRelayContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    RFRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = rf_->find(*start);
-        start++;
-        Assert<ContainerState>(find != rf_->end(), nameRF());
-        if ( firstLoop && (find->second != ON) ) {
-            syntax = Language::Close(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != ON ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Close(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::RF), nameRF());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = rf_->find(*start);
-            find->second = ON;
-            ++start;
-        }        
-    }
-    return(actionDone);
+    RFRelayMap wanted = wantedState<RFRelayMap>(relays, ON);
+    return(change(*rf_, *pendingRF_, wanted, RF, nameRF()));
 }
 
 //===================
 // Close() Overload3
 //===================
 bool SwitchMatrix::Close(DCRelay relay) {
-    DCRelayMap::iterator find = dc_->find(relay);
-    Assert<ContainerState>(find != dc_->end(), nameDC());
-    if ( find->second == ON ) // already there
-        return(false);
-    std::string syntax = Language::Close(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::DC), nameDC());
-    find->second = ON;    
-    return(true);
+    DCRelayMap wanted;
+    wanted[relay] = ON;
+    return(change(*dc_, *pendingDC_, wanted, DC, nameDC()));
 }
 
 //===================
@@ -206,49 +260,17 @@ bool SwitchMatrix::Close(DCRelay relay) {
 //===================
 bool SwitchMatrix::Close(const DCRelayContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameDC());
-    DCRelayContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    DCRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = dc_->find(*start);
-        ++start;
-        Assert<ContainerState>(find != dc_->end(), nameDC());
-        if ( firstLoop && (find->second != ON) ) {
-            syntax = Language::Close(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != ON ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Close(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::DC), nameDC());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = dc_->find(*start);
-            find->second = ON;
-            ++start;
-        }
-    }
-    return(actionDone);
+    DCRelayMap wanted = wantedState<DCRelayMap>(relays, ON);
+    return(change(*dc_, *pendingDC_, wanted, DC, nameDC()));
 }
 
 //===================
 // Close() Overload5
 //===================
 bool SwitchMatrix::Close(FilterRelay relay) {
-    FilterRelayMap::iterator find = filter_->find(relay);
-    Assert<ContainerState>(find != filter_->end(), nameFilter());
-    if ( find->second == ON ) // already there
-        return(false);
-    std::string syntax = Language::Close(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::FILTER), nameFilter());
-    find->second = ON;    
-    return(true);
+    FilterRelayMap wanted;
+    wanted[relay] = ON;
+    return(change(*filter_, *pendingFilt_, wanted, FILTER, nameFilter()));
 }
 
 //===================
@@ -256,35 +278,25 @@ bool SwitchMatrix::Close(FilterRelay relay) {
 //===================
 bool SwitchMatrix::Close(const RFFilterContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameFilter());
-    RFFilterContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    FilterRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = filter_->find(*start);
-        ++start;
-        Assert<ContainerState>(find != filter_->end(), nameFilter());
-        if ( firstLoop && (find->second != ON) ) {
-            syntax = Language::Close(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != ON ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Close(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::FILTER), nameFilter());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = filter_->find(*start);
-            find->second = ON;
-            ++start;
-        }
-    }
-    return(actionDone);
+    FilterRelayMap wanted = wantedState<FilterRelayMap>(relays, ON);
+    return(change(*filter_, *pendingFilt_, wanted, FILTER, nameFilter()));
+}
+
+//==========
+// change()
+//==========
+template <typename RelayMap>
+bool SwitchMatrix::change(RelayMap& known, RelayMap& pending, const RelayMap& wanted,
+                          RelayType type, const std::string& name) {
+    if ( inTransaction_ ) // queue --> sent by CommitTransaction()
+        return(merge(pending, wanted, name));
+
+    std::string syntax = pathSyntax(known, wanted, name);
+    if ( syntax.empty() ) // already there
+        return(false);
+    Assert<UnexpectedState>(command(syntax, type), name);
+    merge(known, wanted, name);
+    return(true);
 }
 
 //===========
@@ -304,81 +316,37 @@ bool SwitchMatrix::command(const std::string& cmd, RelayType type) {
     };
 }
 
+//=====================
+// CommitTransaction()
+//=====================
+bool SwitchMatrix::CommitTransaction() {
+    // Net change only, one command per card
+    Assert<UnexpectedState>(inTransaction_, Name());
+    inTransaction_ = false;
+    bool changed = change(*rf_, *pendingRF_, *pendingRF_, RF, nameRF());
+    changed = change(*dc_, *pendingDC_, *pendingDC_, DC, nameDC()) || changed;
+    changed = change(*filter_, *pendingFilt_, *pendingFilt_, FILTER, nameFilter()) 
+              || changed;
+    return(changed);
+}
+
 //===============
 // CustomReset()
 //===============
 bool SwitchMatrix::CustomReset(RelayType type) {
-    RFRelayContainer toOpenRF, toCloseRF;
-	RFRelayMap::iterator startRF = customResetRF_->begin();
-    RFRelayMap::iterator stopRF = customResetRF_->end();
-    RFFilterContainer toOpen, toClose;
-    FilterRelayMap::iterator start = customResetFilt_->begin();
-    FilterRelayMap::iterator stop = customResetFilt_->end();
-    DCRelayContainer toOpenDC, toCloseDC;
-	DCRelayMap::iterator startDC = customResetDC_->begin();
-    DCRelayMap::iterator stopDC = customResetDC_->end();
-
     // Perform a user-defined custom reset on the 'type' of instr
-    bool check1 = true, check2 = true;
     switch(type) {
         case RF:
-            Assert<ContainerState>(startRF != stopRF, nameRF());
-            while ( startRF != stopRF ) {
-                if ( startRF->second == OFF )
-                    toOpenRF.push_back(startRF->first);
-                else // ON
-                    toCloseRF.push_back(startRF->first);
-                ++startRF;
-	        }
-            if ( ! toOpenRF.empty() )
-                check1 = Open(toOpenRF); 
-            else
-                check1 = false;
-
-            if ( ! toCloseRF.empty() )
-                check2 = Close(toCloseRF);
-            else
-                check2 = false;
-            break;
-       case FILTER:
-            Assert<ContainerState>(start != stop, nameFilter());
-            while ( start != stop ) {
-                if ( start->second == OFF )
-                    toOpen.push_back(start->first);
-                else // ON
-                    toClose.push_back(start->first);
-                ++start;
-	        }
-            if ( ! toOpen.empty() )
-                check1 = Open(toOpen); 
-            else
-                check1 = false;
-
-            if ( ! toClose.empty() )
-                check2 = Close(toClose);
-            else
-                check2 = false;
-            break;
-       default: // DC
-           Assert<ContainerState>(startDC != stopDC, nameDC());
-           while ( startDC != stopDC ) {
-               if ( startDC->second == OFF )
-                   toOpenDC.push_back(startDC->first);
-               else // ON
-                   toCloseDC.push_back(startDC->first);
-               ++startDC;
-	       }           
-           if ( ! toOpenDC.empty() )
-               check1 = Open(toOpenDC); 
-           else
-               check1 = false;
-
-           if ( ! toCloseDC.empty() )
-               check2 = Close(toCloseDC);
-           else
-               check2 = false;
+            Assert<ContainerState>(!customResetRF_->empty(), nameRF());
+            return(change(*rf_, *pendingRF_, *customResetRF_, RF, nameRF()));
+        case FILTER:
+            Assert<ContainerState>(!customResetFilt_->empty(), nameFilter());
+            return(change(*filter_, *pendingFilt_, *customResetFilt_, 
+                          FILTER, nameFilter()));
+        default: // DC
+            Assert<ContainerState>(!customResetDC_->empty(), nameDC());
+            return(change(*dc_, *pendingDC_, *customResetDC_, DC, nameDC()));
     };
-    return(check1 || check2);
 }
 
 //==============
@@ -392,6 +360,7 @@ bool SwitchMatrix::Initialize() {
 
     // Initialize SwitchMatrix Instrument
 	locked_ = false;
+    inTransaction_ = false;
     std::vector<RelayType> addresses;
     addresses.push_back(RF);  
     addresses.push_back(DC);
@@ -431,6 +400,13 @@ bool SwitchMatrix::Initialize() {
     return(true);
 }
 
+//=================
+// InTransaction()
+//=================
+bool SwitchMatrix::InTransaction() const {
+    return(inTransaction_);
+}
+
 //===========
 // IsError()
 //===========
@@ -471,14 +447,9 @@ std::string SwitchMatrix::nameRF() const {
 // Open() Overload1
 //==================
 bool SwitchMatrix::Open(RFRelay relay) {
-    RFRelayMap::iterator find = rf_->find(relay);
-    Assert<ContainerState>(find != rf_->end(), nameRF());
-    if ( find->second == OFF ) // already there
-        return(false);
-    std::string syntax = Language::Open(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::RF), nameRF());
-    find->second = OFF;
-    return(true);
+    RFRelayMap wanted;
+    wanted[relay] = OFF;
+    return(change(*rf_, *pendingRF_, wanted, RF, nameRF()));
 }
 
 //==================
@@ -486,49 +457,17 @@ bool SwitchMatrix::Open(RFRelay relay) {
 //==================
 bool SwitchMatrix::Open(const RFRelayContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameRF());
-    RFRelayContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    RFRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = rf_->find(*start);
-        ++start;
-        Assert<ContainerState>(find != rf_->end(), nameRF());
-        if ( firstLoop && (find->second != OFF) ) {
-            syntax = Language::Open(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != OFF ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Open(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::RF), nameRF());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = rf_->find(*start);
-            find->second = OFF;
-            ++start;
-        }        
-    }
-    return(actionDone);
+    RFRelayMap wanted = wantedState<RFRelayMap>(relays, OFF);
+    return(change(*rf_, *pendingRF_, wanted, RF, nameRF()));
 }
 
 //==================
 // Open() Overload3
 //==================
 bool SwitchMatrix::Open(DCRelay relay) {
-    DCRelayMap::iterator find = dc_->find(relay);
-    Assert<ContainerState>(find != dc_->end(), nameDC());
-    if ( find->second == OFF ) // already there
-        return(false);
-    std::string syntax = Language::Open(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::DC), nameDC());
-    find->second = OFF;
-    return(true);
+    DCRelayMap wanted;
+    wanted[relay] = OFF;
+    return(change(*dc_, *pendingDC_, wanted, DC, nameDC()));
 }
 
 //==================
@@ -536,49 +475,17 @@ bool SwitchMatrix::Open(DCRelay relay) {
 //==================
 bool SwitchMatrix::Open(const DCRelayContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameDC());
-    DCRelayContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    DCRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = dc_->find(*start);
-        ++start;
-        Assert<ContainerState>(find != dc_->end(), nameDC());
-        if ( firstLoop && (find->second != OFF) ) {
-            syntax = Language::Open(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != OFF ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Open(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::DC), nameDC());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = dc_->find(*start);
-            find->second = OFF;
-            ++start;
-        }
-    }
-    return(actionDone);
+    DCRelayMap wanted = wantedState<DCRelayMap>(relays, OFF);
+    return(change(*dc_, *pendingDC_, wanted, DC, nameDC()));
 }
 
 //==================
 // Open() Overload5
 //==================
 bool SwitchMatrix::Open(FilterRelay relay) {
-    FilterRelayMap::iterator find = filter_->find(relay);
-    Assert<ContainerState>(find != filter_->end(), nameFilter());
-    if ( find->second == OFF ) // already there
-        return(false);
-    std::string syntax = Language::Open(relay);
-    Assert<UnexpectedState>(command(syntax, RelayType::FILTER), nameFilter());
-    find->second = OFF;
-    return(true);
+    FilterRelayMap wanted;
+    wanted[relay] = OFF;
+    return(change(*filter_, *pendingFilt_, wanted, FILTER, nameFilter()));
 }
 
 //==================
@@ -586,35 +493,8 @@ bool SwitchMatrix::Open(FilterRelay relay) {
 //==================
 bool SwitchMatrix::Open(const RFFilterContainer& relays) {
     Assert<BadArg>(! relays.empty(), nameFilter());
-    RFFilterContainer::const_iterator start = relays.begin();
-    bool firstLoop = true;
-    std::string syntax = "";
-    FilterRelayMap::iterator find;
-    while ( start != relays.end() ) {
-        find = filter_->find(*start);
-        ++start;
-        Assert<ContainerState>(find != filter_->end(), nameFilter());
-        if ( firstLoop && (find->second != OFF) ) {
-            syntax = Language::Open(find->first);
-            firstLoop = false;
-        }
-        else if ( find->second != OFF ) { // not already there
-            syntax += Language::Concatenate(); 
-            syntax += Language::Open(find->first);
-        }
-    }
-    bool actionDone = false;
-    if ( ! syntax.empty() ) { // something to actually do
-        actionDone = true;
-        Assert<UnexpectedState>(command(syntax, RelayType::FILTER), nameFilter());
-        start = relays.begin();
-        while ( start != relays.end() ) {
-            find = filter_->find(*start);
-            find->second = OFF;
-            ++start;
-        }
-    }
-    return(actionDone);
+    FilterRelayMap wanted = wantedState<FilterRelayMap>(relays, OFF);
+    return(change(*filter_, *pendingFilt_, wanted, FILTER, nameFilter()));
 }
 
 //===============
@@ -0,0 +1,166 @@
+// Files included
+#include "Assertion.h"
+#include "Converter.h"
+#include "GenericAlgorithms.h"
+#include "ScaleUnits.h"
+#include "SingletonType.h"
+#include "SPTSException.h"
+#include "StringAlgorithms.h"
+#include "SymbolicExpression.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    typedef SymbolicExpression::SetType SetType;
+
+    const std::string LOADSUFFIX = "%LOAD";
+
+    std::string name() {
+        return("Symbolic Expression");
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+SymbolicExpression::SymbolicExpression()
+{ /* */ }
+
+//===========
+// Compile()
+//===========
+const SymbolicExpression&
+               SymbolicExpression::Compile(Kind kind, const std::string& text) {
+    typedef std::map<std::pair<Kind, std::string>, SymbolicExpression> Compiled;
+    static Compiled compiled;
+
+    std::pair<Kind, std::string> key(kind, Uppercase(RemoveAllWhiteSpace(text)));
+    Compiled::const_iterator found = compiled.find(key);
+    if ( found != compiled.end() )
+        return(found->second);
+
+    SymbolicExpression toAdd;
+    std::vector<std::string> terms = SplitString(key.second, '+');
+    Assert<BadArg>(!terms.empty(), name());
+    for ( std::size_t idx = 0; idx < terms.size(); ++idx )
+        toAdd.terms_.push_back(compileTerm(kind, terms[idx]));
+    return(compiled.insert(std::make_pair(key, toAdd)).first->second);
+}
+
+//============
+// Evaluate()
+//============
+SetType SymbolicExpression::Evaluate(ConverterOutput::Output channel) const {
+    Converter* converter = SingletonType<Converter>::Instance();
+    SetType toRtn = 0;
+    std::vector<Term>::const_iterator i = terms_.begin();
+    while ( i != terms_.end() ) {
+        SetType value = 0;
+        switch(i->symbol_) {
+            case CONSTANT:
+                value = 1;
+                break;
+            case FULLLOAD:
+                value = converter->Iout(channel);
+                break;
+            case LOWLINE:
+                value = converter->LowLine();
+                break;
+            case NOMINALLINE:
+                value = converter->NominalLine();
+                break;
+            default: // HIGHLINE
+                value = converter->HighLine();
+        };
+        toRtn = toRtn + (value * i->multiplier_) / i->divisor_;
+        ++i;
+    } // while
+    return(toRtn);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//===============
+// compileTerm()
+//===============
+SymbolicExpression::Term SymbolicExpression::compileTerm(Kind kind,
+                                                         const std::string& text) {
+    // (text) is uppercase without white space
+    Assert<BadArg>(!text.empty(), name());
+    Term toRtn;
+    toRtn.multiplier_ = 1;
+    toRtn.divisor_ = 1;
+    if ( LOAD == kind ) {
+        toRtn.symbol_ = FULLLOAD;
+        if ( text == "FULLLOAD" )
+            return(toRtn);
+        else if ( text == "HALFLOAD" ) {
+            toRtn.divisor_ = 2;
+            return(toRtn);
+        }
+        else if ( text == "NOLOAD" ) {
+            toRtn.symbol_ = CONSTANT;
+            toRtn.multiplier_ = 0;
+            return(toRtn);
+        }
+        else if ( text == "TEN" + LOADSUFFIX ) {
+            toRtn.divisor_ = 10;
+            return(toRtn);
+        }
+
+        // Any percentage of full load:  <number>% LOAD
+        std::string::size_type pos = text.rfind(LOADSUFFIX);
+        if ( (pos != std::string::npos) && (pos + LOADSUFFIX.size() == text.size()) ) {
+            std::string percent = text.substr(0, pos);
+            Assert<BadArg>(IsFloating(percent), name());
+            toRtn.multiplier_ = convert<SetType>(percent).Value() / 100.0;
+            return(toRtn);
+        }
+    }
+    else { // LINE
+        if ( text == "LOWLINE" ) {
+            toRtn.symbol_ = LOWLINE;
+            return(toRtn);
+        }
+        else if ( text == "NOMINALLINE" ) {
+            toRtn.symbol_ = NOMINALLINE;
+            return(toRtn);
+        }
+        else if ( text == "HIGHLINE" ) {
+            toRtn.symbol_ = HIGHLINE;
+            return(toRtn);
+        }
+    }
+
+    // Plain value with optional units
+    std::pair<SetType, ScaleUnits<SetType>::Units> p;
+    p = ScaleUnits<SetType>::GetUnits(text);
+    toRtn.symbol_ = CONSTANT;
+    toRtn.multiplier_ = ScaleUnits<SetType>::ScaleUp(p.first, p.second);
+    return(toRtn);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
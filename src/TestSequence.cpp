@@ -1,12 +1,17 @@
 // Files included
 #include "Assertion.h"
+#include "BatchScheduler.h"
 #include "Converter.h"
 #include "ConverterOutput.h"
+#include "CustomTestHandler.h"
 #include "DateTime.h"
+#include "ErrorLogger.h"
+#include "FailureHistory.h"
 #include "Functions.h"
 #include "LimitsFile.h"
 #include "MeasurementFunctions.h"
 #include "ScaleUnits.h"
+#include "SequenceProfiler.h"
 #include "SingletonType.h"
 #include "SPTS.h"
 #include "SPTSException.h"
@@ -20,6 +25,40 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+  ================
+  10/19/26, agent,
+  ================
+      speedUp() and updateSpeedMap() now go through resultCache_ --> values are hashed
+        on canonical test conditions and refer back to the sequence_ entry they came
+        from instead of storing a TestStepInfo copy per value.  Synchronize() clears
+        the cache before sequence_ is rebuilt.  Added GetCacheStatistics().
+      Added EstimateSequence() --> dry-run SequenceCost of the synchronized sequence.
+      doSequence() tells ErrorLogger which test step is running (SetStep()) so that
+        structured error records carry it, and clears the step when it ends.
+      Measurement types are resolved to integer ids once, in Synchronize():  dispatch_
+        holds one id per sequence_ entry and indexes measurements_, which owns one
+        Measurement object per type.  Those objects are Reset() and reused for every
+        step and every DUT --> replaced checkTestName() and createMeasurement() with
+        measurementID() and getMeasurement(); doSequence() no longer deletes.
+      PerformSequence() starts a SequenceProfiler run for each DUT.  Every step is a
+        profiler step; GUI calls, temperature enforcement, result cache lookups
+        (speedUp()) and checkSystemErrors() are timed as phases of their own.
+      Added riskOrder().  When the lot file's policy is FAILFAST (BatchScheduler) and
+        this is a production run, Synchronize() reorders the steps so that those
+        finding the most archived failures (FailureHistory) per estimated second
+        (SequenceCost) run first, and doSequence() stops at the first failure.
+        order_ keeps each step's limits file position:  GetTests() still reports in
+        limits file order, and GetSkippedTests() lists the steps never run.
+        Steps that take their values from another step's extra measurements (see
+        dependencies()) are ordered as one group with that step and stay after it.
+      Added skipLot().  When the lot file's policy is SKIPLOT (BatchScheduler) and
+        this is a production run, Synchronize() leaves out steps whose archived
+        production results are capable and stable (FailureHistory::GetCapability())
+        unless the step is due its every Nth measurement.  GetSampledOutTests() lists
+        them with their Cpk.  A step is skipped only along with every step that takes
+        its value from it (dependencies()).  riskOrder() and skipLot() share
+        failureHistory().
+
   =================
   03/27/06, HQP,FAC
   =================
@@ -147,6 +186,8 @@ namespace {
     // User interface exceptions
     typedef UserInputExceptionTypes::UserInterfaceError InterfaceError;
 
+    typedef SequenceProfiler Profiler;
+
     ProgramTypes::MType tooBig   = 8E9;
     ProgramTypes::MType tooSmall = tooBig * ProgramTypes::MType(-1);
     std::string nonMeasure = SPTSMeasurement::Measurement::BadMeasurementStr;
@@ -162,8 +203,8 @@ namespace {
 //=============
 TestSequence::TestSequence() : sequence_(new VecTestInfo),
                                fakeTest_("n/a", TestStepInfo::TestStep::NODUTERROR),
-                               diagnosticFailure_(false),
-                               speedSequence_(new SpeedMapType), status_(false),
+                               diagnosticFailure_(false), riskOrdered_(false),
+                               resultCache_(new ResultCache), status_(false),
                                testCounter_(0), sync_(false) {
     oi_ = SingletonType<OperatorInterface>::Instance();
 }
@@ -171,13 +212,17 @@ TestSequence::TestSequence() : sequence_(new VecTestInfo),
 //============
 // Destructor
 //============
-TestSequence::~TestSequence() 
-{ /* */ }
+TestSequence::~TestSequence() {
+    std::vector<SPTSMeasurement::Measurement*>::iterator i = measurements_.begin();
+    while ( i != measurements_.end() )
+        delete *i++;
+}
 
 //=====================
 // checkSystemErrors()
 //=====================
 void TestSequence::checkSystemErrors(const std::string& testName) {
+    Profiler::Timer timer(Profiler::ERRORCHECK);
     typedef SpacePowerTestStation::SPTS StationType;    
     StationType* station = SingletonType<StationType>::Instance();
     if ( station->IsError() ) {
@@ -195,26 +240,35 @@ void TestSequence::checkSystemErrors(const std::string& testName) {
     }
 }
 
-//=================
-// checkTestName()
-//=================
-void TestSequence::checkTestName(TestStepInfo::TSPtr tptr) {
-    typedef SPTSMeasurement::Measurement::MFactory MF;
-    std::string tName = Uppercase(tptr->SoftwareTestName());
-    Assert<FileError>(MF::Instance()->IsRegistered(tName), name());
-}
-
-//=====================
-// createMeasurement()
-//=====================
-SPTSMeasurement::Measurement* 
-                          TestSequence::createMeasurement(TestStepInfo::TSPtr tptr) {
-    // Create measurement object 
-    typedef SPTSMeasurement::Measurement::MFactory MF;    
-    SPTSMeasurement::Measurement* toMeasure;
-    toMeasure = MF::Instance()->CreateObject(Uppercase(tptr->SoftwareTestName()));    
-    Assert<UnexpectedState>(toMeasure != 0, name());
-    return(toMeasure);
+//================
+// dependencies()
+//================
+std::vector<std::size_t> TestSequence::dependencies() const {
+    // For each sequence_ step, the index of the step that ultimately supplies its
+    //  value through extra measurements (Measurement::DependsOn()), or its own index
+    //  if it stands alone.  The supplier is the nearest earlier step of the named
+    //  measurement whose conditions the dependent accepts, else the nearest earlier.
+    std::vector<std::size_t> toRtn;
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        toRtn.push_back(idx);
+        SPTSMeasurement::Measurement* m = measurements_[dispatch_[idx]];
+        std::string supplier = Uppercase(m->DependsOn());
+        if ( supplier.empty() )
+            continue;
+        std::size_t nearest = idx;
+        for ( std::size_t prev = idx; prev-- > 0; ) {
+            if ( Uppercase(measurements_[dispatch_[prev]]->GetName()) != supplier )
+                continue;
+            if ( nearest == idx )
+                nearest = prev;
+            if ( m->DoneAlready((*sequence_)[idx], (*sequence_)[prev]) ) {
+                nearest = prev;
+                break;
+            }
+        } // for
+        toRtn[idx] = toRtn[nearest];
+    } // for
+    return(toRtn);
 }
 
 //==============
@@ -237,12 +291,16 @@ void TestSequence::doSequence() {
         tenPercLoads.push_back(a->Value() / 10.0);
         ++a;
     }
+    ErrorLogger& errorLog = (*SingletonType<ErrorLogger>::Instance());
+    errorLog.SetStep("Pretest");
+    Profiler* profiler = SingletonType<Profiler>::Instance();
     bool realStatus = true, last = false;  //This line was moved from line 319
 										   //to here to make sure that we declared
 										   //bool realStatus prior to using it.
 
     // Display upcoming tests to the operator    
     {        
+        Profiler::Timer gui(Profiler::GUI);
         std::vector<TestStepInfo::TSPtr> toDisplay;
         VecTestInfo::iterator i = sequence_->begin();
         while ( i != sequence_->end() ) {
@@ -308,6 +366,7 @@ void TestSequence::doSequence() {
     // Re-display upcoming tests to the operator if diagnosticMeasurements_ non-empty
     {
         if ( !diagnosticMeasurements_.empty() ) {       
+            Profiler::Timer gui(Profiler::GUI);
             std::vector<TestStepInfo::TSPtr> toDisplay;
             VecTestInfo::iterator i = sequence_->begin();
             while ( i != sequence_->end() ) {
@@ -326,7 +385,7 @@ void TestSequence::doSequence() {
     } // end local scope
 
     // Set members for sequence
-    stopOnFailure_ = oi_->GetStopOnFirstFailure();
+    stopOnFailure_ = oi_->GetStopOnFirstFailure() || riskOrdered_;
     bool initialTemp = true;    
 
     // Local vars
@@ -335,6 +394,7 @@ void TestSequence::doSequence() {
 
     // Initialize temperature
     try{
+        Profiler::Timer temperature(Profiler::TEMPERATURE);
         SpacePowerTestStation::EnforceTemperature(initialTemp);
     } catch(DUTExceptionTypes::TestAborted& ta) {
         diagnosticFailure_ = true;
@@ -360,12 +420,16 @@ void TestSequence::doSequence() {
         last = false;
  
         try {           
+            // Anything logged or timed from here on belongs to this step
+            errorLog.SetStep(getTestPointer(*i)->SoftwareTestName());
+            profiler->StartStep(getTestPointer(*i)->SoftwareTestName());
+
             // See if there is any GUI error condition
             if ( oi_->IsUIError() )
                 throw(InterfaceError(oi_->WhatUIError()));        
 
-            // Create measurement object
-            toMeasure = createMeasurement(*i);
+            // Pooled measurement object for this step
+            toMeasure = getMeasurement(testCounter_);
 
             // See if we can get out of making the next measurement
             std::pair<bool, ProgramTypes::MType> speed = speedUp(*i, toMeasure);            
@@ -374,6 +438,7 @@ void TestSequence::doSequence() {
                 last = nextTest(*i, *i, *i, speed.second);
             else { // make next measurement
                 if ( temperatureTimer.ElapsedTime() > time ) { // time to check temp?
+                    Profiler::Timer temperature(Profiler::TEMPERATURE);
                     SpacePowerTestStation::EnforceTemperature(initialTemp);
                     temperatureTimer.Clear(); 
                     temperatureTimer.StartTiming(); // restart clock
@@ -391,11 +456,11 @@ void TestSequence::doSequence() {
                 i->setResult(false); // failure            
             }
 
-            // See if the operator aborted the test
-            Assert<DUTExceptionTypes::TestAborted>(!oi_->DidAbort(), name);
-
-            // Update GUI
-            oi_->DisplayTestResult(*i);
+            { // See if the operator aborted the test; update GUI
+                Profiler::Timer gui(Profiler::GUI);
+                Assert<DUTExceptionTypes::TestAborted>(!oi_->DidAbort(), name);
+                oi_->DisplayTestResult(*i);
+            }
 
             // Update counters
             ++i;
@@ -406,13 +471,7 @@ void TestSequence::doSequence() {
                 if ( stopOnFailure_ )
                     break;
             }
-
-            // Clean up
-            delete toMeasure;
-            toMeasure = 0;
         } catch(DUTExceptionTypes::TestAborted& ta) {
-            if ( toMeasure ) // clean up
-                delete(toMeasure);
             if ( i != sequence_->begin() ) {
                 // Show an aborted test on previous test step via an error code,
                 //  but do not change measurement or P-F status --> just keep
@@ -429,8 +488,6 @@ void TestSequence::doSequence() {
             oi_->SetSequenceResult(false); // show sequence failure
             throw(ta);
         } catch(DUTExceptionTypes::BaseException& dbe) {
-            if ( toMeasure ) // clean up
-                delete(toMeasure);
             if ( i != j ) {
                 i->setMeasuredValueExplicit(nonMeasure);
                 i->setErrorCode(dbe.GetExceptionID());
@@ -440,8 +497,6 @@ void TestSequence::doSequence() {
             oi_->SetSequenceResult(false); // show sequence failure
             throw(dbe);         
         } catch(...) {
-            if ( toMeasure ) // clean up
-                delete(toMeasure);
             oi_->SetSequenceResult(false); // show sequence failure
             throw;
         }         
@@ -454,6 +509,7 @@ void TestSequence::doSequence() {
         status_ = false;
 
     // Power the system down
+    profiler->StartStep("Power Down");
     SingletonType<SpacePowerTestStation::SPTS>::Instance()->SafeInhibit(ON);
     SingletonType<SpacePowerTestStation::SPTS>::Instance()->PowerDown();
     SingletonType<SpacePowerTestStation::SPTS>::Instance()->SafeInhibit(OFF);
@@ -463,6 +519,28 @@ void TestSequence::doSequence() {
 
     // Show operator test sequence result
     oi_->SetSequenceResult(SequenceStatus());
+    errorLog.SetStep(""); // later records belong to no step
+}
+
+//==================
+// failureHistory()
+//==================
+FailureHistory* TestSequence::failureHistory(std::string& familyDash,
+                                             std::string& testType) {
+    // Archived history brought up to date; 0 if there is no production archive.
+    //  (familyDash) and (testType) are set as DataArchive writes them.
+    Converter* dut = SingletonType<Converter>::Instance();
+    familyDash = dut->FamilyNumber() + "-" + dut->DashNumber();
+    CustomTestHandler cth(oi_->GetTestType());
+    testType = cth.IsArbitraryTestName() ? cth.GetArbitraryTestName()
+                                         : cth.GetFullTestName();
+    FailureHistory* toRtn = SingletonType<FailureHistory>::Instance();
+    try {
+        toRtn->Synchronize(SingletonType<StationFile>::Instance()->LocalArchive());
+    } catch(FileError&) {
+        return(0);
+    }
+    return(toRtn);
 }
 
 //==================
@@ -472,6 +550,17 @@ TestStepInfo::CondPtr TestSequence::getCondPointer(TestStepInfo::CondPtr cptr) {
     return(cptr);
 }
 
+//==================
+// getMeasurement()
+//==================
+SPTSMeasurement::Measurement* TestSequence::getMeasurement(long step) {
+    // Flat table lookup --> ids were resolved by Synchronize()
+    Assert<UnexpectedState>(std::size_t(step) < dispatch_.size(), name());
+    SPTSMeasurement::Measurement* toRtn = measurements_[dispatch_[step]];
+    toRtn->Reset();
+    return(toRtn);
+}
+
 //==================
 // getTestPointer()
 //==================
@@ -479,6 +568,25 @@ TestStepInfo::TSPtr TestSequence::getTestPointer(TestStepInfo::TSPtr tptr) {
     return(tptr);
 }
 
+//====================
+// EstimateSequence()
+//====================
+SequenceCost TestSequence::EstimateSequence(const ProgramTypes::SetType& startTemp) {
+    // Walks sequence_ without touching station hardware
+    Assert<BadClassState>(sync_, name());
+    SequenceCost toRtn;
+    toRtn.Estimate(*sequence_, startTemp);
+    return(toRtn);
+}
+
+//======================
+// GetCacheStatistics()
+//======================
+std::pair<long, long> TestSequence::GetCacheStatistics() const {
+    // (hits, misses) since program start
+    return(std::make_pair(resultCache_->Hits(), resultCache_->Misses()));
+}
+
 //===============================
 // GetPreTestDiagnosticFailure()
 //===============================
@@ -498,15 +606,43 @@ std::vector<TestStepDiagnostic> TestSequence::GetPreTestDiagnosticsMeasurements(
     return(diagnosticMeasurements_);
 }
 
+//======================
+// GetSampledOutTests()
+//======================
+std::vector< std::pair<TestStepInfo, double> > TestSequence::GetSampledOutTests() const {
+    // Steps left out by skip-lot testing, with their Cpk, in limits file order
+    return(sampledOut_);
+}
+
+//===================
+// GetSkippedTests()
+//===================
+std::vector<TestStepInfo> TestSequence::GetSkippedTests() const {
+    // Steps not run (stopped on failure or aborted), in limits file order
+    Assert<UnexpectedState>(std::size_t(testCounter_) <= sequence_->size(), name());
+    std::map<std::size_t, std::size_t> byLimits; // limits file index to sequence_
+    for ( std::size_t idx = testCounter_; idx < sequence_->size(); ++idx )
+        byLimits.insert(std::make_pair(order_[idx], idx));
+    std::vector<TestStepInfo> toRtn;
+    std::map<std::size_t, std::size_t>::const_iterator i = byLimits.begin();
+    while ( i != byLimits.end() )
+        toRtn.push_back((*sequence_)[(i++)->second]);
+    return(toRtn);
+}
+
 //============
 // GetTests()
 //============
 std::vector<TestStepInfo> TestSequence::GetTests() const {
-    std::vector<TestStepInfo> toRtn;
+    // Steps run, in limits file order even if risk ordered
     Assert<UnexpectedState>(std::size_t(testCounter_) <= sequence_->size(), name());
-    std::vector<TestStepInfo>::const_iterator s = sequence_->begin(), beg = s;
-    std::advance(s, testCounter_);
-    std::copy(beg, s, std::back_inserter(toRtn));
+    std::map<std::size_t, std::size_t> byLimits; // limits file index to sequence_
+    for ( std::size_t idx = 0; idx < std::size_t(testCounter_); ++idx )
+        byLimits.insert(std::make_pair(order_[idx], idx));
+    std::vector<TestStepInfo> toRtn;
+    std::map<std::size_t, std::size_t>::const_iterator i = byLimits.begin();
+    while ( i != byLimits.end() )
+        toRtn.push_back((*sequence_)[(i++)->second]);
     return(toRtn);
 }
 
@@ -527,6 +663,35 @@ bool TestSequence::IsPreTestDiagnosticFailure() const {
     return(diagnosticFailure_);
 }
 
+//=================
+// IsRiskOrdered()
+//=================
+bool TestSequence::IsRiskOrdered() const {
+    return(riskOrdered_);
+}
+
+//=================
+// measurementID()
+//=================
+std::size_t TestSequence::measurementID(TestStepInfo::TSPtr tptr) {
+    // Each measurement type is looked up by name and created once, ever
+    typedef SPTSMeasurement::Measurement::MFactory MF;
+    std::string tName = Uppercase(tptr->SoftwareTestName());
+    std::map<std::string, std::size_t>::const_iterator found;
+    found = measurementIDs_.find(tName);
+    if ( found != measurementIDs_.end() )
+        return(found->second);
+
+    Assert<FileError>(MF::Instance()->IsRegistered(tName), name());
+    std::auto_ptr<SPTSMeasurement::Measurement> toAdd(MF::Instance()->CreateObject(tName));
+    Assert<UnexpectedState>(toAdd.get() != 0, name());
+    std::size_t toRtn = measurements_.size();
+    measurements_.push_back(toAdd.get());
+    toAdd.release();
+    measurementIDs_.insert(std::make_pair(tName, toRtn));
+    return(toRtn);
+}
+
 //========
 // name()
 //========
@@ -567,6 +732,10 @@ bool TestSequence::nextTest(TestStepInfo::TSPtr tptr, TestStepInfo::CondPtr,
 void TestSequence::PerformSequence() {
     Assert<BadClassState>(sync_, name());
 
+    // Time this DUT's sequence, phase by phase
+    Converter* dut = SingletonType<Converter>::Instance();
+    SingletonType<Profiler>::Instance()->Start(dut->FamilyNumber(), dut->SerialNumber());
+
     // Set up test sequence information and variables
     typedef SpacePowerTestStation::SPTS StationType;
     StationType* station = SingletonType<SpacePowerTestStation::SPTS>::Instance();
@@ -606,6 +775,7 @@ void TestSequence::PerformSequence() {
         // Set base plate temperature
         nextTemp += offsetTemp;
         try {
+            Profiler::Timer temperature(Profiler::TEMPERATURE);
             SpacePowerTestStation::InitializeBaseTemperature(nextTemp, posTol, negTol);
         } catch(DUTExceptionTypes::TestAborted& ta) {
             diagnosticFailure_ = true;
@@ -621,6 +791,64 @@ void TestSequence::PerformSequence() {
     doSequence();
 }
 
+//=============
+// riskOrder()
+//=============
+void TestSequence::riskOrder() {
+    // Most archived failures found per second first.  Ties, including steps that
+    //  have never failed, keep limits file order.
+    static const long minHistory = 10; // archived sequences needed to reorder
+    static const double minSeconds = 0.1;
+
+    std::string familyDash, testType;
+    FailureHistory* history = failureHistory(familyDash, testType);
+    if ( !history || (history->NumberSequences(familyDash, testType) < minHistory) )
+        return;
+
+    SequenceCost cost = EstimateSequence(
+                            SingletonType<VariablesFile>::Instance()->GetTemperature());
+    // A step and those taking their values from its extra measurements move as one
+    //  group, scored on the group's failures per second and kept in limits order
+    std::vector<std::size_t> lead = dependencies();
+    std::vector<double> rates(sequence_->size(), 0.0), seconds(sequence_->size(), 0.0);
+    std::vector< std::vector<std::size_t> > members(sequence_->size());
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        TestStepInfo::TSPtr tptr = getTestPointer((*sequence_)[idx]);
+        rates[lead[idx]] += history->FailureRate(familyDash, testType, tptr->TestName());
+        seconds[lead[idx]] += cost.StepTotal(static_cast<long>(idx)).Value();
+        members[lead[idx]].push_back(idx);
+    } // for
+    std::vector< std::pair<double, std::size_t> > score; // (-rate/seconds, lead)
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        if ( lead[idx] == idx )
+            score.push_back(std::make_pair(-rates[idx] / std::max(seconds[idx],
+                                                                 minSeconds), idx));
+    } // for
+    std::sort(score.begin(), score.end()); // index breaks ties --> stable
+
+    std::auto_ptr<VecTestInfo> ordered(new VecTestInfo);
+    std::vector<std::size_t> dispatch, order;
+    std::vector<bool> dependent;
+    for ( std::size_t idx = 0; idx < score.size(); ++idx ) {
+        const std::vector<std::size_t>& group = members[score[idx].second];
+        for ( std::size_t jdx = 0; jdx < group.size(); ++jdx ) {
+            std::size_t from = group[jdx];
+            ordered->push_back((*sequence_)[from]);
+            dispatch.push_back(dispatch_[from]);
+            order.push_back(order_[from]);
+            dependent.push_back(lead[from] != from);
+        } // for
+    } // for
+    sequence_ = ordered;
+    dispatch_.swap(dispatch);
+    order_.swap(order);
+
+    // Every dependent step must still follow a step that supplies its value
+    lead = dependencies();
+    for ( std::size_t idx = 0; idx < lead.size(); ++idx )
+        Assert<UnexpectedState>(!dependent[idx] || (lead[idx] != idx), name());
+}
+
 //==================
 // SequenceStatus()
 //==================
@@ -666,6 +894,93 @@ void TestSequence::setResult(const ProgramTypes::PairMType& limits,
     currentTest.setResult(result);
 }
 
+//===========
+// skipLot()
+//===========
+void TestSequence::skipLot(long rate, double minCpk) {
+    // Leave out steps that are capable (Cpk >= minCpk, for both the all-time and
+    //  the recent mean against today's limits) and stable (no recent failure, recent
+    //  mean within 3 standard errors of the all-time mean).  A step is still
+    //  measured once every (rate) archived sequences --> its history stays current.
+    static const long minSamples = 100; // valid archived values needed to skip
+
+    std::string familyDash, testType;
+    FailureHistory* history = failureHistory(familyDash, testType);
+    if ( !history )
+        return;
+
+    static const double notCapable = -1;
+
+    std::vector<double> cpks(sequence_->size(), notCapable);
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        TestStepInfo::TSPtr tptr = getTestPointer((*sequence_)[idx]);
+        FailureHistory::Capability c;
+        c = history->GetCapability(familyDash, testType, tptr->TestName());
+        if ( (c.Samples < minSamples) || (c.RecentSamples == 0) || c.RecentFailure )
+            continue;
+        if ( c.SinceLastRun + 1 >= rate ) // due
+            continue;
+        if ( c.Sigma <= 0 ) // no spread seen --> resolution bound, not capable
+            continue;
+        double stdError = c.Sigma / std::sqrt(static_cast<double>(c.RecentSamples));
+        if ( std::fabs(c.RecentMean - c.Mean) > 3 * stdError ) // drifting
+            continue;
+
+        ProgramTypes::PairMType limits = tptr->Limits();
+        double margin = std::min(std::min(c.Mean, c.RecentMean) - limits.first.Value(),
+                                 limits.second.Value() - std::max(c.Mean, c.RecentMean));
+        cpks[idx] = margin / (3 * c.Sigma);
+    } // for
+
+    // A step and those taking their values from its extra measurements are skipped
+    //  or kept as one group --> a group is as capable as its least capable step
+    std::vector<std::size_t> lead = dependencies();
+    std::vector<double> groupCpk(sequence_->size(), 0.0);
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        if ( lead[idx] == idx )
+            groupCpk[idx] = cpks[idx];
+        else
+            groupCpk[lead[idx]] = std::min(groupCpk[lead[idx]], cpks[idx]);
+    } // for
+    std::vector< std::pair<double, std::size_t> > skips; // (Cpk, lead)
+    std::size_t groups = 0;
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        if ( lead[idx] != idx )
+            continue;
+        ++groups;
+        if ( groupCpk[idx] >= minCpk )
+            skips.push_back(std::make_pair(groupCpk[idx], idx));
+    } // for
+    if ( skips.size() == groups ) // never skip every step
+        skips.erase(std::min_element(skips.begin(), skips.end()));
+    if ( skips.empty() )
+        return;
+
+    std::set<std::size_t> skippedLeads;
+    for ( std::size_t idx = 0; idx < skips.size(); ++idx )
+        skippedLeads.insert(skips[idx].second);
+    std::map<std::size_t, double> skipped; // sequence_ index to Cpk
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        if ( skippedLeads.find(lead[idx]) != skippedLeads.end() )
+            skipped.insert(std::make_pair(idx, cpks[idx]));
+    } // for
+    std::auto_ptr<VecTestInfo> kept(new VecTestInfo);
+    std::vector<std::size_t> dispatch, order;
+    for ( std::size_t idx = 0; idx < sequence_->size(); ++idx ) {
+        std::map<std::size_t, double>::const_iterator found = skipped.find(idx);
+        if ( found != skipped.end() ) {
+            sampledOut_.push_back(std::make_pair((*sequence_)[idx], found->second));
+            continue;
+        }
+        kept->push_back((*sequence_)[idx]);
+        dispatch.push_back(dispatch_[idx]);
+        order.push_back(order_[idx]);
+    } // for
+    sequence_ = kept;
+    dispatch_.swap(dispatch);
+    order_.swap(order);
+}
+
 //===========
 // speedUp()
 //===========
@@ -673,30 +988,18 @@ std::pair<bool, ProgramTypes::MType>
                    TestSequence::speedUp(const TestStepInfo& currentTest, 
                                  SPTSMeasurement::Measurement* toMeasure) {
 
-    // Locals
-    typedef std::pair<SpeedMapType::iterator, SpeedMapType::iterator> pairType;
-    pairType p = speedSequence_->equal_range(currentTest);
-    TestStepInfo::CondPtr cptr = getCondPointer(currentTest);
+    // If a stored value satisfies the cache's validity rules, return (true, value)
+    Profiler::Timer timer(Profiler::CACHE);
+    std::pair<bool, ProgramTypes::MType> found = 
+                                          resultCache_->Find(currentTest, toMeasure);
+    if ( ! found.first )
+        return(found);
+
     TestStepInfo::TSPtr t = getTestPointer(currentTest);
     ScaleUnits<ProgramTypes::MType>::Units u;
     u = ScaleUnits<ProgramTypes::MType>::MakeUnits(t->Units());
-
-    // If channel info is correct and test is DoneAlready(), 
-    //   then return (true, measurement)
-    while ( p.first != p.second ) {
-        TestResults::iterator tResults = p.first->second.find(cptr->Channel());
-        if ( tResults != p.first->second.end() ) {
-            if ( toMeasure->DoneAlready(currentTest, p.first->first) ) {
-                ProgramTypes::MType toRtn = 
-                        ScaleUnits<ProgramTypes::MType>::ScaleDown(tResults->second, u);
-                p.first->second.erase(tResults); // don't reuse this value
-                return(std::make_pair(true, toRtn));
-            }
-        }
-        ++p.first;
-    }    
-    // Nothing found if here     
-    return(std::make_pair(false, 0));
+    found.second = ScaleUnits<ProgramTypes::MType>::ScaleDown(found.second, u);
+    return(found);
 }
 
 //===============
@@ -706,27 +1009,44 @@ void TestSequence::Synchronize() {
     // Initialize members
     testCounter_ = 0;
     status_ = false;
-    speedSequence_.reset(new SpeedMapType);
-    sequence_.reset(new VecTestInfo);
+    resultCache_->Clear(SingletonType<VariablesFile>::Instance()->GetTemperature());
+    sequence_.reset(new VecTestInfo); // after Clear() --> cache refers to sequence_
     fakeTest_ = TestStepDiagnosticFacadeFailure(
                                              "n/a",
                                              TestStepInfo::TestStep::NODUTERROR
                                                );
     diagnosticFailure_ = false;
     diagnosticMeasurements_.clear();
+    dispatch_.clear();
+    order_.clear();
+    riskOrdered_ = false;
+    sampledOut_.clear();
 
-    // Grab tests for the sequence; check names
+    // Grab tests for the sequence; resolve measurement types
     LimitsFile* lf = SingletonType<LimitsFile>::Instance();
     lf->RestartSameTest();
     Assert<UnexpectedState>(lf->NumberTests() > 0, name());    
     while ( !lf->AtEnd() ) {
         TestStepInfo tmp(lf);
+        order_.push_back(sequence_->size());
         sequence_->push_back(tmp);
-        checkTestName(tmp);
+        dispatch_.push_back(measurementID(tmp));
         ++(*lf); // increment to next test
     }
     lf->RestartSameTest();
     sync_ = true;
+
+    // Production screening:  skip-lot testing leaves out capable, stable steps and
+    //  a fail-fast lot runs the riskiest steps first
+    bool production = !( oi_->IsEngineeringTest()  || oi_->IsGoldStandardTest() ||
+                         oi_->IsStationDebugMode() || oi_->IsTestEngineeringTest() );
+    BatchScheduler* bs = SingletonType<BatchScheduler>::Instance();
+    if ( production && (bs->SkipLotRate() > 0) )
+        skipLot(bs->SkipLotRate(), bs->SkipLotCpk());
+    if ( production && bs->IsFailFast() ) {
+        riskOrder();
+        riskOrdered_ = true;
+    }
 }
 
 //==================
@@ -754,7 +1074,6 @@ ProgramTypes::MType TestSequence::updateSpeedMap(const TestStepInfo& tsi,
         return(ScaleUnits<ProgramTypes::MType>::ScaleDown(r.second[0], u));
 
     // Locals
-    TestResults tResults;
     ProgramTypes::MType toRtn;
     bool set = false;
     std::vector<ConverterOutput::Output> outputs
@@ -772,16 +1091,13 @@ ProgramTypes::MType TestSequence::updateSpeedMap(const TestStepInfo& tsi,
             set = true;
         }
         else // extra measurement to store for future use
-            tResults.insert(std::make_pair(chan, *i));       
+            resultCache_->Insert(t->SoftwareTestName(), chan, *i, tsi);
         ++idx;       
         ++i;
     } // while
 
     // Ensure toRtn was actually set
     Assert<UnexpectedState>(set, name());
-
-    if ( ! tResults.empty() ) // store info
-        speedSequence_->insert(std::make_pair(tsi, tResults)); 
     return(ScaleUnits<ProgramTypes::MType>::ScaleDown(toRtn, u));
 }
 
@@ -790,17 +1106,12 @@ ProgramTypes::MType TestSequence::updateSpeedMap(const TestStepInfo& tsi,
 //============================
 void TestSequence::updateSpeedMap(const TestStepInfo& tsi, 
                                   const ReturnTypeContainer& rtc) {
-    TestStepInfo copy = tsi;    
+    TestStepInfo::CondPtr cptr = getCondPointer(tsi);
     ReturnTypeContainer::const_iterator i = rtc.begin();
     while ( i != rtc.end() ) {
-        copy.setName(Uppercase(i->first));        
-        TestStepInfo::CondPtr cptr = getCondPointer(copy);
-        RTypeSecond rts = i->second;
-        for ( std::size_t idx = 0; idx < rts.size(); ++idx ) {
-            TestResults tResults;
-            tResults.insert(std::make_pair(cptr->Channel(), rts[idx]));            
-            speedSequence_->insert(std::make_pair(copy, tResults));
-        }
+        const RTypeSecond& rts = i->second;
+        for ( std::size_t idx = 0; idx < rts.size(); ++idx )
+            resultCache_->Insert(i->first, cptr->Channel(), rts[idx], tsi);
         ++i;
     }
 }
@@ -8,6 +8,7 @@
 #include "SingletonType.h"
 #include "SPTSException.h"
 #include "StandardStationFiles.h"
+#include "SymbolicExpression.h"
 #include "TestStepInfo.h"
 
 
@@ -16,6 +17,14 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /*
+   ================
+   10/19/26, agent,
+   ================
+     convertSymbolicLoad() and convertSymbolicLine() now go through SymbolicExpression:
+       each distinct string is compiled once and evaluated against the converter,
+       rather than compared against every known symbol for every step.  Any
+       "<number>% LOAD" and sums of terms are now accepted.
+
    ==============
    01/13/10, REB,
    ==============
@@ -62,6 +71,59 @@
 namespace {
     typedef StationExceptionTypes::BadArg    BadArg;
     typedef StationExceptionTypes::FileError FileError;
+
+    // FNV-1a
+    const unsigned long FNVBASIS = 2166136261UL;
+    const unsigned long FNVPRIME = 16777619UL;
+
+    void hashBytes(unsigned long& h, const void* data, std::size_t sz) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for ( std::size_t idx = 0; idx < sz; ++idx ) {
+            h ^= p[idx];
+            h = (h * FNVPRIME) & 0xFFFFFFFFUL;
+        }
+    }
+
+    void hashValue(unsigned long& h, double d) {
+        d += 0.0; // -0.0 and 0.0 compare equal --> must hash equal
+        hashBytes(h, &d, sizeof(d));
+    }
+
+    void hashValue(unsigned long& h, long l) {
+        hashBytes(h, &l, sizeof(l));
+    }
+
+    template <typename Container>
+    void hashEnums(unsigned long& h, const Container& c) {
+        typename Container::const_iterator i = c.begin();
+        while ( i != c.end() )
+            hashValue(h, static_cast<long>(*i++));
+        hashValue(h, static_cast<long>(c.size()));
+    }
+
+    unsigned long hashConditions(const TestStepInfo::Conditions& c) {
+        // Only conditions every beenDone() implementation compares belong here -->
+        //  see ResultCache::key()
+        unsigned long h = FNVBASIS;
+        hashValue(h, c.Vin().Value());
+        const ProgramTypes::SetTypeContainer& iouts = c.Iouts();
+        for ( std::size_t idx = 0; idx < iouts.size(); ++idx )
+            hashValue(h, iouts[idx].Value());
+        hashValue(h, static_cast<long>(iouts.size()));
+        hashValue(h, c.Freq().Value());
+        hashEnums(h, c.Shorted());
+        hashEnums(h, c.PretestMisc());
+        hashEnums(h, c.MidtestMisc());
+        hashValue(h, static_cast<long>(c.IsInhibited()));
+        return(h);
+    }
+
+    const std::string* intern(const std::string& s) {
+        // One copy of each distinct name for the life of the program --> names
+        //  compare equal exactly when their addresses do
+        static std::set<std::string> pool;
+        return(&*pool.insert(s).first);
+    }
 }
 
 /***************************************************************************************/
@@ -80,79 +142,16 @@ namespace { // unnamed
     //=======================
     ProgramTypes::SetType convertSymbolicLoad(ConverterOutput::Output channel,
                                               const std::string& loadValue) {
-        Converter* converter = SingletonType<Converter>::Instance();        
-        std::string cpy = Uppercase(loadValue);
-        ProgramTypes::SetType fullLoad = converter->Iout(channel);
-        if ( cpy == "FULL LOAD" )
-            return(fullLoad);
-        else if ( cpy == "HALF LOAD" )
-            return(fullLoad / ProgramTypes::SetType(2));
-        else if ( cpy == "NO LOAD" )
-            return(0);
-        else if ( cpy == "TEN% LOAD" )
-            return(fullLoad / ProgramTypes::SetType(10));
-        else if ( cpy == "0% LOAD" )
-            return(0);
-        else if ( cpy == "2% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.02));
-        else if ( cpy == "5% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.05));
-        else if ( cpy == "10% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.10));
-        else if ( cpy == "20% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.20));
-        else if ( cpy == "25% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.25));
-        else if ( cpy == "30% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.30));
-        else if ( cpy == "40% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.40));
-        else if ( cpy == "50% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.50));
-        else if ( cpy == "60% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.60));
-        else if ( cpy == "70% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.70));
-        else if ( cpy == "75% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.75));
-        else if ( cpy == "80% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.80));
-        else if ( cpy == "90% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(0.90));
-        else if ( cpy == "100% LOAD" )
-            return(fullLoad);
-        else if ( cpy == "110% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(1.10));
-        else if ( cpy == "120% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(1.20));
-        else if ( cpy == "125% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(1.25));
-        else if ( cpy == "130% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(1.30));
-        else if ( cpy == "150% LOAD" )
-            return(fullLoad * ProgramTypes::SetType(1.50));
-        
-        std::pair<SetType, ScaleUnits<SetType>::Units> p;
-        p = ScaleUnits<SetType>::GetUnits(loadValue);
-        return(ScaleUnits<SetType>::ScaleUp(p.first, p.second));
+        typedef SymbolicExpression SE;
+        return(SE::Compile(SE::LOAD, loadValue).Evaluate(channel));
     }
 
     //=======================
     // convertSymbolicLine()
     //=======================
     ProgramTypes::SetType convertSymbolicLine(const std::string& vin) {
-        Converter* converter = SingletonType<Converter>::Instance();        
-        std::string cpy = Uppercase(vin);
-        if ( cpy == "LOW LINE" )
-            return(converter->LowLine());
-        else if ( cpy == "NOMINAL LINE" )
-            return(converter->NominalLine());
-        else if ( cpy == "HIGH LINE" )
-            return(converter->HighLine());
-
-        std::pair<SetType, ScaleUnits<SetType>::Units> p;
-        p = ScaleUnits<SetType>::GetUnits(vin);
-        return(ScaleUnits<SetType>::ScaleUp(p.first, p.second));
+        typedef SymbolicExpression SE;
+        return(SE::Compile(SE::LINE, vin).Evaluate());
     }
 
     // name()
@@ -191,18 +190,17 @@ const ProgramTypes::MType   TestStepInfo::UNDEFINEDMTYPE   = -1;
 //=====================================================================================//
 
 
-struct TestStepInfo::TestStepInfoImpl {
+struct TestStepInfo::Definition {
     //----------------------------------------------------
-	// Private Nested Class --> only TestStepInfo's and
-    //  and friends have access to this --> PIMPL pattern                                      
+	// Private Nested Class --> everything read from one
+    //  limits file test step.  Immutable once built and
+    //  shared, reference counted, by every copy of the
+    //  TestStepInfo made from it.
     //----------------------------------------------------
 	friend struct TestStepInfo;
-    TestStepInfoImpl(); // unimplemented
-	TestStepInfoImpl(LimitsFile* lf);
-	TestStepInfoImpl(const TestStepInfoImpl& source);
-	TestStepInfoImpl& operator=(const TestStepInfoImpl& source);
-	~TestStepInfoImpl();  // Only a TestStepInfo object is allowed to destroy me
-    void setMembers(const TestStepInfoImpl& src); 
+	explicit Definition(LimitsFile* lf);
+	Definition(const Definition& source);
+    void setMembers(const Definition& src); 
     void setMembers(LimitsFile* lf);
 
 	// Member Variables
@@ -210,13 +208,12 @@ struct TestStepInfo::TestStepInfoImpl {
     SetType apsPrimary_;
     SetType apsSecondary_;
 	FilterSelects::FilterType bandwidth_;
-	TestStepInfo::Conditions* conditions_;
+	TestStepInfo::Conditions conditions_;
 	ConverterOutput::Output currentChannel_;
-    long eCode_;
 	SetType freq_;
+    unsigned long hash_;
 	SetTypeContainer iouts_;
 	MType maxLimit_;
-	MType measured_;
     std::set<ControlMatrixTraits::RelayTypes::MiscRelay> midMisc_;
 	MType minLimit_;
     std::vector<SwitchMatrixTraits::RelayTypes::DCRelay> miscDMM_;
@@ -225,79 +222,114 @@ struct TestStepInfo::TestStepInfoImpl {
 	SetType nextVin_;
     std::set<ControlMatrixTraits::RelayTypes::MiscRelay> pretestMisc_;
 	bool priInhibited_;
+    long refs_;
     SetType refValue_;
-	bool result_;
     bool secInhibited_;
 	std::vector<ConverterOutput::Output> shortedChannels_;
     bool speedup_;
-	std::string swTestname_;
-	std::string testname_;
-	TestStepInfo::TestStep* testStep_;
-	std::string units_;
+	const std::string* swTestname_; // interned
+	const std::string* testname_;   // interned
+	const std::string* units_;      // interned
 	SetType vin_;
     bool vRamp_;
+
+private:
+    Definition(); // unimplemented
+    Definition& operator=(const Definition&); // unimplemented
 };
 
-//=============
-// Constructor
-//=============
-TestStepInfo::TestStepInfoImpl::TestStepInfoImpl(LimitsFile* lf) {
-    conditions_ = new TestStepInfo::Conditions(this);
-    testStep_   = new TestStepInfo::TestStep(this);
+struct TestStepInfo::TestStepInfoImpl {
+    //----------------------------------------------------
+	// Private Nested Class --> what one TestStepInfo copy
+    //  owns:  its results and a reference to the shared
+    //  Definition --> PIMPL pattern
+    //----------------------------------------------------
+	friend struct TestStepInfo;
+	explicit TestStepInfoImpl(Definition* def);
+	TestStepInfoImpl(const TestStepInfoImpl& source);
+	~TestStepInfoImpl();  // Only a TestStepInfo object is allowed to destroy me
+    void detach();
+
+	// Member Variables
+	Definition* def_;
+    long eCode_;
+	MType measured_;
+	bool result_;
+	TestStepInfo::TestStep testStep_;
+
+private:
+    TestStepInfoImpl(); // unimplemented
+    TestStepInfoImpl& operator=(const TestStepInfoImpl&); // unimplemented
+};
+
+//============================
+// Definition() Constructor
+//============================
+TestStepInfo::Definition::Definition(LimitsFile* lf) : conditions_(this), refs_(1) {
     setMembers(lf);
+    hash_ = hashConditions(conditions_);
 }
 
-//============
-// Destructor 
-//============
-TestStepInfo::TestStepInfoImpl::~TestStepInfoImpl() { 
-    if ( conditions_ ) delete(conditions_);
-    if ( testStep_ )   delete(testStep_);
-    conditions_ = 0;
-    testStep_   = 0;
+//=================================
+// Definition() Copy constructor
+//=================================
+TestStepInfo::Definition::Definition(const Definition& source) 
+                                                     : conditions_(this), refs_(1) {
+    setMembers(source);
 }
 
-//==================
-// Copy constructor
-//==================
-TestStepInfo::TestStepInfoImpl::TestStepInfoImpl(const TestStepInfoImpl& source) {
-    conditions_ = new TestStepInfo::Conditions(this); 
-    testStep_   = new TestStepInfo::TestStep(this); 
+//===============================
+// TestStepInfoImpl() Constructor
+//===============================
+TestStepInfo::TestStepInfoImpl::TestStepInfoImpl(Definition* def) 
+     : def_(def), eCode_(TestStepInfo::TestStep::NODUTERROR), 
+       measured_(UNDEFINEDMTYPE), result_(false), testStep_(this)
+{ /* */ }
 
-    setMembers(source);
+//====================================
+// TestStepInfoImpl() Copy constructor
+//====================================
+TestStepInfo::TestStepInfoImpl::TestStepInfoImpl(const TestStepInfoImpl& source)
+     : def_(source.def_), eCode_(source.eCode_), measured_(source.measured_),
+       result_(source.result_), testStep_(this) {
+    ++def_->refs_; // share --> no copy of the test step's conditions
 }
 
-//=====================
-// Assignment operator
-//=====================
-TestStepInfo::TestStepInfoImpl& 
-  TestStepInfo::TestStepInfoImpl::operator=(
-                                    const TestStepInfo::TestStepInfoImpl& source) {
-	if ( this != &source ) {
-        if ( conditions_ ) delete(conditions_);
-        if ( testStep_ )   delete(testStep_);
-		conditions_ = new TestStepInfo::Conditions(this);
-		testStep_   = new TestStepInfo::TestStep(this);
-        setMembers(source);
-	}
-	return(*this);
+//==============================
+// TestStepInfoImpl() Destructor 
+//==============================
+TestStepInfo::TestStepInfoImpl::~TestStepInfoImpl() { 
+    if ( 0 == --def_->refs_ )
+        delete(def_);
+    def_ = 0;
+}
+
+//==========
+// detach()
+//==========
+void TestStepInfo::TestStepInfoImpl::detach() {
+    // Copy-on-write --> take a private Definition before changing it
+    if ( def_->refs_ > 1 ) {
+        Definition* mine = new Definition(*def_);
+        --def_->refs_;
+        def_ = mine;
+    }
 }
 
 //========================
 // setMembers() Overload1
 //========================
-void TestStepInfo::TestStepInfoImpl::setMembers(const TestStepInfoImpl& src) {
-    // Everything except testStep_ and conditions_
+void TestStepInfo::Definition::setMembers(const Definition& src) {
+    // Everything except conditions_ and refs_
     acqCount_        = src.acqCount_;
 	apsPrimary_      = src.apsPrimary_;
     apsSecondary_    = src.apsSecondary_;
 	bandwidth_       = src.bandwidth_;	
 	currentChannel_  = src.currentChannel_;
-    eCode_           = src.eCode_;
 	freq_            = src.freq_;
+    hash_            = src.hash_;
 	iouts_           = src.iouts_;
 	maxLimit_        = src.maxLimit_;
-	measured_        = src.measured_;
     midMisc_         = src.midMisc_;
 	minLimit_        = src.minLimit_;
     miscDMM_         = src.miscDMM_;
@@ -307,7 +339,6 @@ void TestStepInfo::TestStepInfoImpl::setMembers(const TestStepInfoImpl& src) {
     pretestMisc_     = src.pretestMisc_;
 	priInhibited_    = src.priInhibited_;    
     refValue_        = src.refValue_;
-	result_          = src.result_;
     secInhibited_    = src.secInhibited_;
 	shortedChannels_ = src.shortedChannels_;
     speedup_         = src.speedup_;
@@ -321,7 +352,7 @@ void TestStepInfo::TestStepInfoImpl::setMembers(const TestStepInfoImpl& src) {
 //========================
 // setMembers() Overload2
 //========================
-void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
+void TestStepInfo::Definition::setMembers(LimitsFile* lf) {
     Converter* dut = SingletonType<Converter>::Instance();
 
     // Grab information in string format
@@ -365,8 +396,7 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
     std::pair<MType, ScaleUnits<MType>::Units> q;
     std::vector<std::string> vtemp, split;
     std::vector<std::string>::iterator i, j;
-
-    eCode_ = TestStepInfo::TestStep::NODUTERROR;
+    std::string swTestname, testname;
 
     // Convert string information to something useful
     try {
@@ -404,15 +434,15 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
             if ( toConvert.find_first_of("12345") != std::string::npos ) {
                 long val = convert<long>(toConvert);
                 currentChannel_ = static_cast<ConverterOutput::Output>(val);
-                swTestname_ = sName.substr(0, sName.size()-1);
+                swTestname = sName.substr(0, sName.size()-1);
             }
             else {
                 currentChannel_ = ConverterOutput::ALL; 
-                swTestname_ = sName;
+                swTestname = sName;
             }
         }
         else {            
-            Assert<FileError>(!swTestname_.empty(), name());
+            Assert<FileError>(!swTestname.empty(), name());
             currentChannel_ = ConverterOutput::ALL;
         }
 
@@ -464,9 +494,6 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
             maxLimit_.SetPrecision(0); // Limit with precision == 0
         else
             throw(FileError(name()));    
-        
-        // measured_
-        measured_ = UNDEFINEDMTYPE;
 
         // midMisc_
         vtemp = lf->GetMidtestMisc();
@@ -561,9 +588,6 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
             refValue_ = absolute(refValue_);
         }   
 
-        // result_ 
-        result_ = false;
-
         // secInhibited_
         secInhibited_ = isBoolean<FileError>(isSInh);
 
@@ -591,13 +615,13 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
         speedup_ = isBoolean<FileError>(speedUp);
 
         // testname_
-        testname_ = pName;
-        RemoveFrontBackSpace(testname_);
-        Assert<FileError>(! testname_.empty(), name());              
+        testname = pName;
+        RemoveFrontBackSpace(testname);
+        Assert<FileError>(! testname.empty(), name());              
         
         // units_
         Assert<FileError>(ScaleUnits<MType>::IsUnits(units), name());
-        units_ = units;
+        units_ = intern(units);
 
 	    // vin_
         vin_ = convertSymbolicLine(vin);
@@ -605,6 +629,10 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
         // vRamp_
         vRamp_ = (nextVin_ != UNDEFINEDSETTYPE);
 
+        // swTestname_ and testname_
+        swTestname_ = intern(swTestname);
+        testname_ = intern(testname);
+
     } catch(BadArg b) {  // type thrown by ScaleUnits class members on bad input
         throw(FileError(LimitsFile::Name()));
     }     
@@ -624,7 +652,8 @@ void TestStepInfo::TestStepInfoImpl::setMembers(LimitsFile* lf) {
 //=============
 // Constructor
 //=============
-TestStepInfo::TestStepInfo(LimitsFile* lf) : tsiImpl_(new TestStepInfoImpl(lf))
+TestStepInfo::TestStepInfo(LimitsFile* lf) 
+                      : tsiImpl_(new TestStepInfoImpl(new Definition(lf)))
 { /* */ }
 
 //============
@@ -653,56 +682,64 @@ TestStepInfo& TestStepInfo::operator=(const TestStepInfo& source) {
 // Operator ==
 //=============
 bool operator==(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ == second.tsiImpl_->swTestname_);
+    return(first.tsiImpl_->def_->swTestname_ == second.tsiImpl_->def_->swTestname_);
 }
 
 //=============
 // Operator !=
 //=============
 bool operator!=(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ != second.tsiImpl_->swTestname_);
+    return(first.tsiImpl_->def_->swTestname_ != second.tsiImpl_->def_->swTestname_);
 }
 
 //============
 // Operator >
 //============
 bool operator>(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ > second.tsiImpl_->swTestname_);
+    const std::string* f = first.tsiImpl_->def_->swTestname_;
+    const std::string* s = second.tsiImpl_->def_->swTestname_;
+    return((f == s) ? false : (*f > *s));
 }
 
 //=============
 // Operator >=
 //=============
 bool operator>=(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ >= second.tsiImpl_->swTestname_);
+    const std::string* f = first.tsiImpl_->def_->swTestname_;
+    const std::string* s = second.tsiImpl_->def_->swTestname_;
+    return((f == s) ? true : (*f >= *s));
 }
 
 //============
 // Operator <
 //============
 bool operator<(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ < second.tsiImpl_->swTestname_);    
+    const std::string* f = first.tsiImpl_->def_->swTestname_;
+    const std::string* s = second.tsiImpl_->def_->swTestname_;
+    return((f == s) ? false : (*f < *s));    
 }
 
 //=============
 // Operator <=
 //=============
 bool operator<=(const TestStepInfo& first, const TestStepInfo& second) {
-    return(first.tsiImpl_->swTestname_ <= second.tsiImpl_->swTestname_);   
+    const std::string* f = first.tsiImpl_->def_->swTestname_;
+    const std::string* s = second.tsiImpl_->def_->swTestname_;
+    return((f == s) ? true : (*f <= *s));   
 }
 
 //=====================
 // Conversion function 
 //=====================
 TestStepInfo::operator TestStepInfo::CondPtr() const { 
-    return(tsiImpl_->conditions_); 
+    return(&tsiImpl_->def_->conditions_); 
 }
 
 //=====================
 // Conversion function
 //=====================
 TestStepInfo::operator TestStepInfo::TSPtr() const {
-    return(tsiImpl_->testStep_);
+    return(&tsiImpl_->testStep_);
 }
 
 //================
@@ -730,7 +767,8 @@ void TestStepInfo::setMeasuredValueExplicit(const std::string& value) {
 // setName()
 //===========
 void TestStepInfo::setName(const std::string& name) {
-    tsiImpl_->swTestname_ = name;
+    tsiImpl_->detach();
+    tsiImpl_->def_->swTestname_ = intern(name);
 }
 
 //=============
@@ -744,7 +782,8 @@ void TestStepInfo::setResult(bool result) {
 // setTestName()
 //===============
 void TestStepInfo::setTestName(const std::string& name) {
-    tsiImpl_->testname_ = name;
+    tsiImpl_->detach();
+    tsiImpl_->def_->testname_ = intern(name);
 }
 
 /***************************************************************************************/
@@ -760,62 +799,69 @@ void TestStepInfo::setTestName(const std::string& name) {
 //=============
 // Constructor
 //=============
-TestStepInfo::Conditions::Conditions(const TestStepInfoImpl* tsi) : tsi_(tsi)
+TestStepInfo::Conditions::Conditions(const Definition* def) : def_(def)
 { /* */ }  
 
 //============
 // Destructor
 //============
 TestStepInfo::Conditions::~Conditions()
-{ /* don't delete tsi_ */ }
+{ /* don't delete def_ */ }
 
 //==============
 // APSPrimary()
 //==============
 SetType TestStepInfo::Conditions::APSPrimary() const {
-    return(tsi_->apsPrimary_);
+    return(def_->apsPrimary_);
 }
 
 //================
 // APSSecondary()
 //================
 SetType TestStepInfo::Conditions::APSSecondary() const {
-    return(tsi_->apsSecondary_);
+    return(def_->apsSecondary_);
 }
 
 //======
 // BW()
 //======
 FilterSelects::FilterType TestStepInfo::Conditions::BW() const {
-    return(tsi_->bandwidth_); 
+    return(def_->bandwidth_); 
 }
 
 //===========
 // Channel()
 //===========
 ConverterOutput::Output TestStepInfo::Conditions::Channel() const { 
-    return(tsi_->currentChannel_); 
+    return(def_->currentChannel_); 
 }
 
 //========
 // Freq()
 //========
 SetType TestStepInfo::Conditions::Freq() const { 
-    return(tsi_->freq_); 
+    return(def_->freq_); 
+}
+
+//========
+// Hash()
+//========
+unsigned long TestStepInfo::Conditions::Hash() const {
+    return(def_->hash_);
 }
 
 //=========
 // Iouts()
 //=========
 const TestStepInfo::SetTypeContainer& TestStepInfo::Conditions::Iouts() const { 
-    return(tsi_->iouts_); 
+    return(def_->iouts_); 
 }
 
 //=============
 // IoutsNext()
 //=============
 const TestStepInfo::SetTypeContainer& TestStepInfo::Conditions::IoutsNext() const { 
-    return(tsi_->nextIouts_); 
+    return(def_->nextIouts_); 
 }
 
 //===============
@@ -830,7 +876,7 @@ bool TestStepInfo::Conditions::IsInhibited() const {
 //===============
 const std::set<ControlMatrixTraits::RelayTypes::MiscRelay>& 
                                       TestStepInfo::Conditions::MidtestMisc() const {
-    return(tsi_->midMisc_); 
+    return(def_->midMisc_); 
 }
 
 //===========
@@ -838,14 +884,14 @@ const std::set<ControlMatrixTraits::RelayTypes::MiscRelay>&
 //===========
 std::vector<SwitchMatrixTraits::RelayTypes::DCRelay>
                                TestStepInfo::Conditions::MiscDMM() const { 
-    return(tsi_->miscDMM_); 
+    return(def_->miscDMM_); 
 }
 
 //============
 // MiscOhms()
 //============
 ProgramTypes::MType TestStepInfo::Conditions::MiscOhms() const {
-    return(tsi_->miscOhms_);
+    return(def_->miscOhms_);
 }
 
 //===============
@@ -853,75 +899,77 @@ ProgramTypes::MType TestStepInfo::Conditions::MiscOhms() const {
 //===============
 const std::set<ControlMatrixTraits::RelayTypes::MiscRelay>& 
                                        TestStepInfo::Conditions::PretestMisc() const {
-    return(tsi_->pretestMisc_);
+    return(def_->pretestMisc_);
 }
 
 //====================
 // PrimaryInhibited()
 //====================
 bool TestStepInfo::Conditions::PrimaryInhibited() const { 
-    return(tsi_->priInhibited_);
+    return(def_->priInhibited_);
 }
 
 //==========
 // RefVal()
 //==========
 SetType TestStepInfo::Conditions::RefVal() const { 
-    return(tsi_->refValue_);
+    return(def_->refValue_);
 }
 
 //======================
 // SecondaryInhibited()
 //======================
 bool TestStepInfo::Conditions::SecondaryInhibited() const {
-    return(tsi_->secInhibited_);
+    return(def_->secInhibited_);
 }
 
 //===========
 // Shorted()
 //===========
 const std::vector<ConverterOutput::Output>& TestStepInfo::Conditions::Shorted() const {
-    return(tsi_->shortedChannels_);
+    return(def_->shortedChannels_);
 }
 
 //===========
 // Speedup()
 //===========
 bool TestStepInfo::Conditions::Speedup() const {
-    return(tsi_->speedup_);
+    return(def_->speedup_);
 }
 
 //==========
 // SyncIn()
 //==========
 bool TestStepInfo::Conditions::SyncIn() const { 
-    return(tsi_->freq_ != UNDEFINEDSETTYPE);
+    return(def_->freq_ != UNDEFINEDSETTYPE);
 }
 
 //=======
 // Vin()
 //=======
 SetType TestStepInfo::Conditions::Vin() const { 
-    return(tsi_->vin_);
+    return(def_->vin_);
 }
 
 //===========
 // VinNext()
 //===========
 SetType TestStepInfo::Conditions::VinNext() const			       
-	{ return(tsi_->nextVin_); }
+	{ return(def_->nextVin_); }
 
 //===========
 // VinRamp()
 //===========
 bool TestStepInfo::Conditions::VinRamp() const 
-    { return(tsi_->vRamp_); }
+    { return(def_->vRamp_); }
 
 //============
 // operator==
 //============
 bool operator==(const TestStepInfo::Conditions& first, 
                 const TestStepInfo::Conditions& second) {
+    if ( &first == &second ) // shared by copies of one test step
+        return(true);
     return(
               first.APSPrimary()         == second.APSPrimary()         &&
               first.APSSecondary()       == second.APSSecondary()       &&
@@ -979,7 +1027,7 @@ long TestStepInfo::TestStep::ErrorCode() const {
 // Limits()
 //==========
 TestStepInfo::PairMType TestStepInfo::TestStep::Limits() const { 
-    return(std::make_pair(tsi_->minLimit_, tsi_->maxLimit_));
+    return(std::make_pair(tsi_->def_->minLimit_, tsi_->def_->maxLimit_));
 }
 
 //=================
@@ -1021,21 +1069,21 @@ TestStepInfo::PairMType TestStepInfo::TestStep::ScaledLimits(ScaleDirection dir)
 // SoftwareTestName()
 //====================
 std::string TestStepInfo::TestStep::SoftwareTestName() const {
-    return(tsi_->swTestname_);
+    return(*tsi_->def_->swTestname_);
 }
 
 //============
 // TestName()
 //============
 const std::string& TestStepInfo::TestStep::TestName() const {
-    return(tsi_->testname_);
+    return(*tsi_->def_->testname_);
 }
 
 //=========
 // Units()
 //=========
 const std::string& TestStepInfo::TestStep::Units() const {
-    return(tsi_->units_);
+    return(*tsi_->def_->units_);
 }
 
 /***************************************************************************************/
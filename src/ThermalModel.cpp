@@ -0,0 +1,218 @@
+// Files included
+#include "Assertion.h"
+#include "SPTSException.h"
+#include "ThermalModel.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    typedef ThermalModel::MType   MType;
+    typedef ThermalModel::SetType SetType;
+
+    // Number of most recent samples used in a fit
+    const std::size_t MAXSAMPLES = 20;
+
+    // Minimum number of samples needed before a fit is attempted
+    const std::size_t MINSAMPLES = 4;
+
+    // Minimum spread (oC) in sampled temperatures --> smaller is all sensor noise
+    const double MINSPREAD = 0.5;
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+ThermalModel::ThermalModel() : isFit_(false), tau_(0), final_(0)
+{ /* */ }
+
+//============
+// Destructor
+//============
+ThermalModel::~ThermalModel()
+{ /* */ }
+
+//=============
+// AddSample()
+//=============
+void ThermalModel::AddSample(const MType& seconds, const MType& temperature) {
+    // Clock resolution is one second --> drop samples that do not move time forward
+    if ( (! samples_.empty()) && (seconds.Value() <= samples_.back().first) )
+        return;
+    samples_.push_back(std::make_pair(seconds.Value(), temperature.Value()));
+    if ( samples_.size() > MAXSAMPLES )
+        samples_.pop_front();
+    fit();
+}
+
+//=========
+// Clear()
+//=========
+void ThermalModel::Clear() {
+    samples_.clear();
+    isFit_ = false;
+    tau_ = 0;
+    final_ = 0;
+}
+
+//=======
+// fit()
+//=======
+void ThermalModel::fit() {
+    /*
+       Least squares fit of rate = a + b * T, where rate is the slope between two
+        consecutive samples and T is their midpoint temperature.  A first-order
+        plant gives b = -1/tau and a = Tfinal/tau.
+    */
+    isFit_ = false;
+    if ( samples_.size() < MINSAMPLES )
+        return;
+
+    double sumT = 0, sumR = 0, sumTT = 0, sumTR = 0;
+    double minT = samples_.front().second, maxT = minT;
+    std::size_t count = 0;
+    for ( std::size_t idx = 1; idx < samples_.size(); ++idx ) {
+        double dt = samples_[idx].first - samples_[idx-1].first;
+        double t  = (samples_[idx].second + samples_[idx-1].second) / 2.0;
+        double r  = (samples_[idx].second - samples_[idx-1].second) / dt;
+        sumT  += t;
+        sumR  += r;
+        sumTT += t * t;
+        sumTR += t * r;
+        minT = std::min(minT, samples_[idx].second);
+        maxT = std::max(maxT, samples_[idx].second);
+        ++count;
+    } // for
+    if ( (maxT - minT) < MINSPREAD )
+        return;
+
+    double n = static_cast<double>(count);
+    double denom = n * sumTT - sumT * sumT;
+    if ( denom <= 0 )
+        return;
+    double b = (n * sumTR - sumT * sumR) / denom;
+    double a = (sumR - b * sumT) / n;
+    if ( b >= 0 ) // not converging toward anything --> no usable model yet
+        return;
+
+    tau_   = -1.0 / b;
+    final_ = a * tau_;
+    isFit_ = true;
+}
+
+//====================
+// FinalTemperature()
+//====================
+MType ThermalModel::FinalTemperature() const {
+    return(final_);
+}
+
+//=========
+// IsFit()
+//=========
+bool ThermalModel::IsFit() const {
+    return(isFit_);
+}
+
+//========
+// Name()
+//========
+std::string ThermalModel::Name() const {
+    return("Thermal Model");
+}
+
+//=============
+// NextPause()
+//=============
+SetType ThermalModel::NextPause(const MType& lowerLimit, const MType& upperLimit,
+                                const SetType& minPause, const SetType& maxPause,
+                                const SetType& defaultPause) const {
+    // Poll at half the predicted remaining time so we converge on the band edge
+    //  rather than sleep past it.  Fall back on the caller's fixed rate until the
+    //  model is usable or when it predicts the band cannot be reached.
+    Assert<BadArg>(minPause <= maxPause, Name());
+    std::pair<bool, MType> remaining = TimeToReach(lowerLimit, upperLimit);
+    if ( ! remaining.first )
+        return(defaultPause);
+    SetType next = remaining.second.Value() / 2.0;
+    if ( next < minPause )
+        return(minPause);
+    if ( next > maxPause )
+        return(maxPause);
+    return(next);
+}
+
+//=====================
+// OvershootSetpoint()
+//=====================
+SetType ThermalModel::OvershootSetpoint(const SetType& target, const SetType& current,
+                                        const SetType& maxOvershoot,
+                                        const SetType& minSetpoint,
+                                        const SetType& maxSetpoint) const {
+    // Drive past (target) in the direction of travel by no more than the remaining
+    //  distance or (maxOvershoot), whichever is less, and within controller limits.
+    Assert<BadArg>(maxOvershoot >= SetType(0), Name());
+    SetType distance = absolute(target - current);
+    SetType overshoot = (distance < maxOvershoot) ? distance : maxOvershoot;
+    SetType setpoint = (target > current) ? target + overshoot : target - overshoot;
+    if ( setpoint > maxSetpoint )
+        setpoint = maxSetpoint;
+    if ( setpoint < minSetpoint )
+        setpoint = minSetpoint;
+    return(setpoint);
+}
+
+//================
+// TimeConstant()
+//================
+MType ThermalModel::TimeConstant() const {
+    return(tau_);
+}
+
+//===============
+// TimeToReach()
+//===============
+std::pair<bool, MType> ThermalModel::TimeToReach(const MType& lowerLimit,
+                                                 const MType& upperLimit) const {
+    // Returns (false, 0) if there is no model or the model's asymptote lies on the
+    //  near side of the band --> the band will never be reached as things stand.
+    if ( samples_.empty() )
+        return(std::make_pair(false, MType(0)));
+
+    double current = samples_.back().second;
+    double lower = lowerLimit.Value(), upper = upperLimit.Value();
+    if ( (current >= lower) && (current <= upper) )
+        return(std::make_pair(true, MType(0)));
+    if ( ! isFit_ )
+        return(std::make_pair(false, MType(0)));
+
+    double edge = (current < lower) ? lower : upper;
+    if ( (current < lower) && (final_ <= lower) )
+        return(std::make_pair(false, MType(0)));
+    if ( (current > upper) && (final_ >= upper) )
+        return(std::make_pair(false, MType(0)));
+
+    double t = tau_ * std::log((final_ - current) / (final_ - edge));
+    return(std::make_pair(true, MType(t)));
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -3,6 +3,7 @@
 #include "Converter.h"
 #include "ConverterOutput.h"
 #include "CustomTestHandler.h"
+#include "DateTime.h"
 #include "Functions.h"
 #include "GenericAlgorithms.h"
 #include "OperatorInterface.h"
@@ -17,6 +18,25 @@
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> Changes <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<//
 //=====================================================================================//
 /* 
+   ================
+   10/19/26, agent,
+   ================
+     Added resolve(): builds params_, the typed parameter table, once per Reload().
+       Converter's private getters, GetAllLoadsUsed(), GetLoadsMap(),
+       GetParallelLoads(), IsJumperPullIout(), IsJumperPullVout(), LoadType(),
+       MiscLines(), PrimaryAuxSupply() and SecondaryAuxSupply() read from it.
+     Added output(), parallelLoads() (was the body of GetParallelLoads()) and
+       auxSupply() (shared by the aux supply entries).  Jumper pull tables are
+       kept per output in jumperIout_ and jumperVout_ after first use.
+     Added scaled() to the unnamed namespace.
+     Reload() keeps vf_ and params_ when the family and dash numbers, work order,
+       operator, station location and test kind match the last load and watcher_
+       reports no change to the variables or .support files --> a run of like dash
+       numbers reads the variables file once.  Converter::Initialize() and
+       LimitsFile::Reload() both call Reload() for every DUT.  The date must match
+       too:  deviation entries are chosen by their expiration date.  Added
+       #include "DateTime.h".
+
 	==============
 	08/10/07, MRB,
 	==============
@@ -95,6 +115,20 @@ namespace {
             return(false);
         throw(ErrorType(name()));
     }
+
+    template <typename T>
+    T scaled(const std::string& s) {
+        Assert<FileError>(!s.empty() && (Uppercase(s) != UNDEFINED), name());
+        std::pair<T, typename ScaleUnits<T>::Units> p;
+        T toRtn;
+        try {
+            p = ScaleUnits<T>::GetUnits(s);
+            toRtn = ScaleUnits<T>::ScaleUp(p.first, p.second);
+        } catch(...) {
+            throw(FileError(name()));
+        }
+        return(toRtn);
+    }
 } // unnamed namespace
 
 /***************************************************************************************/
@@ -115,6 +149,28 @@ VariablesFile::VariablesFile()
 VariablesFile::~VariablesFile() 
 { /* */ }
 
+//=============
+// auxSupply()
+//=============
+std::pair<bool, ProgramTypes::SetType> VariablesFile::auxSupply(const std::string& str) {
+    std::string aux = get(str);
+    if ( aux.empty() || (Uppercase(aux) == UNDEFINED) )
+        return(std::make_pair(false, 0));
+    
+    typedef ProgramTypes::SetType SetType;
+    SetType toRtn;
+    std::pair<SetType, ScaleUnits<SetType>::Units> p;
+    try {            
+        p = ScaleUnits<SetType>::GetUnits(aux);        
+        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);
+    } catch(...) {
+        throw(FileError(name()));
+    }
+    if ( toRtn == static_cast<SetType>(0) )
+        return(std::make_pair(false, toRtn));
+    return(std::make_pair(true, toRtn));
+}
+
 //====================
 // DoDUTDiagnostics()
 //====================
@@ -164,16 +220,12 @@ std::vector<LoadTraits::Channels>
   
     // Grab all load channels to be used by this converter, including parallel loads
     std::vector<LoadTraits::Channels> toRtn;
-    for ( long i = 0; i < numOuts; ) {
-        std::string out = convert<std::string>(++i);
-        std::string used = vf_->GetVariableValue("Load Channel Vout" + out);
-        Assert<FileError>(IsInteger(used), name());
-        toRtn.push_back(static_cast<LoadTraits::Channels>(convert<long>(used)));
-
-        std::pair< bool, std::vector<LoadTraits::Channels> > p;
-        p = GetParallelLoads(static_cast<ConverterOutput::Output>(i));
-        if ( p.first ) // Parallelling loads
-           std::copy(p.second.begin(), p.second.end(), std::back_inserter(toRtn));             
+    for ( long i = 1; i <= numOuts; ++i ) {
+        const OutputParameters& op = output(static_cast<ConverterOutput::Output>(i));
+        toRtn.push_back(op.loadChannel_);
+        if ( op.paralleled_.first ) // Parallelling loads
+           std::copy(op.paralleled_.second.begin(), op.paralleled_.second.end(), 
+                     std::back_inserter(toRtn));             
     }
     std::sort(toRtn.begin(), toRtn.end());
     toRtn.erase(std::unique(toRtn.begin(), toRtn.end()), toRtn.end());    
@@ -220,17 +272,8 @@ ProgramTypes::SetType VariablesFile::getHighestVin() {
 // getHighLine()
 //===============
 ProgramTypes::SetType VariablesFile::getHighLine() {
-    std::string highest = get("High Line"); 
-    Assert<FileError>(!highest.empty(), name());
-    std::pair<SetType, ScaleUnits<SetType>::Units> p;
-    SetType toRtn;
-    try {            
-        p = ScaleUnits<SetType>::GetUnits(highest);
-        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);       
-    } catch(...) {
-        throw(FileError(name()));
-    }   
-    return(toRtn);    
+    Assert<UnexpectedState>(!locked_, name());
+    return(params_.highLine_);    
 }
 
 //============
@@ -243,41 +286,35 @@ ProgramTypes::MTypeContainer
   
     // Grab all full load Iout values
     ProgramTypes::MTypeContainer toRtn;
-    for ( long i = 0; i < numOuts; ) {
-        std::string out = convert<std::string>(++i);
-        std::string value = vf_->GetVariableValue("Full Load" + out);    
-        Assert<FileError>(!value.empty(), name());
-
-        std::pair<MType, ScaleUnits<MType>::Units> p;
-        try {            
-            p = ScaleUnits<MType>::GetUnits(value);
-            MType value = ScaleUnits<MType>::ScaleUp(p.first, p.second);
-            Assert<FileError>(value > MType(0), name());
-            toRtn.push_back(value);
-        } catch(...) {
-            throw(FileError(name()));
-        }                 
-    }
-    Assert<FileError>(!toRtn.empty(), name());
+    for ( long i = 1; i <= numOuts; ++i )
+        toRtn.push_back(output(static_cast<ConverterOutput::Output>(i)).fullLoad_);
     return(toRtn);
 }
 
 //=====================
 // GetJumperPullIout()
 //=====================
-VariablesFile::JumperPullTable 
+const VariablesFile::JumperPullTable& 
                VariablesFile::GetJumperPullIout(ConverterOutput::Output out) const {
     Assert<UnexpectedState>(!locked_, name());
-    return(vf_->GetJumperPullIout(convert<std::string>(out)));
+    JumperPullTables::iterator i = jumperIout_.find(out);
+    if ( i == jumperIout_.end() ) // first use since Reload()
+        i = jumperIout_.insert(std::make_pair(out,
+                         vf_->GetJumperPullIout(convert<std::string>(out)))).first;
+    return(i->second);
 }
 
 //=====================
 // GetJumperPullVout()
 //=====================
-VariablesFile::JumperPullTable 
+const VariablesFile::JumperPullTable& 
                VariablesFile::GetJumperPullVout(ConverterOutput::Output out) const {
     Assert<UnexpectedState>(!locked_, name());
-    return(vf_->GetJumperPullVout(convert<std::string>(out)));
+    JumperPullTables::iterator i = jumperVout_.find(out);
+    if ( i == jumperVout_.end() ) // first use since Reload()
+        i = jumperVout_.insert(std::make_pair(out,
+                         vf_->GetJumperPullVout(convert<std::string>(out)))).first;
+    return(i->second);
 }
 
 //===============
@@ -285,15 +322,11 @@ VariablesFile::JumperPullTable
 //===============
 std::vector< std::pair<ConverterOutput::Output, LoadTraits::Channels> > 
                                       VariablesFile::GetLoadsMap(long numOuts) {
+    Assert<UnexpectedState>(!locked_, name());
     std::vector< std::pair<ConverterOutput::Output, LoadTraits::Channels> > toRtn;
-    for ( long i = 0; i < numOuts; ) {
-        std::string out = convert<std::string>(++i);
-        std::string used = vf_->GetVariableValue("Load Channel Vout" + out);    
-        Assert<FileError>(IsInteger(used), name());
-        toRtn.push_back(std::make_pair(
-                          static_cast<ConverterOutput::Output>(i),
-                          static_cast<LoadTraits::Channels>(convert<long>(used)))
-                       );        
+    for ( long i = 1; i <= numOuts; ++i ) {
+        ConverterOutput::Output out = static_cast<ConverterOutput::Output>(i);
+        toRtn.push_back(std::make_pair(out, output(out).loadChannel_));        
     }
     return(toRtn);
 }
@@ -302,17 +335,8 @@ std::vector< std::pair<ConverterOutput::Output, LoadTraits::Channels> >
 // getLowLine()
 //==============
 ProgramTypes::SetType VariablesFile::getLowLine() {
-    std::string low = get("Low Line"); 
-    Assert<FileError>(!low.empty(), name());
-    std::pair<SetType, ScaleUnits<SetType>::Units> p;
-    SetType toRtn;
-    try {            
-        p = ScaleUnits<SetType>::GetUnits(low);
-        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);       
-    } catch(...) {
-        throw(FileError(name()));
-    }   
-    return(toRtn);     
+    Assert<UnexpectedState>(!locked_, name());
+    return(params_.lowLine_);     
 }
 
 //===================
@@ -336,19 +360,10 @@ ProgramTypes::SetType VariablesFile::getMaxNoLoadIin() {
 // getNominalLine()
 //==================
 ProgramTypes::SetType VariablesFile::getNominalLine() {
-    std::string value = get("Nominal Line"); 
-    Assert<FileError>(!value.empty(), name());
-    std::pair<SetType, ScaleUnits<SetType>::Units> p;
-    SetType toRtn;
-    try {            
-        p = ScaleUnits<SetType>::GetUnits(value);
-        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);       
-    } catch(...) {
-        throw(FileError(name()));
-    }   
-    return(toRtn); 
+    Assert<UnexpectedState>(!locked_, name());
+    return(params_.nominalLine_); 
 }
-   
+
 //====================
 // getInhibitLifecycle()
 //====================
@@ -367,10 +382,8 @@ long VariablesFile::getInhibitLifecycles() {
 // getNumberOutputs()
 //====================
 ConverterOutput::Output VariablesFile::getNumberOutputs() {    
-    std::string value = get("Total Outputs"); 
-    Assert<FileError>(!value.empty(), name());
-    // std::string --> long --> ConverterOutput::Output
-    return(static_cast<ConverterOutput::Output>(convert<long>(value)));
+    Assert<UnexpectedState>(!locked_, name());
+    return(params_.outputs_);
 }
 
 //======================
@@ -394,39 +407,10 @@ std::pair<bool, ProgramTypes::MType> VariablesFile::GetOrientationOhms() {
 //====================
 // GetParallelLoads()
 //====================
-std::pair< bool, std::vector<LoadTraits::Channels> >
-            VariablesFile::GetParallelLoads(ConverterOutput::Output output) {
-    Assert<UnexpectedState>(!locked_, name());
-    std::string out = convert<std::string>(output);
-    std::string used = vf_->GetVariableValue("Loads Paralleled" + out);
-    if ( used.empty() || (Uppercase(used) == UNDEFINED)) // nada
-        return(std::make_pair(false, std::vector<LoadTraits::Channels>()));
-
-    // Local variables and typedefs
-    std::vector<std::string> split = SplitString(used, ',');
-    typedef std::vector<LoadTraits::Channels> LoadVec;
-    typedef LoadVec::iterator iterator;
-    typedef std::pair<iterator, iterator> PairLoadVec;
-    LoadVec toRtn, toCheck;
-    PairLoadVec findMismatch;
-
-    // Convert string information to LoadTraits information
-    std::vector<std::string>::iterator i = split.begin(), j = split.end();
-    while ( i != j ) { 
-        Assert<FileError>(IsInteger(*i), name());
-        toRtn.push_back(static_cast<LoadTraits::Channels>(convert<long>(*i)));
-        ++i;
-    }
-
-    // Ensure info gathered is valid (loads must be in numerical order)
-    Assert<FileError>(toRtn.size() > static_cast<std::size_t>(1), name());
-    toCheck = toRtn;
-    std::sort(toCheck.begin(), toCheck.end());
-    findMismatch = std::mismatch(toRtn.begin(), toRtn.end(), toCheck.begin());
-    Assert<FileError>(findMismatch.first == toRtn.end(), name());
-    return(std::make_pair(true, toRtn));
+const VariablesFile::ParallelLoads& 
+            VariablesFile::GetParallelLoads(ConverterOutput::Output out) const {
+    return(output(out).paralleled_);
 }
-
 //====================
 // getSyncAmplitude()
 //====================
@@ -541,22 +525,10 @@ ProgramTypes::MTypeContainer VariablesFile::getVouts(long numOuts) {
     Assert<UnexpectedState>(!locked_, name());
     Assert<BadArg>(numOuts > 0, name());
   
-    // Grab all full load Iout values
+    // Grab all Vout values
     ProgramTypes::MTypeContainer toRtn;
-    for ( long i = 0; i < numOuts; ) {
-        std::string out = convert<std::string>(++i);
-        std::string value = vf_->GetVariableValue("Vout" + out);    
-        Assert<FileError>(! value.empty(), name());
-
-        std::pair<MType, ScaleUnits<MType>::Units> p;
-        try {            
-            p = ScaleUnits<MType>::GetUnits(value);
-            toRtn.push_back(ScaleUnits<MType>::ScaleUp(p.first, p.second));
-        } catch(...) {
-            throw(FileError(name()));
-        }                 
-    }
-    Assert<FileError>(!toRtn.empty(), name());
+    for ( long i = 1; i <= numOuts; ++i )
+        toRtn.push_back(output(static_cast<ConverterOutput::Output>(i)).vout_);
     return(toRtn);
 }
 
@@ -588,8 +560,7 @@ bool VariablesFile::isGroundedSync() {
 //====================
 bool VariablesFile::IsJumperPullIout() const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string toRtn = vf_->GetVariableValue("Jumper Pull - Iout");
-    return(isBoolean<FileError>(toRtn));    
+    return(params_.jumperPullIout_);    
 }
 
 //====================
@@ -597,8 +568,7 @@ bool VariablesFile::IsJumperPullIout() const {
 //====================
 bool VariablesFile::IsJumperPullVout() const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string toRtn = vf_->GetVariableValue("Jumper Pull - Vout");
-    return(isBoolean<FileError>(toRtn));  
+    return(params_.jumperPullVout_);  
 }
 
 //====================
@@ -654,33 +624,17 @@ std::pair<bool, ProgramTypes::SetType> VariablesFile::LoadTransientTransitionTim
 //============
 // LoadType()
 //============
-LoadTraits::Types VariablesFile::LoadType() {
+LoadTraits::Types VariablesFile::LoadType() const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string type = vf_->GetVariableValue("Load Type");
-    Assert<FileError>(! type.empty(), name());
-    type = Uppercase(type);
-    if ( type == "ELECTRONIC" )
-        return(LoadTraits::ELECTRONIC);
-    else if ( type == "PASSIVE" )
-        return(LoadTraits::PASSIVE); 
-    
-    throw(FileError(name()));
+    return(params_.loadType_);
 }
 
 //=============
 // MiscLines()
 //=============
-std::vector<std::string> VariablesFile::MiscLines() {
+const std::vector<std::string>& VariablesFile::MiscLines() const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string misc = vf_->GetVariableValue("Miscellaneous Lines");
-    if ( misc.empty() || (Uppercase(misc) == UNDEFINED) ) // nothing
-        return(std::vector<std::string>());
-    std::vector<std::string> tmp = SplitString(misc, ',');
-    std::sort(tmp.begin(), tmp.end());
-    std::vector<std::string>::iterator i = std::unique(tmp.begin(), tmp.end());
-    if ( i != tmp.end() )
-        tmp.erase(i);
-    return(tmp);
+    return(params_.miscLines_);
 }
 
 //==================
@@ -690,29 +644,59 @@ std::string VariablesFile::NoWirebondPull() const {
     return("NONE");
 }
 
-//====================
-// PrimaryAuxSupply()
-//====================
-std::pair<bool, ProgramTypes::SetType> VariablesFile::PrimaryAuxSupply() {
+//==========
+// output()
+//==========
+const VariablesFile::OutputParameters& 
+                    VariablesFile::output(ConverterOutput::Output out) const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string pAux = vf_->GetVariableValue("Primary APS");
-    if ( pAux.empty() || (Uppercase(pAux) == UNDEFINED) )
-        return(std::make_pair(false, 0));
-    
-    typedef ProgramTypes::SetType SetType;
-    SetType toRtn;
-    std::pair<SetType, ScaleUnits<SetType>::Units> p;
-    try {            
-        p = ScaleUnits<SetType>::GetUnits(pAux);        
-        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);
-    } catch(...) {
-        throw(FileError(name()));
+    long idx = static_cast<long>(out) - 1;
+    Assert<BadArg>(idx >= 0 && idx < static_cast<long>(params_.perOutput_.size()), 
+                   name());
+    return(params_.perOutput_[idx]);
+}
+
+//=================
+// parallelLoads()
+//=================
+VariablesFile::ParallelLoads VariablesFile::parallelLoads(ConverterOutput::Output output) {
+    std::string out = convert<std::string>(output);
+    std::string used = get("Loads Paralleled" + out);
+    if ( used.empty() || (Uppercase(used) == UNDEFINED)) // nada
+        return(std::make_pair(false, std::vector<LoadTraits::Channels>()));
+
+    // Local variables and typedefs
+    std::vector<std::string> split = SplitString(used, ',');
+    typedef std::vector<LoadTraits::Channels> LoadVec;
+    typedef LoadVec::iterator iterator;
+    typedef std::pair<iterator, iterator> PairLoadVec;
+    LoadVec toRtn, toCheck;
+    PairLoadVec findMismatch;
+
+    // Convert string information to LoadTraits information
+    std::vector<std::string>::iterator i = split.begin(), j = split.end();
+    while ( i != j ) { 
+        Assert<FileError>(IsInteger(*i), name());
+        toRtn.push_back(static_cast<LoadTraits::Channels>(convert<long>(*i)));
+        ++i;
     }
-    if ( toRtn == static_cast<SetType>(0) )
-        return(std::make_pair(false, toRtn));
+
+    // Ensure info gathered is valid (loads must be in numerical order)
+    Assert<FileError>(toRtn.size() > static_cast<std::size_t>(1), name());
+    toCheck = toRtn;
+    std::sort(toCheck.begin(), toCheck.end());
+    findMismatch = std::mismatch(toRtn.begin(), toRtn.end(), toCheck.begin());
+    Assert<FileError>(findMismatch.first == toRtn.end(), name());
     return(std::make_pair(true, toRtn));
 }
 
+//====================
+// PrimaryAuxSupply()
+//====================
+std::pair<bool, ProgramTypes::SetType> VariablesFile::PrimaryAuxSupply() const {
+    Assert<UnexpectedState>(!locked_, name());
+    return(params_.primaryAPS_);
+}
 
 //==========
 // Reload()
@@ -726,12 +710,20 @@ void VariablesFile::Reload() {
     bool engTest = oi->IsEngineeringTest();
     bool teTest = oi->IsTestEngineeringTest();
     teTest = teTest ? teTest : oi->IsStationDebugMode();
+    std::string wo = oi->GetWorkOrder();
+    std::string id = oi->GetOperatorID();
+
+    // Everything that selects the file and the entry within it --> deviations are
+    //  selected against today's date
+    std::string inputs = famNumber + "|" + alphas + "|" + wo + "|" + id + "|" + loc +
+                         "|" + (engTest ? "E" : "-") + (teTest ? "T" : "-") + "|" +
+                         Date::CurrentDate();
+    if ( vf_.get() && !locked_ && watcher_.Current(inputs) )
+        return; // same variables, unchanged on disk
 
     // Reset vf_ to point to variable file for famNumber
+    watcher_.Reset();
     try {
-        std::string wo = oi->GetWorkOrder();
-        std::string id = oi->GetOperatorID();
-        
         vf_.reset(new FileTypes::VariablesFileType(famNumber, wo, alphas,
                                                    id, loc, teTest, engTest));
     } catch(StationExceptionTypes::FileFormatError& ffe) {
@@ -750,6 +742,72 @@ void VariablesFile::Reload() {
     }
     dash_ = dash;
     locked_ = false;
+
+    // Resolve the parameter table
+    try {
+        resolve();
+    } catch(...) {
+        locked_ = true;
+        throw;
+    }
+    watcher_.Watch(inputs, vf_->Sources());
+}
+
+//===========
+// resolve()
+//===========
+void VariablesFile::resolve() {
+    // Build the parameter table for the current family and dash number --> all
+    //  string lookups and unit conversions happen here, once per Reload()
+    Parameters p;
+    std::string value = get("Total Outputs"); 
+    Assert<FileError>(IsInteger(value), name());
+    long numOuts = convert<long>(value);
+    Assert<FileError>(numOuts > 0 && numOuts <= ConverterOutput::MAX_OUTPUT, name());
+    p.outputs_ = static_cast<ConverterOutput::Output>(numOuts);
+
+    for ( long i = 1; i <= numOuts; ++i ) {
+        std::string out = convert<std::string>(i);
+        OutputParameters op;
+        op.fullLoad_ = scaled<MType>(get("Full Load" + out));
+        Assert<FileError>(op.fullLoad_ > MType(0), name());
+        op.vout_ = scaled<MType>(get("Vout" + out));
+        std::string used = get("Load Channel Vout" + out);
+        Assert<FileError>(IsInteger(used), name());
+        op.loadChannel_ = static_cast<LoadTraits::Channels>(convert<long>(used));
+        op.paralleled_ = parallelLoads(static_cast<ConverterOutput::Output>(i));
+        p.perOutput_.push_back(op);
+    }
+
+    p.highLine_ = scaled<SetType>(get("High Line"));
+    p.lowLine_ = scaled<SetType>(get("Low Line"));
+    p.nominalLine_ = scaled<SetType>(get("Nominal Line"));
+    p.jumperPullIout_ = isBoolean<FileError>(get("Jumper Pull - Iout"));
+    p.jumperPullVout_ = isBoolean<FileError>(get("Jumper Pull - Vout"));
+    p.primaryAPS_ = auxSupply("Primary APS");
+    p.secondaryAPS_ = auxSupply("Secondary APS");
+
+    std::string type = Uppercase(get("Load Type"));
+    if ( type == "ELECTRONIC" )
+        p.loadType_ = LoadTraits::ELECTRONIC;
+    else if ( type == "PASSIVE" )
+        p.loadType_ = LoadTraits::PASSIVE;
+    else
+        throw(FileError(name()));
+
+    std::string misc = get("Miscellaneous Lines");
+    if ( !misc.empty() && (Uppercase(misc) != UNDEFINED) ) {
+        std::vector<std::string> tmp = SplitString(misc, ',');
+        std::sort(tmp.begin(), tmp.end());
+        std::vector<std::string>::iterator i = std::unique(tmp.begin(), tmp.end());
+        if ( i != tmp.end() )
+            tmp.erase(i);
+        p.miscLines_ = tmp;
+    }
+
+    params_ = p;
+    jumperIout_.clear();
+    jumperVout_.clear();
 }
 
 //==========
@@ -784,24 +842,9 @@ VariablesFile::InnerMap VariablesFile::RLoads(ConverterOutput::Output output) {
 //======================
 // SecondaryAuxSupply()
 //======================
-std::pair<bool, ProgramTypes::SetType> VariablesFile::SecondaryAuxSupply() {
+std::pair<bool, ProgramTypes::SetType> VariablesFile::SecondaryAuxSupply() const {
     Assert<UnexpectedState>(!locked_, name());
-    std::string sAux = vf_->GetVariableValue("Secondary APS");
-    if ( sAux.empty() || (Uppercase(sAux) == UNDEFINED) )
-        return(std::make_pair(false, 0));
-    
-    typedef ProgramTypes::SetType SetType;
-    SetType toRtn;
-    std::pair<SetType, ScaleUnits<SetType>::Units> p;
-    try {            
-        p = ScaleUnits<SetType>::GetUnits(sAux);        
-        toRtn = ScaleUnits<SetType>::ScaleUp(p.first, p.second);
-    } catch(...) {
-        throw(FileError(name()));
-    }
-    if ( toRtn == static_cast<SetType>(0) )
-        return(std::make_pair(false, toRtn));
-    return(std::make_pair(true, toRtn));
+    return(params_.secondaryAPS_);
 }
 
 //=======================
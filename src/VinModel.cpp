@@ -0,0 +1,120 @@
+// Files included
+#include "Assertion.h"
+#include "SPTSException.h"
+#include "VinModel.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    typedef StationExceptionTypes::BadArg BadArg;
+
+    typedef VinModel::MType   MType;
+    typedef VinModel::SetType SetType;
+
+    // Most operating states remembered --> bounds memory on long sequences
+    const std::size_t MAXSTATES = 64;
+
+    // Consecutive DMM readings that must agree before the supply counts as settled
+    const std::size_t SETTLEREADINGS = 4;
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=============
+// Constructor
+//=============
+VinModel::VinModel()
+{ /* */ }
+
+//============
+// Destructor
+//============
+VinModel::~VinModel()
+{ /* */ }
+
+//=========
+// Clear()
+//=========
+void VinModel::Clear() {
+    droops_.clear();
+}
+
+//=============
+// IsSettled()
+//=============
+bool VinModel::IsSettled(const std::vector<MType>& readings,
+                         const SetType& resolution) const {
+    // The last SETTLEREADINGS readings span no more than what the supply can
+    //  resolve --> any slew left over the whole window is below one supply step
+    if ( readings.size() < SETTLEREADINGS )
+        return(false);
+    std::vector<MType>::const_iterator i = readings.end() - SETTLEREADINGS;
+    double low = i->Value(), high = i->Value();
+    while ( ++i != readings.end() ) {
+        low  = std::min(low, i->Value());
+        high = std::max(high, i->Value());
+    }
+    return((high - low) <= resolution.Value());
+}
+
+//=========
+// Learn()
+//=========
+void VinModel::Learn(const std::string& state, const SetType& setpoint,
+                     const MType& measured) {
+    Assert<BadArg>(measured > MType(0), Name());
+    double k = (setpoint.Value() - measured.Value()) * measured.Value();
+    Droops::iterator i = droops_.find(state);
+    if ( i != droops_.end() ) { // average out DMM noise
+        i->second = (i->second + k) / 2.0;
+        return;
+    }
+    if ( droops_.size() >= MAXSTATES )
+        droops_.clear();
+    droops_.insert(std::make_pair(state, k));
+}
+
+//========
+// Name()
+//========
+std::string VinModel::Name() const {
+    return("Vin Model");
+}
+
+//============
+// Setpoint()
+//============
+SetType VinModel::Setpoint(const std::string& state, const SetType& target,
+                           const SetType& maxCorrection) const {
+    // Supply setpoint expected to put (target) at the DUT, corrected by no more
+    //  than (maxCorrection) either way
+    Assert<BadArg>(target > SetType(0), Name());
+    Assert<BadArg>(maxCorrection >= SetType(0), Name());
+    Droops::const_iterator i = droops_.find(state);
+    if ( i == droops_.end() )
+        return(target);
+    double droop = i->second / target.Value();
+    if ( droop > maxCorrection.Value() )
+        droop = maxCorrection.Value();
+    if ( droop < -maxCorrection.Value() )
+        droop = -maxCorrection.Value();
+    return(target + droop);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,280 @@
+// Files included for the Aardvark entry points simulated here
+#include "Aardvark.h"
+
+// Files included
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Stand-in Aardvark USB-to-I2C adapter for the station's I2C class:  defines the
+    aa_* calls I2C.cpp makes (aa_open, aa_close, aa_configure, aa_target_power,
+    aa_i2c_pullup, aa_i2c_bitrate, aa_i2c_free_bus, aa_i2c_write_ext and
+    aa_i2c_read_ext) against a simulated Tektronix TCPA300 current probe at any
+    slave address --> runs I2C transactions, batches and CurrentProbe with no
+    adapter().
+   The probe has command register 0x37 and query register 0x36.  It answers
+    Read Range (0x08), Read Coupling (0x07) and Read Degauss State (0x09) with one
+    byte, and Toggle Range (0x15), Toggle Coupling (0x14) and Degauss (0x11)
+    change that state.  It powers up in the wrong range and coupling and needing a
+    degauss, as a real probe may.
+   Protocol checks --> the call fails as the adapter would on a NACK:
+        a read not preceded by a write of 0x36 without a stop (repeated start)
+        any transfer sooner than SETTLESECONDS after a command (a real probe
+         locks up instead), or DEGAUSSSECONDS after a degauss
+        a bitrate outside 1 to 800 kHz
+   Bus time is tallied at the bitrate in force (9 clocks per byte, plus the
+    address byte) and printed by aa_close() with the transaction counts.
+   Build in place of aardvark.c, with the station or with anything else using
+    I2C.cpp.
+*/
+
+namespace {
+    // Adapter
+    const int PORT = 0;
+    const Aardvark HANDLE = 1;
+    const int MAXBITRATE = 800; // kHz
+
+    // Probe registers and commands --> see TekTCPA300Language.h
+    const aa_u08 COMMANDREG = 0x37;
+    const aa_u08 QUERYREG = 0x36;
+    const aa_u08 DEGAUSS = 0x11;
+    const aa_u08 READCOUPLING = 0x07;
+    const aa_u08 READDEGAUSS = 0x09;
+    const aa_u08 READRANGE = 0x08;
+    const aa_u08 TOGGLECOUPLING = 0x14;
+    const aa_u08 TOGGLERANGE = 0x15;
+
+    // Probe answers
+    const aa_u08 DEGAUSSDONE = 0x00;
+    const aa_u08 NEEDSDEGAUSS = 0x02;
+    const aa_u08 LOWRANGE = 0x02, HIGHRANGE = 0x03;
+    const aa_u08 DCCOUPLING = 0x01, ACCOUPLING = 0x02;
+
+    // Probe timing (seconds) --> see TekTCPA300.h
+    const double SETTLESECONDS = 0.5;
+    const double DEGAUSSSECONDS = 10;
+
+    struct Probe {
+        Probe() : Range(HIGHRANGE), Coupling(ACCOUPLING), Degauss(NEEDSDEGAUSS),
+                  Last(0), Busy(-1), Selected(false) { /* */ }
+        aa_u08 Range;
+        aa_u08 Coupling;
+        aa_u08 Degauss;
+        aa_u08 Last;     // last command --> what the query register answers
+        double Busy;     // seconds until which the probe takes nothing
+        bool Selected;   // query register selected, bus held for a read
+    };
+
+    struct Adapter {
+        Adapter() : Open(false), Bitrate(100), Held(false), BusSeconds(0),
+                    Writes(0), Reads(0), Naks(0) { /* */ }
+        bool Open;
+        int Bitrate;     // kHz
+        bool Held;       // last write ended without a stop
+        double BusSeconds;
+        long Writes, Reads, Naks;
+    };
+
+    typedef std::map<aa_u16, Probe> ProbeMap;
+
+    // State is built on first use --> the station's I2C bus is a static object that
+    //  may open the adapter before this file's statics are constructed
+    //===========
+    // adapter()
+    //===========
+    Adapter& adapter() {
+        static Adapter a;
+        return(a);
+    }
+
+    //==========
+    // probes()
+    //==========
+    ProbeMap& probes() {
+        static ProbeMap p;
+        return(p);
+    }
+
+    //===========
+    // seconds()
+    //===========
+    double seconds() {
+        return(static_cast<double>(std::clock()) / CLOCKS_PER_SEC);
+    }
+
+    //==========
+    // clocks()
+    //==========
+    void clocks(long bytes) {
+        // Address byte plus data, 9 clocks each
+        adapter().BusSeconds += (9.0 * (bytes + 1)) / (adapter().Bitrate * 1000.0);
+    }
+
+    //=========
+    // ready()
+    //=========
+    bool ready(const Probe& probe) {
+        return(seconds() >= probe.Busy);
+    }
+
+    //===========
+    // command()
+    //===========
+    void command(Probe& probe, aa_u08 cmd) {
+        probe.Last = cmd;
+        probe.Busy = seconds() + ((cmd == DEGAUSS) ? DEGAUSSSECONDS : SETTLESECONDS);
+        if ( cmd == TOGGLERANGE )
+            probe.Range = (probe.Range == LOWRANGE) ? HIGHRANGE : LOWRANGE;
+        else if ( cmd == TOGGLECOUPLING )
+            probe.Coupling = (probe.Coupling == DCCOUPLING) ? ACCOUPLING : DCCOUPLING;
+        else if ( cmd == DEGAUSS )
+            probe.Degauss = DEGAUSSDONE;
+    }
+
+    //==========
+    // answer()
+    //==========
+    aa_u08 answer(const Probe& probe) {
+        switch(probe.Last) {
+            case READCOUPLING:
+                return(probe.Coupling);
+            case READDEGAUSS:
+                return(probe.Degauss);
+            case READRANGE:
+                return(probe.Range);
+            default:
+                return(0);
+        }
+    }
+
+    //=======
+    // nak()
+    //=======
+    int nak(int status) {
+        ++adapter().Naks;
+        return(status);
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=====================================================================================//
+// Aardvark calls made by I2C.cpp
+//=====================================================================================//
+extern "C" {
+
+Aardvark aa_open(int port_number) {
+    if ( (port_number != PORT) || adapter().Open )
+        return(AA_UNABLE_TO_OPEN);
+    adapter() = Adapter();
+    adapter().Open = true;
+    probes().clear();
+    return(HANDLE);
+}
+
+int aa_close(Aardvark aardvark) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    adapter().Open = false;
+    std::cout << "AardvarkSimulator: " << adapter().Writes << " writes, "
+              << adapter().Reads << " reads, " << adapter().Naks << " NAKs, "
+              << (adapter().BusSeconds * 1000) << " ms of bus time" << std::endl;
+    return(AA_OK);
+}
+
+int aa_configure(Aardvark aardvark, AA_CONFIG config) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    return(config);
+}
+
+int aa_i2c_bitrate(Aardvark aardvark, int bitrate_khz) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    if ( (bitrate_khz < 0) || (bitrate_khz > MAXBITRATE) )
+        return(AA_CONFIG_ERROR);
+    if ( bitrate_khz > 0 )
+        adapter().Bitrate = bitrate_khz;
+    return(adapter().Bitrate);
+}
+
+int aa_i2c_free_bus(Aardvark aardvark) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    bool held = adapter().Held;
+    adapter().Held = false;
+    ProbeMap::iterator i = probes().begin();
+    while ( i != probes().end() )
+        (i++)->second.Selected = false;
+    return(held ? AA_OK : AA_I2C_BUS_ALREADY_FREE);
+}
+
+int aa_i2c_pullup(Aardvark aardvark, aa_u08 pullup_mask) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    return(pullup_mask);
+}
+
+int aa_i2c_read_ext(Aardvark aardvark, aa_u16 slave_addr, AA_I2C_FLAGS flags,
+                    aa_u16 num_bytes, aa_u08* data_in, aa_u16* num_read) {
+    *num_read = 0;
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    ++adapter().Reads;
+    Probe& probe = probes()[slave_addr];
+    clocks(num_bytes);
+    bool selected = probe.Selected;
+    probe.Selected = false;
+    adapter().Held = (0 != (flags & AA_I2C_NO_STOP));
+    if ( !selected || !ready(probe) )
+        return(nak(AA_I2C_READ_ERROR));
+    for ( aa_u16 idx = 0; idx < num_bytes; ++idx )
+        data_in[idx] = (0 == idx) ? answer(probe) : 0;
+    *num_read = num_bytes;
+    return(AA_OK);
+}
+
+int aa_i2c_write_ext(Aardvark aardvark, aa_u16 slave_addr, AA_I2C_FLAGS flags,
+                     aa_u16 num_bytes, const aa_u08* data_out, aa_u16* num_written) {
+    *num_written = 0;
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    ++adapter().Writes;
+    Probe& probe = probes()[slave_addr];
+    clocks(num_bytes);
+    bool stop = (0 == (flags & AA_I2C_NO_STOP));
+    adapter().Held = !stop;
+    probe.Selected = false;
+    if ( (0 == num_bytes) || !ready(probe) )
+        return(nak(AA_I2C_WRITE_ERROR));
+
+    if ( (data_out[0] == QUERYREG) && (1 == num_bytes) && !stop )
+        probe.Selected = true;
+    else if ( (data_out[0] == COMMANDREG) && (2 == num_bytes) && stop )
+        command(probe, data_out[1]);
+    else
+        return(nak(AA_I2C_WRITE_ERROR));
+    *num_written = num_bytes;
+    return(AA_OK);
+}
+
+int aa_target_power(Aardvark aardvark, aa_u08 power_mask) {
+    if ( (aardvark != HANDLE) || !adapter().Open )
+        return(AA_INVALID_HANDLE);
+    return(power_mask);
+}
+
+} // extern "C"
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
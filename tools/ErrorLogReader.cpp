@@ -0,0 +1,54 @@
+// Files included
+#include "ErrorRecord.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Prints the records of one or more binary error logs (ErrorLog.bin), one per line
+    and tab separated --> feed the output to grep, sort or a spreadsheet.
+   Build apart from the station software:  ErrorLogReader.cpp and ErrorRecord.cpp.
+   Usage:  ErrorLogReader ErrorLog.bin [ErrorLog.bin ...]
+*/
+
+//========
+// main()
+//========
+int main(int argc, char* argv[]) {
+    if ( argc < 2 ) {
+        std::cerr << "Usage: ErrorLogReader ErrorLog.bin [ErrorLog.bin ...]" << std::endl;
+        return(1);
+    }
+
+    int toRtn = 0;
+    for ( int idx = 1; idx < argc; ++idx ) {
+        std::ifstream infile(argv[idx], std::ios::in | std::ios::binary);
+        if ( !infile ) {
+            std::cerr << "Unable to open " << argv[idx] << std::endl;
+            toRtn = 1;
+            continue;
+        }
+        ErrorRecord record;
+        while ( ErrorRecord::Read(infile, record) )
+            std::cout << record << std::endl;
+        if ( infile.peek() != std::char_traits<char>::eof() ) {
+            std::cerr << argv[idx] << ": stopped at damaged record" << std::endl;
+            toRtn = 1;
+        }
+    } // for
+    return(toRtn);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/
@@ -0,0 +1,305 @@
+// Files included for the NI-488.2 entry points simulated here
+#include <windows.h>
+#include "ni488.h"
+
+// Files included
+#include "GenericAlgorithms.h"
+#include "Instrument.h"
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Simulated multi-board NI-488.2 backend for the station's GPIB class:  defines the
+    NI-488.2 calls GPIB.cpp makes (ibdev, ibclr, ibonl, ibwrt, ibwrta, ibwait, ibrd,
+    ibstop and ibsta, iberr, ibcnt, ibcntl) against simulated boards and quiet,
+    error free instruments --> times GPIB's per-board dispatch with no hardware.
+   Time is simulated, not measured:  each board carries one transfer at a time,
+    costing SETUPTIME plus BYTETIME per byte.  An instrument holds the handshake for
+    ACCEPTTIME while it takes a command and needs ANSWERTIME before it talks.  The
+    caller's clock advances only when it waits on the bus.
+   Every instrument is sent a settings command, then each is queried, for the
+    given number of rounds.  This is run with the instruments all on board 0 and
+    then spread over 2 to MAXBOARDS boards, printing the time taken by each.
+   The backend also checks GPIB's dispatch:  a second transfer started on a board
+    before its asynchronous write is finished fails with EOIP, as with NI's driver.
+   Build apart from the station software:  GPIBSimulator.cpp with the station's
+    GPIB.cpp, Functions.cpp and StringAlgorithms.cpp, in place of gpib-32.obj.
+   Usage:  GPIBSimulator [instruments [rounds]]
+*/
+
+namespace {
+    // Defaults
+    const long DEFAULTINSTRUMENTS = 8;
+    const long DEFAULTROUNDS = 100;
+    const long MAXBOARDS = 4;
+
+    // Simulated timing (seconds)
+    const double SETUPTIME  = 50e-6;  // addressing and driver overhead per transfer
+    const double BYTETIME   = 2e-6;   // per byte --> about 500 kB/s
+    const double ACCEPTTIME = 1e-3;   // instrument taking a command
+    const double ANSWERTIME = 2e-3;   // instrument preparing a response
+
+    // Station traffic
+    const std::string SETTINGS = "VOLT 28.000;CURR 2.000;OUTP ON";
+    const std::string MEASURE = "MEAS:VOLT?";
+    const std::string REPLY = "+2.80000000E+01\n";
+
+    // GPIB's device key for (board, primary) --> see GPIB::open()
+    const long KEYBASE = 32;
+
+    struct Device {
+        Device(int board) : Board(board), DoneAt(0), Reply("") { /* */ }
+        int Board;
+        double DoneAt;     // end of this device's write in flight
+        std::string Reply;
+    };
+
+    std::vector<Device> devices;               // handle is index + 1
+    std::vector<int> pendingOn(KEYBASE, 0);    // handle with a write in flight
+    std::vector<double> boardFree(KEYBASE, 0); // end of each board's last transfer
+    double now = 0;                            // the caller's clock
+
+    //=========
+    // reset()
+    //=========
+    void reset() {
+        now = 0;
+        std::fill(boardFree.begin(), boardFree.end(), 0);
+        std::fill(pendingOn.begin(), pendingOn.end(), 0);
+        for ( std::size_t idx = 0; idx < devices.size(); ++idx )
+            devices[idx].Reply = "";
+    }
+
+    //==========
+    // status()
+    //==========
+    int status(int sta, int err = 0) {
+        ibsta = sta;
+        iberr = err;
+        return(ibsta);
+    }
+
+    //============
+    // transfer()
+    //============
+    double transfer(const Device& dev, long bytes, double deviceTime) {
+        // Queues a transfer on the device's board --> returns when it ends
+        double start = std::max(now, boardFree[dev.Board]);
+        boardFree[dev.Board] = start + SETUPTIME + (bytes * BYTETIME) + deviceTime;
+        return(boardFree[dev.Board]);
+    }
+
+    //==========
+    // device()
+    //==========
+    Device* device(int ud) {
+        if ( (ud < 1) || (ud > static_cast<int>(devices.size())) )
+            return(0);
+        return(&devices[ud - 1]);
+    }
+
+    //==========
+    // inUse()
+    //==========
+    bool inUse(const Device& dev) {
+        return(pendingOn[dev.Board] != 0);
+    }
+
+    //==========
+    // write()
+    //==========
+    int write(int ud, PVOID buf, long cnt, bool async) {
+        Device* dev = device(ud);
+        if ( !dev )
+            return(status(ERR, EDVR));
+        if ( inUse(*dev) )
+            return(status(ERR, EOIP));
+        std::string command(static_cast<const char*>(buf), cnt);
+        if ( command.find('?') != std::string::npos )
+            dev->Reply = REPLY;
+        ibcntl = cnt;
+        ibcnt = static_cast<int>(cnt);
+        double end = transfer(*dev, cnt, ACCEPTTIME);
+        if ( !async ) {
+            now = end;
+            return(status(CMPL));
+        }
+        dev->DoneAt = end;
+        pendingOn[dev->Board] = ud;
+        return(status(0));
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//=====================================================================================//
+// NI-488.2 calls made by GPIB.cpp
+//=====================================================================================//
+extern "C" {
+
+int ibsta = 0;
+int iberr = 0;
+int ibcnt = 0;
+long ibcntl = 0;
+
+int __stdcall ibclr(int ud) {
+    Device* dev = device(ud);
+    if ( !dev )
+        return(status(ERR, EDVR));
+    if ( inUse(*dev) )
+        return(status(ERR, EOIP));
+    now = transfer(*dev, 0, 0);
+    dev->Reply = "";
+    return(status(CMPL));
+}
+
+int __stdcall ibdev(int boardID, int pad, int sad, int tmo, int eot, int eos) {
+    if ( (boardID < 0) || (boardID >= MAXBOARDS) )
+        return(-1);
+    devices.push_back(Device(boardID));
+    status(CMPL);
+    return(static_cast<int>(devices.size()));
+}
+
+int __stdcall ibonl(int ud, int v) {
+    return(device(ud) ? status(CMPL) : status(ERR, EDVR));
+}
+
+int __stdcall ibrd(int ud, PVOID buf, long cnt) {
+    Device* dev = device(ud);
+    if ( !dev )
+        return(status(ERR, EDVR));
+    if ( inUse(*dev) )
+        return(status(ERR, EOIP));
+    if ( dev->Reply.empty() ) { // nothing to say --> the read times out
+        now = transfer(*dev, 0, 10.0);
+        ibcntl = 0;
+        return(status(ERR | TIMO, EABO));
+    }
+    long size = std::min(cnt, static_cast<long>(dev->Reply.size()));
+    std::copy(dev->Reply.begin(), dev->Reply.begin() + size, static_cast<char*>(buf));
+    dev->Reply.erase(0, size);
+    ibcntl = size;
+    ibcnt = static_cast<int>(size);
+    now = transfer(*dev, size, ANSWERTIME);
+    return(status(CMPL | (dev->Reply.empty() ? END : 0)));
+}
+
+int __stdcall ibstop(int ud) {
+    Device* dev = device(ud);
+    if ( !dev )
+        return(status(ERR, EDVR));
+    if ( pendingOn[dev->Board] == ud )
+        pendingOn[dev->Board] = 0;
+    return(status(ERR | CMPL, EABO));
+}
+
+int __stdcall ibwait(int ud, int mask) {
+    Device* dev = device(ud);
+    if ( !dev )
+        return(status(ERR, EDVR));
+    if ( pendingOn[dev->Board] == ud ) {
+        now = std::max(now, dev->DoneAt);
+        pendingOn[dev->Board] = 0;
+    }
+    return(status(CMPL));
+}
+
+int __stdcall ibwrt(int ud, PVOID buf, long cnt) {
+    return(write(ud, buf, cnt, false));
+}
+
+int __stdcall ibwrta(int ud, PVOID buf, long cnt) {
+    return(write(ud, buf, cnt, true));
+}
+
+} // extern "C"
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+namespace {
+    // An instrument on the station's GPIB bus
+    class Bench : public SPTSInstrument::Instrument<SPTSInstrument::GPIB> {
+    public:
+        Bench(long board, long primary) : key_(primary + (KEYBASE * KEYBASE * board))
+        { /* */ }
+        void Command(const std::string& command) {
+            commandInstr(key_, command);
+        }
+        std::string Query(const std::string& query) {
+            return(queryInstr(key_, query));
+        }
+    private:
+        long key_;
+    };
+
+    //===========
+    // runOnce()
+    //===========
+    double runOnce(long instruments, long boards, long rounds) {
+        // Instruments dealt out over the boards, as a station would cable them
+        std::vector<Bench> bench;
+        for ( long idx = 0; idx < instruments; ++idx )
+            bench.push_back(Bench(idx % boards, (idx / boards) + 1));
+
+        reset();
+        for ( long round = 0; round < rounds; ++round ) {
+            for ( long idx = 0; idx < instruments; ++idx )
+                bench[idx].Command(SETTINGS);
+            for ( long idx = 0; idx < instruments; ++idx )
+                bench[idx].Query(MEASURE);
+        } // for
+        for ( long board = 0; board < boards; ++board )
+            now = std::max(now, boardFree[board]); // last writes complete
+        return(now);
+    }
+} // unnamed namespace
+
+//========
+// main()
+//========
+int main(int argc, char* argv[]) {
+    long instruments = DEFAULTINSTRUMENTS, rounds = DEFAULTROUNDS;
+    if ( (argc > 3) ||
+         ((argc > 1) && ((instruments = std::atol(argv[1])) <= 0)) ||
+         ((argc > 2) && ((rounds = std::atol(argv[2])) <= 0)) ) {
+        std::cerr << "Usage: GPIBSimulator [instruments [rounds]]" << std::endl;
+        return(1);
+    }
+
+    try {
+        std::cout << "GPIBSimulator: " << instruments << " instruments, " << rounds
+                  << " rounds" << std::endl;
+        double single = 0;
+        for ( long boards = 1; boards <= MAXBOARDS; ++boards ) {
+            double seconds = runOnce(instruments, boards, rounds);
+            if ( 1 == boards )
+                single = seconds;
+            std::cout << "  " << boards << " board(s): " << seconds << " s --> "
+                      << (single / seconds) << "x" << std::endl;
+        } // for
+    } catch(std::exception& e) {
+        std::cerr << "GPIBSimulator: " << e.what() << std::endl;
+        return(1);
+    } catch(...) {
+        std::cerr << "GPIBSimulator: bus error" << std::endl;
+        return(1);
+    }
+    return(0);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
@@ -0,0 +1,205 @@
+// Files included for Winsock
+#include <winsock2.h>
+
+// Files included
+#include "StandardFiles.h"
+
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*
+   Loopback SCPI instrument for SocketSCPI:  listens on 127.0.0.1 (port 5025 unless
+    given) and answers newline terminated SCPI as a quiet, error free instrument
+    would --> point an instrument's "LAN Address" at localhost to run or time the
+    station's LAN path with no hardware.
+   Commands are accepted and counted.  Queries (anything with a '?') are answered:
+        *IDN?              loopback identity
+        *OPC?              1
+        SYST:ERR?          +0,"No error"
+        *ESR?, *STB?       0
+        anything else      +0.00000000E+00
+    with ';' separated queries answered together on one line.  A query ending in
+    "BLOCK?" is answered with a 1000 byte IEEE 488.2 definite length block.
+   One connection is served at a time; when it closes, its command count and mean
+    time per command are printed.
+   Build apart from the station software:  SCPILoopback.cpp and ws2_32.lib.
+   Usage:  SCPILoopback [port]
+*/
+
+namespace {
+    // SCPI-RAW port (LXI)
+    const int DEFAULTPORT = 5025;
+
+    // Bytes requested per recv() call
+    const int CHUNKSIZE = 1024;
+
+    // Size of the block answered to "...BLOCK?"
+    const long BLOCKSIZE = 1000;
+
+    struct Counts {
+        Counts() : Commands(0), Queries(0) { /* */ }
+        long Commands;
+        long Queries;
+    };
+
+    //==========
+    // answer()
+    //==========
+    std::string answer(const std::string& query) {
+        std::string q = query;
+        std::transform(q.begin(), q.end(), q.begin(), ::toupper);
+        if ( q == "*IDN?" )
+            return("CRANE INTERPOINT,SCPILOOPBACK,0,1.0");
+        if ( q == "*OPC?" )
+            return("1");
+        if ( (q == "SYST:ERR?") || (q == "SYSTEM:ERROR?") )
+            return("+0,\"No error\"");
+        if ( (q == "*ESR?") || (q == "*STB?") )
+            return("0");
+        std::string block = "BLOCK?";
+        if ( (q.size() >= block.size()) &&
+             (q.compare(q.size() - block.size(), block.size(), block) == 0) ) {
+            std::stringstream s;
+            s << BLOCKSIZE;
+            std::string digits = s.str();
+            s.str("");
+            s << "#" << digits.size() << digits << std::string(BLOCKSIZE, '\x55');
+            return(s.str());
+        }
+        return("+0.00000000E+00");
+    }
+
+    //===========
+    // respond()
+    //===========
+    std::string respond(const std::string& line, Counts& counts) {
+        // Empty if (line) holds no query; otherwise the newline terminated answer
+        std::string toRtn;
+        std::string::size_type start = 0;
+        while ( start <= line.size() ) {
+            std::string::size_type end = line.find(';', start);
+            if ( end == std::string::npos )
+                end = line.size();
+            std::string part = line.substr(start, end - start);
+            part.erase(0, part.find_first_not_of(" \t"));
+            part.erase(part.find_last_not_of(" \t\r") + 1);
+            if ( !part.empty() ) {
+                ++counts.Commands;
+                if ( part.find('?') != std::string::npos ) {
+                    ++counts.Queries;
+                    toRtn += (toRtn.empty() ? "" : ";") + answer(part);
+                }
+            }
+            start = end + 1;
+        } // while
+        return(toRtn.empty() ? toRtn : toRtn + "\n");
+    }
+
+    //=========
+    // serve()
+    //=========
+    bool serve(SOCKET client, Counts& counts) {
+        // Answers until the client closes --> false on a socket error
+        std::string pending;
+        std::vector<char> buffer(CHUNKSIZE);
+        while ( true ) {
+            int got = recv(client, &buffer[0], CHUNKSIZE, 0);
+            if ( 0 == got )
+                return(true);
+            if ( got < 0 )
+                return(false);
+            pending.append(&buffer[0], got);
+            std::string::size_type nl;
+            while ( (nl = pending.find('\n')) != std::string::npos ) {
+                std::string reply = respond(pending.substr(0, nl), counts);
+                pending.erase(0, nl + 1);
+                std::size_t sent = 0;
+                while ( sent < reply.size() ) {
+                    int put = send(client, reply.data() + sent,
+                                   static_cast<int>(reply.size() - sent), 0);
+                    if ( put <= 0 )
+                        return(false);
+                    sent += static_cast<std::size_t>(put);
+                } // while
+            } // while
+        } // while
+    }
+} // unnamed namespace
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+//========
+// main()
+//========
+int main(int argc, char* argv[]) {
+    int port = DEFAULTPORT;
+    if ( argc > 2 || ((argc == 2) && ((port = std::atoi(argv[1])) <= 0)) ) {
+        std::cerr << "Usage: SCPILoopback [port]" << std::endl;
+        return(1);
+    }
+
+    WSADATA wsaData;
+    if ( WSAStartup(MAKEWORD(2, 2), &wsaData) != 0 ) {
+        std::cerr << "Unable to start Winsock" << std::endl;
+        return(1);
+    }
+
+    SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in where = sockaddr_in();
+    where.sin_family = AF_INET;
+    where.sin_port = htons(static_cast<u_short>(port));
+    where.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if ( (listener == INVALID_SOCKET) ||
+         (bind(listener, reinterpret_cast<sockaddr*>(&where), sizeof(where)) != 0) ||
+         (listen(listener, 1) != 0) ) {
+        std::cerr << "Unable to listen on 127.0.0.1:" << port << " Error Code: "
+                  << WSAGetLastError() << std::endl;
+        WSACleanup();
+        return(1);
+    }
+    std::cout << "SCPILoopback listening on 127.0.0.1:" << port << std::endl;
+
+    while ( true ) {
+        SOCKET client = accept(listener, 0, 0);
+        if ( client == INVALID_SOCKET )
+            break;
+        BOOL noDelay = TRUE; // answer each query as soon as it is written
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY,
+                   reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+        Counts counts;
+        std::clock_t start = std::clock(); // wall time under the Microsoft runtime
+        bool ok = serve(client, counts);
+        double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+        closesocket(client);
+
+        std::cout << (ok ? "Closed: " : "Dropped: ") << counts.Commands
+                  << " commands (" << counts.Queries << " queries) in "
+                  << seconds << " s";
+        if ( counts.Commands > 0 )
+            std::cout << " --> " << (seconds * 1e6 / counts.Commands)
+                      << " us per command";
+        std::cout << std::endl;
+    } // while
+
+    closesocket(listener);
+    WSACleanup();
+    return(0);
+}
+
+/***************************************************************************************/
+////////////////////////////////////CRANE INTERPOINT/////////////////////////////////////
+//////////////////////////////////SPACE-POWER DIVISION///////////////////////////////////
+/***************************************************************************************/
+
+/*---------------------------------------------------------//
+       "Hardcoded types are to generic code what magic
+        constants are to regular code"
+                                 - Andrei Alexandrescu
+//---------------------------------------------------------*/